@@ -23,3 +23,18 @@ MACRO(SUBDIRLIST result curdir)
   ENDFOREACH()
   SET(${result} ${dirlist})
 ENDMACRO()
+
+
+# Adds the unit test in the current folder, named after the folder and linked with the given targets
+FUNCTION(ADD_SPHINXSYS_UNIT_TEST)
+  STRING(REGEX REPLACE ".*/(.*)" "\\1" TEST_NAME ${CMAKE_CURRENT_SOURCE_DIR})
+  SET(TEST_OUTPUT_PATH "${CMAKE_CURRENT_BINARY_DIR}/bin/")
+  aux_source_directory(${CMAKE_CURRENT_SOURCE_DIR} TEST_SRCS)
+  ADD_EXECUTABLE(${TEST_NAME} ${TEST_SRCS})
+  target_link_libraries(${TEST_NAME} ${ARGN} GTest::gtest GTest::gtest_main)
+  set_target_properties(${TEST_NAME} PROPERTIES RUNTIME_OUTPUT_DIRECTORY "${TEST_OUTPUT_PATH}"
+                        VS_DEBUGGER_WORKING_DIRECTORY "${TEST_OUTPUT_PATH}")
+  add_test(NAME ${TEST_NAME}
+           COMMAND ${TEST_NAME}
+           WORKING_DIRECTORY ${TEST_OUTPUT_PATH})
+ENDFUNCTION()
@@ -561,6 +561,7 @@ void InnerRelationInFVM::searchNeighborsByParticles(size_t total_particles, Base
 //=================================================================================================//
 void InnerRelationInFVM::updateConfiguration()
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), base_particles_.total_real_particles_, 0);
     resetNeighborhoodCurrentSize();
     searchNeighborsByParticles(base_particles_.total_real_particles_,
                                base_particles_, inner_configuration_,
@@ -585,30 +586,68 @@ GhostCreationFromMesh::GhostCreationFromMesh(RealBody &real_body, ANSYSMesh &ans
 //=================================================================================================//
 void GhostCreationFromMesh::addGhostParticleAndSetInConfiguration()
 {
-    ghost_bound_.second = ghost_bound_.first;
+    size_t total_real_particles = particles_->total_real_particles_;
+    // the ghost particles of a real particle start from the offset given by the prefix sum of
+    // the numbers of boundary faces so that the ghosts are created in parallel and in order
+    StdLargeVec<size_t> ghost_offsets(total_real_particles + 1, 0);
+    parallel_for(
+        IndexRange(0, total_real_particles),
+        [&](const IndexRange &r)
+        {
+            for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+            {
+                for (size_t neighbor_index = 0; neighbor_index != mesh_topology_[index_i].size(); ++neighbor_index)
+                {
+                    if (mesh_topology_[index_i][neighbor_index][1] != 2)
+                        ghost_offsets[index_i + 1]++;
+                }
+            }
+        },
+        ap);
+    for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
+        ghost_offsets[index_i + 1] += ghost_offsets[index_i];
+
+    ghost_bound_.second = ghost_bound_.first + ghost_offsets[total_real_particles];
+    ghost_boundary_.checkWithinGhostSize(ghost_bound_);
 
-    for (size_t index_i = 0; index_i != particles_->total_real_particles_; ++index_i)
+    parallel_for(
+        IndexRange(0, total_real_particles),
+        [&](const IndexRange &r)
+        {
+            for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+            {
+                size_t ghost_particle_index = ghost_bound_.first + ghost_offsets[index_i];
+                for (size_t neighbor_index = 0; neighbor_index != mesh_topology_[index_i].size(); ++neighbor_index)
+                {
+                    if (mesh_topology_[index_i][neighbor_index][1] != 2)
+                    {
+                        particles_->updateGhostParticle(ghost_particle_index, index_i);
+                        size_t node1_index = mesh_topology_[index_i][neighbor_index][2];
+                        size_t node2_index = mesh_topology_[index_i][neighbor_index][3];
+                        Vecd ghost_particle_position = 0.5 * (node_coordinates_[node1_index] + node_coordinates_[node2_index]);
+
+                        mesh_topology_[index_i][neighbor_index][0] = ghost_particle_index + 1;
+                        pos_[ghost_particle_index] = ghost_particle_position;
+                        ghost_particle_index++;
+                    }
+                }
+            }
+        },
+        ap);
+
+    // the elements and the boundary lists of the ghost particles are appended in ghost order
+    for (size_t index_i = 0; index_i != total_real_particles; ++index_i)
     {
+        size_t ghost_particle_index = ghost_bound_.first + ghost_offsets[index_i];
         for (size_t neighbor_index = 0; neighbor_index != mesh_topology_[index_i].size(); ++neighbor_index)
         {
             size_t boundary_type = mesh_topology_[index_i][neighbor_index][1];
             if (mesh_topology_[index_i][neighbor_index][1] != 2)
             {
-                mutex_create_ghost_particle_.lock();
-                size_t ghost_particle_index = ghost_bound_.second;
-                ghost_bound_.second++;
-                ghost_boundary_.checkWithinGhostSize(ghost_bound_);
-
-                particles_->updateGhostParticle(ghost_particle_index, index_i);
                 size_t node1_index = mesh_topology_[index_i][neighbor_index][2];
                 size_t node2_index = mesh_topology_[index_i][neighbor_index][3];
                 Vecd node1_position = node_coordinates_[node1_index];
                 Vecd node2_position = node_coordinates_[node2_index];
-                Vecd ghost_particle_position = 0.5 * (node1_position + node2_position);
-
-                mesh_topology_[index_i][neighbor_index][0] = ghost_particle_index + 1;
-                pos_[ghost_particle_index] = ghost_particle_position;
-                mutex_create_ghost_particle_.unlock();
 
                 std::vector<std::vector<size_t>> new_element;
                 // Add (corresponding_index_i,boundary_type,node1_index,node2_index) to the new element
@@ -642,6 +681,7 @@ void GhostCreationFromMesh::addGhostParticleAndSetInConfiguration()
                     normal_vector = -normal_vector;
                 };
                 each_boundary_type_with_all_ghosts_eij_[boundary_type].push_back(normal_vector);
+                ghost_particle_index++;
             }
         }
     }
@@ -31,6 +31,12 @@ BoundingBox GeometricShapeBox::findBounds()
     return BoundingBox(-halfsize_, halfsize_);
 }
 //=================================================================================================//
+bool GeometricShapeBox::writeGeometryFingerprint(std::ostream &output)
+{
+    writeBinaryValue(output, halfsize_);
+    return true;
+}
+//=================================================================================================//
 GeometricShapeBall::GeometricShapeBall(const Vec2d &center, Real radius,
                                        const std::string &shape_name)
     : Shape(shape_name), center_(center), radius_(radius) {}
@@ -55,4 +61,11 @@ BoundingBox GeometricShapeBall::findBounds()
     return BoundingBox(center_ - shift, center_ + shift);
 }
 //=================================================================================================//
+bool GeometricShapeBall::writeGeometryFingerprint(std::ostream &output)
+{
+    writeBinaryValue(output, center_);
+    writeBinaryValue(output, radius_);
+    return true;
+}
+//=================================================================================================//
 } // namespace SPH
\ No newline at end of file
@@ -284,4 +284,21 @@ BoundingBox MultiPolygonShape::findBounds()
     return multi_polygon_.findBounds();
 }
 //=================================================================================================//
+bool MultiPolygonShape::writeGeometryFingerprint(std::ostream &output)
+{
+    for (const boost_poly &polygon : multi_polygon_.getBoostMultiPoly())
+    {
+        writeBinaryValue(output, uint64_t(polygon.outer().size()));
+        for (const auto &point : polygon.outer())
+            writeBinaryValue(output, Vec2d(point.x(), point.y()));
+        for (const auto &inner_ring : polygon.inners())
+        {
+            writeBinaryValue(output, uint64_t(inner_ring.size()));
+            for (const auto &point : inner_ring)
+                writeBinaryValue(output, Vec2d(point.x(), point.y()));
+        }
+    }
+    return true;
+}
+//=================================================================================================//
 } // namespace SPH
\ No newline at end of file
@@ -17,6 +17,49 @@
 namespace SPH
 {
 //=================================================================================================//
+inline ListDataVector &CellLinkedList::CellDataList(const Array2i &cell_index)
+{
+    return cell_data_lists_ != nullptr ? cell_data_lists_[cell_index[0]][cell_index[1]]
+                                       : CellDataListWithoutMatrix(cell_index);
+}
+//=================================================================================================//
+inline ListDataRange CellLinkedList::ContiguousListData(const Array2i &cell_index)
+{
+    if (!contiguous_cell_lists_built_)
+        return ListDataRange{nullptr, nullptr};
+
+    size_t cell = cell_index[0] * all_cells_[1] + cell_index[1];
+    const ListData *list_data = contiguous_list_data_.data();
+    return ListDataRange{list_data + cell_offsets_[cell], list_data + cell_offsets_[cell + 1]};
+}
+//=================================================================================================//
+inline size_t CellLinkedList::prefilterContiguousListData(const Vecd &position, size_t first, size_t last,
+                                                          Real cut_off_radius_sqr, size_t *accepted)
+{
+    size_t batch_size = last - first;
+    Real distance_sqr[max_prefilter_batch_size_];
+    for (size_t k = 0; k != batch_size; ++k)
+        distance_sqr[k] = 0.0;
+    for (int axis = 0; axis != Dimensions; ++axis)
+    {
+        const Real *coordinates = contiguous_coordinates_[axis].data() + first;
+        Real coordinate_i = position[axis];
+        for (size_t k = 0; k != batch_size; ++k)
+        {
+            Real difference = coordinate_i - coordinates[k];
+            distance_sqr[k] += difference * difference;
+        }
+    }
+
+    size_t number_of_accepted = 0;
+    for (size_t k = 0; k != batch_size; ++k)
+    {
+        accepted[number_of_accepted] = first + k;
+        number_of_accepted += distance_sqr[k] < cut_off_radius_sqr ? 1 : 0;
+    }
+    return number_of_accepted;
+}
+//=================================================================================================//
 template <class DynamicsRange, typename GetSearchDepth, typename GetNeighborRelation>
 void CellLinkedList::searchNeighborsByParticles(
     DynamicsRange &dynamics_range, ParticleConfiguration &particle_configuration,
@@ -35,7 +78,11 @@ void CellLinkedList::searchNeighborsByParticles(
                          all_cells_.min(target_cell_index + (search_depth + 1) * Array2i::Ones()),
                          [&](int l, int m)
                          {
-                             ListDataVector &target_particles = cell_data_lists_[l][m];
+                             for (const ListData &list_data : ContiguousListData(Array2i(l, m)))
+                             {
+                                 get_neighbor_relation(neighborhood, pos[index_i], index_i, list_data);
+                             }
+                             ListDataVector &target_particles = CellDataList(Array2i(l, m));
                              for (const ListData &list_data : target_particles)
                              {
                                  get_neighbor_relation(neighborhood, pos[index_i], index_i, list_data);
@@ -44,4 +91,68 @@ void CellLinkedList::searchNeighborsByParticles(
                  });
 }
 //=================================================================================================//
+template <class DynamicsRange, typename GetSearchDepth, typename GetNeighborRelation>
+void CellLinkedList::searchNeighborsByParticles(
+    DynamicsRange &dynamics_range, ParticleConfiguration &particle_configuration,
+    GetSearchDepth &get_search_depth, GetNeighborRelation &get_neighbor_relation, Real cut_off_radius_sqr)
+{
+    if (!contiguous_cell_lists_built_ || prefilter_batch_size_ == 0)
+    {
+        searchNeighborsByParticles(dynamics_range, particle_configuration, get_search_depth, get_neighbor_relation);
+        return;
+    }
+
+    StdLargeVec<Vecd> &pos = dynamics_range.getBaseParticles().pos_;
+    particle_for(execution::ParallelPolicy(), dynamics_range.LoopRange(),
+                 [&](size_t index_i)
+                 {
+                     int search_depth = get_search_depth(index_i);
+                     Array2i target_cell_index = CellIndexFromPosition(pos[index_i]);
+
+                     Neighborhood &neighborhood = particle_configuration[index_i];
+                     size_t accepted[max_prefilter_batch_size_];
+                     mesh_for_each(
+                         Array2i::Zero().max(target_cell_index - search_depth * Array2i::Ones()),
+                         all_cells_.min(target_cell_index + (search_depth + 1) * Array2i::Ones()),
+                         [&](int l, int m)
+                         {
+                             size_t cell = l * all_cells_[1] + m;
+                             size_t cell_end = cell_offsets_[cell + 1];
+                             for (size_t first = cell_offsets_[cell]; first < cell_end; first += prefilter_batch_size_)
+                             {
+                                 size_t last = SMIN(first + prefilter_batch_size_, cell_end);
+                                 size_t number_of_accepted =
+                                     prefilterContiguousListData(pos[index_i], first, last, cut_off_radius_sqr, accepted);
+                                 for (size_t k = 0; k != number_of_accepted; ++k)
+                                 {
+                                     get_neighbor_relation(neighborhood, pos[index_i], index_i,
+                                                           contiguous_list_data_[accepted[k]]);
+                                 }
+                             }
+                             ListDataVector &target_particles = CellDataList(Array2i(l, m));
+                             for (const ListData &list_data : target_particles)
+                             {
+                                 get_neighbor_relation(neighborhood, pos[index_i], index_i, list_data);
+                             }
+                         });
+                 });
+}
+//=================================================================================================//
+template <typename FunctionOnListData>
+void CellLinkedList::searchListDataNearPosition(const Vecd &position, int search_depth,
+                                                const FunctionOnListData &function)
+{
+    Array2i target_cell_index = CellIndexFromPosition(position);
+    mesh_for_each(
+        Array2i::Zero().max(target_cell_index - search_depth * Array2i::Ones()),
+        all_cells_.min(target_cell_index + (search_depth + 1) * Array2i::Ones()),
+        [&](int l, int m)
+        {
+            for (const ListData &list_data : ContiguousListData(Array2i(l, m)))
+                function(list_data);
+            for (const ListData &list_data : CellDataList(Array2i(l, m)))
+                function(list_data);
+        });
+}
+//=================================================================================================//
 } // namespace SPH
@@ -1,4 +1,4 @@
-#include "cell_linked_list.h"
+#include "cell_linked_list.hpp"
 
 #include "base_particles.hpp"
 #include "mesh_iterators.hpp"
@@ -21,8 +21,21 @@ void CellLinkedList ::allocateMeshDataMatrix()
 //=================================================================================================//
 void CellLinkedList ::deleteMeshDataMatrix()
 {
-    Delete2dArray(cell_index_lists_, all_cells_);
-    Delete2dArray(cell_data_lists_, all_cells_);
+    if (cell_index_lists_ != nullptr)
+    {
+        Delete2dArray(cell_index_lists_, all_cells_);
+        Delete2dArray(cell_data_lists_, all_cells_);
+    }
+}
+//=================================================================================================//
+ConcurrentIndexVector &CellLinkedList::ParticleIndexesInCell(const Array2i &cell_index)
+{
+    return cell_index_lists_[cell_index[0]][cell_index[1]];
+}
+//=================================================================================================//
+ListDataVector &CellLinkedList::ListDataInCell(const Array2i &cell_index)
+{
+    return cell_data_lists_[cell_index[0]][cell_index[1]];
 }
 //=================================================================================================//
 void CellLinkedList::clearCellLists()
@@ -78,6 +91,7 @@ void CellLinkedList ::insertParticleIndex(size_t particle_index, const Vecd &par
 void CellLinkedList ::InsertListDataEntry(
     size_t particle_index, const Vecd &particle_position, Real volumetric)
 {
+    has_entries_in_cell_lists_ = true;
     Array2i cellpos = CellIndexFromPosition(particle_position);
     cell_data_lists_[cellpos[0]][cellpos[1]].emplace_back(
         std::make_tuple(particle_index, particle_position, volumetric));
@@ -87,6 +101,15 @@ ListData CellLinkedList::findNearestListDataEntry(const Vecd &position)
 {
     Real min_distance_sqr = MaxReal;
     ListData nearest_entry(MaxSize_t, MaxReal * Vecd::Ones(), MaxReal);
+    auto check_entry = [&](const ListData &list_data)
+    {
+        Real distance_sqr = (position - std::get<1>(list_data)).squaredNorm();
+        if (distance_sqr < min_distance_sqr)
+        {
+            min_distance_sqr = distance_sqr;
+            nearest_entry = list_data;
+        }
+    };
 
     Array2i cell = CellIndexFromPosition(position);
     mesh_for_each(
@@ -94,16 +117,10 @@ ListData CellLinkedList::findNearestListDataEntry(const Vecd &position)
         all_cells_.min(cell + 2 * Array2i::Ones()),
         [&](int l, int m)
         {
-            ListDataVector &target_particles = cell_data_lists_[l][m];
-            for (const ListData &list_data : target_particles)
-            {
-                Real distance_sqr = (position - std::get<1>(list_data)).squaredNorm();
-                if (distance_sqr < min_distance_sqr)
-                {
-                    min_distance_sqr = distance_sqr;
-                    nearest_entry = list_data;
-                }
-            }
+            for (const ListData &list_data : ContiguousListData(Array2i(l, m)))
+                check_entry(list_data);
+            for (const ListData &list_data : CellDataList(Array2i(l, m)))
+                check_entry(list_data);
         });
     return nearest_entry;
 }
@@ -111,6 +128,7 @@ ListData CellLinkedList::findNearestListDataEntry(const Vecd &position)
 void CellLinkedList::
     tagBodyPartByCell(ConcurrentCellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included)
 {
+    has_tagged_cells_ = true;
     mesh_parallel_for(
         MeshRange(Array2i::Zero(), all_cells_),
         [&](int i, int j)
@@ -127,13 +145,14 @@ void CellLinkedList::
                     }
                 });
             if (is_included == true)
-                cell_lists.push_back(&cell_index_lists_[i][j]);
+                cell_lists.push_back(&ParticleIndexesInCell(Array2i(i, j)));
         });
 }
 //=================================================================================================//
 void CellLinkedList::
     tagBoundingCells(StdVec<CellLists> &cell_data_lists, const BoundingBox &bounding_bounds, int axis)
 {
+    has_tagged_cells_ = true;
     int second_axis = NextAxis(axis);
     Array2i body_lower_bound_cell_ = CellIndexFromPosition(bounding_bounds.first_);
     Array2i body_upper_bound_cell_ = CellIndexFromPosition(bounding_bounds.second_);
@@ -147,8 +166,8 @@ void CellLinkedList::
             Array2i cell = Array2i::Zero();
             cell[axis] = i;
             cell[second_axis] = j;
-            cell_data_lists[0].first.push_back(&cell_index_lists_[cell[0]][cell[1]]);
-            cell_data_lists[0].second.push_back(&cell_data_lists_[cell[0]][cell[1]]);
+            cell_data_lists[0].first.push_back(&ParticleIndexesInCell(cell));
+            cell_data_lists[0].second.push_back(&ListDataInCell(cell));
         }
 
     // upper bound cells
@@ -160,8 +179,8 @@ void CellLinkedList::
             Array2i cell = Array2i::Zero();
             cell[axis] = i;
             cell[second_axis] = j;
-            cell_data_lists[1].first.push_back(&cell_index_lists_[cell[0]][cell[1]]);
-            cell_data_lists[1].second.push_back(&cell_data_lists_[cell[0]][cell[1]]);
+            cell_data_lists[1].first.push_back(&ParticleIndexesInCell(cell));
+            cell_data_lists[1].second.push_back(&ListDataInCell(cell));
         }
 }
 //=============================================================================================//
@@ -204,7 +223,7 @@ void CellLinkedList::writeMeshFieldToPlt(std::ofstream &output_file)
     {
         for (int i = 0; i != number_of_operation[0]; ++i)
         {
-            output_file << cell_index_lists_[i][j].size() << " ";
+            output_file << cell_index_lists_[i][j].size() + ContiguousListData(Array2i(i, j)).size() << " ";
         }
         output_file << " \n";
     }
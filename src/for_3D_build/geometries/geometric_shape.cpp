@@ -57,6 +57,12 @@ BoundingBox GeometricShapeBox::findBounds()
     return BoundingBox(-halfsize_, halfsize_);
 }
 //=================================================================================================//
+bool GeometricShapeBox::writeGeometryFingerprint(std::ostream &output)
+{
+    writeBinaryValue(output, halfsize_);
+    return true;
+}
+//=================================================================================================//
 GeometricShapeBall::
     GeometricShapeBall(const Vecd &center, const Real &radius, const std::string &shape_name)
     : GeometricShape(shape_name), center_(center), sphere_(radius)
@@ -85,4 +91,11 @@ BoundingBox GeometricShapeBall::findBounds()
     return BoundingBox(center_ - shift, center_ + shift);
 }
 //=================================================================================================//
+bool GeometricShapeBall::writeGeometryFingerprint(std::ostream &output)
+{
+    writeBinaryValue(output, center_);
+    writeBinaryValue(output, Real(sphere_.getRadius()));
+    return true;
+}
+//=================================================================================================//
 } // namespace SPH
\ No newline at end of file
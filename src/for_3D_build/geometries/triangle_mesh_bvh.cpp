@@ -0,0 +1,446 @@
+#include "triangle_mesh_bvh.h"
+
+#include <tbb/parallel_invoke.h>
+
+namespace SPH
+{
+//=================================================================================================//
+TriangleMeshBVH::TriangleMeshBVH(const StdVec<Vec3d> &vertices, const StdVec<Array3i> &faces)
+    : vertices_(vertices), faces_(faces), number_of_nodes_(1)
+{
+    if (faces_.empty())
+    {
+        std::cout << "\n Error: the triangle mesh for the BVH has no faces!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    computePseudoNormals();
+
+    size_t number_of_faces = faces_.size();
+    StdVec<Vec3d> centroids(number_of_faces);
+    StdVec<std::pair<Vec3d, Vec3d>> face_bounds(number_of_faces);
+    parallel_for(
+        IndexRange(0, number_of_faces),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                const Vec3d &a = vertices_[faces_[i][0]];
+                const Vec3d &b = vertices_[faces_[i][1]];
+                const Vec3d &c = vertices_[faces_[i][2]];
+                centroids[i] = (a + b + c) / 3.0;
+                face_bounds[i] = std::make_pair(a.cwiseMin(b).cwiseMin(c), a.cwiseMax(b).cwiseMax(c));
+            }
+        },
+        ap);
+
+    face_ordering_.resize(number_of_faces);
+    std::iota(face_ordering_.begin(), face_ordering_.end(), 0);
+    // a binary tree with non-empty leaves has less than twice of the faces nodes
+    nodes_.resize(2 * number_of_faces);
+    buildNode(0, 0, number_of_faces, 0, centroids, face_bounds);
+    nodes_.resize(number_of_nodes_);
+}
+//=================================================================================================//
+void TriangleMeshBVH::computePseudoNormals()
+{
+    size_t number_of_faces = faces_.size();
+    face_normals_.resize(number_of_faces);
+    vertex_normals_.assign(vertices_.size(), Vec3d::Zero());
+    StdVec<std::pair<uint64_t, size_t>> half_edges(3 * number_of_faces);
+    for (size_t i = 0; i != number_of_faces; ++i)
+    {
+        const Array3i &face = faces_[i];
+        Vec3d normal = (vertices_[face[1]] - vertices_[face[0]]).cross(vertices_[face[2]] - vertices_[face[0]]);
+        face_normals_[i] = normal / (normal.norm() + TinyReal);
+        for (int k = 0; k != 3; ++k)
+        {
+            int vertex = face[k];
+            int next_vertex = face[(k + 1) % 3];
+            int previous_vertex = face[(k + 2) % 3];
+            Vec3d edge_next = vertices_[next_vertex] - vertices_[vertex];
+            Vec3d edge_previous = vertices_[previous_vertex] - vertices_[vertex];
+            Real cosine = edge_next.dot(edge_previous) / (edge_next.norm() * edge_previous.norm() + TinyReal);
+            vertex_normals_[vertex] += acos(SMAX(Real(-1), SMIN(Real(1), cosine))) * face_normals_[i];
+
+            uint64_t lower = (uint64_t)SMIN(vertex, next_vertex);
+            uint64_t upper = (uint64_t)SMAX(vertex, next_vertex);
+            half_edges[3 * i + k] = std::make_pair((lower << 32) | upper, 3 * i + k);
+        }
+    }
+
+    // half edges sharing the same vertices are grouped as one edge
+    std::sort(half_edges.begin(), half_edges.end());
+    face_edges_.resize(number_of_faces);
+    for (size_t n = 0; n != half_edges.size(); ++n)
+    {
+        if (n == 0 || half_edges[n].first != half_edges[n - 1].first)
+            edge_normals_.push_back(Vec3d::Zero());
+        size_t face = half_edges[n].second / 3;
+        edge_normals_.back() += face_normals_[face];
+        face_edges_[face][half_edges[n].second % 3] = edge_normals_.size() - 1;
+    }
+}
+//=================================================================================================//
+void TriangleMeshBVH::buildNode(size_t node_index, size_t begin, size_t end, size_t depth,
+                                const StdVec<Vec3d> &centroids, const StdVec<std::pair<Vec3d, Vec3d>> &face_bounds)
+{
+    Node &node = nodes_[node_index];
+    node.lower_ = MaxReal * Vec3d::Ones();
+    node.upper_ = -MaxReal * Vec3d::Ones();
+    Vec3d centroid_lower = MaxReal * Vec3d::Ones();
+    Vec3d centroid_upper = -MaxReal * Vec3d::Ones();
+    for (size_t n = begin; n != end; ++n)
+    {
+        size_t face = face_ordering_[n];
+        node.lower_ = node.lower_.cwiseMin(face_bounds[face].first);
+        node.upper_ = node.upper_.cwiseMax(face_bounds[face].second);
+        centroid_lower = centroid_lower.cwiseMin(centroids[face]);
+        centroid_upper = centroid_upper.cwiseMax(centroids[face]);
+    }
+
+    size_t count = end - begin;
+    node.first_ = begin;
+    node.count_ = count;
+    if (count <= max_leaf_size_)
+        return;
+
+    auto half_area = [](const Vec3d &lower, const Vec3d &upper)
+    {
+        Vec3d extent = (upper - lower).cwiseMax(Vec3d::Zero());
+        return extent[0] * extent[1] + extent[1] * extent[2] + extent[2] * extent[0];
+    };
+    auto bin_index = [&](const Vec3d &centroid, int axis)
+    {
+        Real scale = (Real)number_of_bins_ / (centroid_upper[axis] - centroid_lower[axis]);
+        return SMIN(number_of_bins_ - 1, (size_t)((centroid[axis] - centroid_lower[axis]) * scale));
+    };
+
+    // binned surface area heuristic
+    Real best_cost = MaxReal;
+    int best_axis = -1;
+    size_t best_split = 0;
+    for (int axis = 0; axis != 3 && depth < max_depth_; ++axis)
+    {
+        if (centroid_upper[axis] - centroid_lower[axis] <= TinyReal)
+            continue;
+
+        std::array<size_t, number_of_bins_> bin_counts;
+        std::array<Vec3d, number_of_bins_> bin_lower, bin_upper;
+        bin_counts.fill(0);
+        bin_lower.fill(MaxReal * Vec3d::Ones());
+        bin_upper.fill(-MaxReal * Vec3d::Ones());
+        for (size_t n = begin; n != end; ++n)
+        {
+            size_t face = face_ordering_[n];
+            size_t bin = bin_index(centroids[face], axis);
+            bin_counts[bin]++;
+            bin_lower[bin] = bin_lower[bin].cwiseMin(face_bounds[face].first);
+            bin_upper[bin] = bin_upper[bin].cwiseMax(face_bounds[face].second);
+        }
+
+        std::array<Real, number_of_bins_> right_costs;
+        Vec3d right_lower = MaxReal * Vec3d::Ones();
+        Vec3d right_upper = -MaxReal * Vec3d::Ones();
+        size_t right_count = 0;
+        for (size_t bin = number_of_bins_ - 1; bin != 0; --bin)
+        {
+            right_count += bin_counts[bin];
+            right_lower = right_lower.cwiseMin(bin_lower[bin]);
+            right_upper = right_upper.cwiseMax(bin_upper[bin]);
+            right_costs[bin] = right_count == 0 ? MaxReal : (Real)right_count * half_area(right_lower, right_upper);
+        }
+
+        Vec3d left_lower = MaxReal * Vec3d::Ones();
+        Vec3d left_upper = -MaxReal * Vec3d::Ones();
+        size_t left_count = 0;
+        for (size_t split = 1; split != number_of_bins_; ++split)
+        {
+            left_count += bin_counts[split - 1];
+            left_lower = left_lower.cwiseMin(bin_lower[split - 1]);
+            left_upper = left_upper.cwiseMax(bin_upper[split - 1]);
+            if (left_count == 0 || left_count == count)
+                continue;
+            Real cost = (Real)left_count * half_area(left_lower, left_upper) + right_costs[split];
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                best_axis = axis;
+                best_split = split;
+            }
+        }
+    }
+
+    size_t middle = begin + count / 2;
+    if (best_axis >= 0)
+    {
+        middle = std::partition(face_ordering_.begin() + begin, face_ordering_.begin() + end,
+                                [&](size_t face)
+                                { return bin_index(centroids[face], best_axis) < best_split; }) -
+                 face_ordering_.begin();
+    }
+    else // coincident centroids or too deep tree, split at median
+    {
+        int axis = 0;
+        (centroid_upper - centroid_lower).maxCoeff(&axis);
+        std::nth_element(face_ordering_.begin() + begin, face_ordering_.begin() + middle, face_ordering_.begin() + end,
+                         [&](size_t face_a, size_t face_b)
+                         { return centroids[face_a][axis] < centroids[face_b][axis]; });
+    }
+
+    size_t left_child = number_of_nodes_.fetch_add(2);
+    node.first_ = left_child;
+    node.count_ = 0;
+    auto build_left = [&]()
+    { buildNode(left_child, begin, middle, depth + 1, centroids, face_bounds); };
+    auto build_right = [&]()
+    { buildNode(left_child + 1, middle, end, depth + 1, centroids, face_bounds); };
+    if (count > parallel_build_size_)
+    {
+        tbb::parallel_invoke(build_left, build_right);
+    }
+    else
+    {
+        build_left();
+        build_right();
+    }
+}
+//=================================================================================================//
+BoundingBox TriangleMeshBVH::getBounds()
+{
+    return BoundingBox(nodes_[0].lower_, nodes_[0].upper_);
+}
+//=================================================================================================//
+Real TriangleMeshBVH::squaredDistanceToBox(const Vec3d &point, const Node &node) const
+{
+    Vec3d outside = (node.lower_ - point).cwiseMax(point - node.upper_).cwiseMax(Vec3d::Zero());
+    return outside.squaredNorm();
+}
+//=================================================================================================//
+Vec3d TriangleMeshBVH::closestPointOnFace(const Vec3d &point, size_t face, Vec3d &pseudo_normal) const
+{
+    // Ericson, Real-Time Collision Detection, 2005, with the feature of the closest point identified
+    const Vec3d &a = vertices_[faces_[face][0]];
+    const Vec3d &b = vertices_[faces_[face][1]];
+    const Vec3d &c = vertices_[faces_[face][2]];
+    Vec3d ab = b - a;
+    Vec3d ac = c - a;
+
+    Vec3d ap = point - a;
+    Real d1 = ab.dot(ap);
+    Real d2 = ac.dot(ap);
+    if (d1 <= 0.0 && d2 <= 0.0)
+    {
+        pseudo_normal = vertex_normals_[faces_[face][0]];
+        return a;
+    }
+
+    Vec3d bp = point - b;
+    Real d3 = ab.dot(bp);
+    Real d4 = ac.dot(bp);
+    if (d3 >= 0.0 && d4 <= d3)
+    {
+        pseudo_normal = vertex_normals_[faces_[face][1]];
+        return b;
+    }
+
+    Real vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    {
+        pseudo_normal = edge_normals_[face_edges_[face][0]];
+        return a + d1 / (d1 - d3) * ab;
+    }
+
+    Vec3d cp = point - c;
+    Real d5 = ab.dot(cp);
+    Real d6 = ac.dot(cp);
+    if (d6 >= 0.0 && d5 <= d6)
+    {
+        pseudo_normal = vertex_normals_[faces_[face][2]];
+        return c;
+    }
+
+    Real vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    {
+        pseudo_normal = edge_normals_[face_edges_[face][2]];
+        return a + d2 / (d2 - d6) * ac;
+    }
+
+    Real va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+    {
+        pseudo_normal = edge_normals_[face_edges_[face][1]];
+        return b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b);
+    }
+
+    pseudo_normal = face_normals_[face];
+    Real denominator = 1.0 / (va + vb + vc);
+    return a + ab * vb * denominator + ac * vc * denominator;
+}
+//=================================================================================================//
+TriangleMeshBVH::ClosestPoint TriangleMeshBVH::findClosestPoint(const Vec3d &probe_point) const
+{
+    ClosestPoint closest_point;
+    closest_point.squared_distance_ = MaxReal;
+    closest_point.face_ = 0;
+
+    std::array<size_t, 2 * max_depth_> stack;
+    size_t stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size != 0)
+    {
+        const Node &node = nodes_[stack[--stack_size]];
+        if (squaredDistanceToBox(probe_point, node) >= closest_point.squared_distance_)
+            continue;
+
+        if (node.count_ != 0)
+        {
+            for (size_t n = node.first_; n != node.first_ + node.count_; ++n)
+            {
+                size_t face = face_ordering_[n];
+                Vec3d pseudo_normal;
+                Vec3d position = closestPointOnFace(probe_point, face, pseudo_normal);
+                Real squared_distance = (probe_point - position).squaredNorm();
+                if (squared_distance < closest_point.squared_distance_)
+                {
+                    closest_point.position_ = position;
+                    closest_point.pseudo_normal_ = pseudo_normal;
+                    closest_point.squared_distance_ = squared_distance;
+                    closest_point.face_ = face;
+                }
+            }
+        }
+        else
+        {
+            // the nearer child is visited first
+            Real left_distance = squaredDistanceToBox(probe_point, nodes_[node.first_]);
+            Real right_distance = squaredDistanceToBox(probe_point, nodes_[node.first_ + 1]);
+            bool is_left_nearer = left_distance < right_distance;
+            stack[stack_size++] = is_left_nearer ? node.first_ + 1 : node.first_;
+            stack[stack_size++] = is_left_nearer ? node.first_ : node.first_ + 1;
+        }
+    }
+    return closest_point;
+}
+//=================================================================================================//
+Real TriangleMeshBVH::findSignedDistance(const Vec3d &probe_point) const
+{
+    ClosestPoint closest_point = findClosestPoint(probe_point);
+    Real distance = sqrt(closest_point.squared_distance_);
+    return (probe_point - closest_point.position_).dot(closest_point.pseudo_normal_) < 0.0 ? -distance : distance;
+}
+//=================================================================================================//
+Vec3d TriangleMeshBVH::findNormalDirection(const Vec3d &probe_point) const
+{
+    ClosestPoint closest_point = findClosestPoint(probe_point);
+    Vec3d displacement = probe_point - closest_point.position_;
+    Real distance = displacement.norm();
+    if (distance < Eps)
+        return closest_point.pseudo_normal_.normalized();
+    Real sign = displacement.dot(closest_point.pseudo_normal_) < 0.0 ? -1.0 : 1.0;
+    return sign * displacement / distance;
+}
+//=================================================================================================//
+bool TriangleMeshBVH::intersectBox(const Vec3d &origin, const Vec3d &inverse_direction,
+                                   const Node &node, Real max_distance) const
+{
+    Vec3d t_lower = (node.lower_ - origin).cwiseProduct(inverse_direction);
+    Vec3d t_upper = (node.upper_ - origin).cwiseProduct(inverse_direction);
+    Real t_enter = t_lower.cwiseMin(t_upper).maxCoeff();
+    Real t_exit = t_lower.cwiseMax(t_upper).minCoeff();
+    return t_exit >= SMAX(t_enter, Real(0)) && t_enter < max_distance;
+}
+//=================================================================================================//
+bool TriangleMeshBVH::intersectFace(const Vec3d &origin, const Vec3d &direction, size_t face, Real &distance) const
+{
+    // Moller and Trumbore, Fast, minimum storage ray-triangle intersection, 1997
+    const Vec3d &a = vertices_[faces_[face][0]];
+    Vec3d edge_1 = vertices_[faces_[face][1]] - a;
+    Vec3d edge_2 = vertices_[faces_[face][2]] - a;
+    Vec3d p = direction.cross(edge_2);
+    Real determinant = edge_1.dot(p);
+    if (fabs(determinant) < TinyReal)
+        return false;
+
+    Real inverse_determinant = 1.0 / determinant;
+    Vec3d t = origin - a;
+    Real u = t.dot(p) * inverse_determinant;
+    if (u < 0.0 || u > 1.0)
+        return false;
+    Vec3d q = t.cross(edge_1);
+    Real v = direction.dot(q) * inverse_determinant;
+    if (v < 0.0 || u + v > 1.0)
+        return false;
+    distance = edge_2.dot(q) * inverse_determinant;
+    return distance > 0.0;
+}
+//=================================================================================================//
+bool TriangleMeshBVH::intersectRay(const Vec3d &origin, const Vec3d &direction, Real &distance, size_t &face) const
+{
+    Vec3d inverse_direction = direction.cwiseInverse();
+    distance = MaxReal;
+    bool is_found = false;
+
+    std::array<size_t, 2 * max_depth_> stack;
+    size_t stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size != 0)
+    {
+        const Node &node = nodes_[stack[--stack_size]];
+        if (!intersectBox(origin, inverse_direction, node, distance))
+            continue;
+
+        if (node.count_ != 0)
+        {
+            for (size_t n = node.first_; n != node.first_ + node.count_; ++n)
+            {
+                Real face_distance = MaxReal;
+                if (intersectFace(origin, direction, face_ordering_[n], face_distance) && face_distance < distance)
+                {
+                    distance = face_distance;
+                    face = face_ordering_[n];
+                    is_found = true;
+                }
+            }
+        }
+        else
+        {
+            stack[stack_size++] = node.first_ + 1;
+            stack[stack_size++] = node.first_;
+        }
+    }
+    return is_found;
+}
+//=================================================================================================//
+void TriangleMeshBVH::findClosestPoints(const StdVec<Vec3d> &probe_points, StdVec<Vec3d> &closest_points) const
+{
+    closest_points.resize(probe_points.size());
+    parallel_for(
+        IndexRange(0, probe_points.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                closest_points[i] = findClosestPoint(probe_points[i]).position_;
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void TriangleMeshBVH::findSignedDistances(const StdVec<Vec3d> &probe_points, StdVec<Real> &signed_distances) const
+{
+    signed_distances.resize(probe_points.size());
+    parallel_for(
+        IndexRange(0, probe_points.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                signed_distances[i] = findSignedDistance(probe_points[i]);
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+} // namespace SPH
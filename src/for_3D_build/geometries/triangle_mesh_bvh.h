@@ -0,0 +1,109 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	triangle_mesh_bvh.h
+ * @brief 	Bounding volume hierarchy for geometric queries on triangle meshes.
+ * @details The hierarchy of axis-aligned bounding boxes is built with the binned
+ *          surface area heuristic (SAH). The sign of the distance is given by the
+ *          angle-weighted pseudo-normals of the closest feature (face, edge or vertex),
+ *          which is robust for closed and consistently oriented meshes.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef TRIANGLE_MESH_BVH_H
+#define TRIANGLE_MESH_BVH_H
+
+#include "base_data_package.h"
+
+namespace SPH
+{
+/**
+ * @class TriangleMeshBVH
+ * @brief Bounding volume hierarchy over the triangles of a closed mesh
+ * for closest-point, signed-distance and ray queries, single or batched.
+ * The mesh is not changed after construction so that all queries are thread safe.
+ */
+class TriangleMeshBVH
+{
+  public:
+    /** Result of a closest-point query. */
+    struct ClosestPoint
+    {
+        Vec3d position_;      /**< the closest point on the mesh */
+        Vec3d pseudo_normal_; /**< pseudo-normal of the feature on which the closest point locates */
+        Real squared_distance_;
+        size_t face_;
+    };
+
+    TriangleMeshBVH(const StdVec<Vec3d> &vertices, const StdVec<Array3i> &faces);
+    virtual ~TriangleMeshBVH(){};
+
+    size_t NumberOfFaces() { return faces_.size(); };
+    size_t NumberOfNodes() { return nodes_.size(); };
+    BoundingBox getBounds();
+    ClosestPoint findClosestPoint(const Vec3d &probe_point) const;
+    /** Signed distance is negative for point within the mesh. */
+    Real findSignedDistance(const Vec3d &probe_point) const;
+    /** Normal direction point toward outside of the mesh. */
+    Vec3d findNormalDirection(const Vec3d &probe_point) const;
+    /** find the first intersection along the ray, return false if there is none. */
+    bool intersectRay(const Vec3d &origin, const Vec3d &direction, Real &distance, size_t &face) const;
+    /** batched queries carried out in parallel */
+    void findClosestPoints(const StdVec<Vec3d> &probe_points, StdVec<Vec3d> &closest_points) const;
+    void findSignedDistances(const StdVec<Vec3d> &probe_points, StdVec<Real> &signed_distances) const;
+
+  protected:
+    /** The two children of an inner node are stored next to each other.
+     *  A leaf node holds a contiguous range in the face ordering. */
+    struct Node
+    {
+        Vec3d lower_, upper_;
+        size_t first_; /**< first child for inner node, first face for leaf */
+        size_t count_; /**< number of faces, zero for inner node */
+    };
+    static constexpr size_t max_leaf_size_ = 4;
+    static constexpr size_t number_of_bins_ = 16;
+    static constexpr size_t max_depth_ = 96;
+    static constexpr size_t parallel_build_size_ = 4096;
+
+    StdVec<Vec3d> vertices_;
+    StdVec<Array3i> faces_;
+    StdVec<Vec3d> face_normals_;
+    StdVec<Vec3d> vertex_normals_;                /**< angle-weighted pseudo-normals */
+    StdVec<std::array<size_t, 3>> face_edges_;    /**< edge index of the edge from vertex k to k + 1 */
+    StdVec<Vec3d> edge_normals_;                  /**< sum of the normals of the two adjacent faces */
+    StdVec<size_t> face_ordering_;                /**< faces ordered by leaves */
+    StdVec<Node> nodes_;
+    std::atomic<size_t> number_of_nodes_;
+
+    void computePseudoNormals();
+    void buildNode(size_t node_index, size_t begin, size_t end, size_t depth,
+                   const StdVec<Vec3d> &centroids, const StdVec<std::pair<Vec3d, Vec3d>> &face_bounds);
+    Real squaredDistanceToBox(const Vec3d &point, const Node &node) const;
+    /** closest point on a face and the pseudo-normal of the feature where the point locates */
+    Vec3d closestPointOnFace(const Vec3d &point, size_t face, Vec3d &pseudo_normal) const;
+    bool intersectBox(const Vec3d &origin, const Vec3d &inverse_direction, const Node &node, Real max_distance) const;
+    bool intersectFace(const Vec3d &origin, const Vec3d &direction, size_t face, Real &distance) const;
+};
+} // namespace SPH
+#endif // TRIANGLE_MESH_BVH_H
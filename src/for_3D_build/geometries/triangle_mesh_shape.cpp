@@ -29,6 +29,23 @@ SimTK::ContactGeometry::TriangleMesh *TriangleMeshShape::getTriangleMesh()
     return triangle_mesh_;
 }
 //=================================================================================================//
+UniquePtr<TriangleMeshBVH> TriangleMeshShape::createTriangleMeshBVH()
+{
+    SimTK::ContactGeometry::TriangleMesh *triangle_mesh = getTriangleMesh();
+    StdVec<Vec3d> vertices(triangle_mesh->getNumVertices());
+    for (size_t i = 0; i != vertices.size(); ++i)
+    {
+        vertices[i] = SimTKToEigen(triangle_mesh->getVertexPosition(i));
+    }
+    StdVec<Array3i> faces(triangle_mesh->getNumFaces());
+    for (size_t i = 0; i != faces.size(); ++i)
+    {
+        faces[i] = Array3i(triangle_mesh->getFaceVertex(i, 0), triangle_mesh->getFaceVertex(i, 1),
+                           triangle_mesh->getFaceVertex(i, 2));
+    }
+    return makeUnique<TriangleMeshBVH>(vertices, faces);
+}
+//=================================================================================================//
 bool TriangleMeshShape::checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED)
 {
     SimTKVec2 uv_coordinate;
@@ -79,6 +96,19 @@ Vecd TriangleMeshShape::findClosestPoint(const Vecd &probe_point)
     return Vecd(closest_pnt[0], closest_pnt[1], closest_pnt[2]);
 }
 //=================================================================================================//
+bool TriangleMeshShape::writeGeometryFingerprint(std::ostream &output)
+{
+    SimTK::ContactGeometry::TriangleMesh *triangle_mesh = getTriangleMesh();
+    writeBinaryValue(output, triangle_mesh->getNumVertices());
+    for (int i = 0; i != triangle_mesh->getNumVertices(); ++i)
+        writeBinaryValue(output, SimTKToEigen(triangle_mesh->getVertexPosition(i)));
+    writeBinaryValue(output, triangle_mesh->getNumFaces());
+    for (int i = 0; i != triangle_mesh->getNumFaces(); ++i)
+        writeBinaryValue(output, Array3i(triangle_mesh->getFaceVertex(i, 0), triangle_mesh->getFaceVertex(i, 1),
+                                         triangle_mesh->getFaceVertex(i, 2)));
+    return true;
+}
+//=================================================================================================//
 BoundingBox TriangleMeshShape::findBounds()
 {
     int number_of_vertices = triangle_mesh_->getNumVertices();
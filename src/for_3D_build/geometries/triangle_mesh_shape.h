@@ -32,6 +32,7 @@
 
 #include "all_simbody.h"
 #include "base_geometry.h"
+#include "triangle_mesh_bvh.h"
 
 #include <filesystem>
 #include <fstream>
@@ -62,8 +63,12 @@ class TriangleMeshShape : public Shape
      * when probe distance is far from the surface. */
     virtual bool checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED = true) override;
     virtual Vec3d findClosestPoint(const Vec3d &probe_point) override;
+    /** the vertices and faces of the triangle mesh */
+    virtual bool writeGeometryFingerprint(std::ostream &output) override;
 
     SimTK::ContactGeometry::TriangleMesh *getTriangleMesh();
+    /** bounding volume hierarchy over the triangles of the mesh */
+    UniquePtr<TriangleMeshBVH> createTriangleMeshBVH();
 
   protected:
     SimTK::ContactGeometry::TriangleMesh *triangle_mesh_;
@@ -73,6 +78,54 @@ class TriangleMeshShape : public Shape
     virtual BoundingBox findBounds() override;
 };
 
+/**
+ * @class BVHTriangleMeshShape
+ * @brief A template triangle mesh shape, e.g. BVHTriangleMeshShape<TriangleMeshShapeSTL>,
+ * whose queries are carried out by a bounding volume hierarchy instead of Simbody.
+ * The sign of the distance is given by the pseudo-normals so that the mesh should be closed
+ * and consistently oriented, but the jittering for probe points close to the surface is not required.
+ */
+template <class TriangleMeshShapeType>
+class BVHTriangleMeshShape : public TriangleMeshShapeType
+{
+  private:
+    UniquePtrKeeper<TriangleMeshBVH> bvh_ptr_keeper_;
+
+  public:
+    using SignedDistanceQuery = TriangleMeshBVH;
+
+    template <typename... Args>
+    explicit BVHTriangleMeshShape(Args &&...args)
+        : TriangleMeshShapeType(std::forward<Args>(args)...),
+          bvh_(*bvh_ptr_keeper_.movePtr(this->createTriangleMeshBVH())){};
+    virtual ~BVHTriangleMeshShape(){};
+
+    TriangleMeshBVH &getBVH() { return bvh_; };
+
+    virtual bool checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED = true) override
+    {
+        return bvh_.findSignedDistance(probe_point) < 0.0;
+    };
+
+    virtual Vec3d findClosestPoint(const Vec3d &probe_point) override
+    {
+        return bvh_.findClosestPoint(probe_point).position_;
+    };
+
+    virtual Real findSignedDistance(const Vec3d &probe_point) override
+    {
+        return bvh_.findSignedDistance(probe_point);
+    };
+
+    virtual Vec3d findNormalDirection(const Vec3d &probe_point) override
+    {
+        return bvh_.findNormalDirection(probe_point);
+    };
+
+  protected:
+    TriangleMeshBVH &bvh_;
+};
+
 /**
  * @class TriangleMeshShapeSTL
  * @brief Input triangle mesh with stl file.
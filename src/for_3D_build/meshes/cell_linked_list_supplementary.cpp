@@ -3,7 +3,7 @@
  * @author	Luhui Han, Chi Zhang and Xiangyu Hu
  */
 
-#include "cell_linked_list.h"
+#include "cell_linked_list.hpp"
 
 #include "base_particles.hpp"
 #include "mesh_iterators.hpp"
@@ -19,8 +19,21 @@ void CellLinkedList ::allocateMeshDataMatrix()
 //=================================================================================================//
 void CellLinkedList ::deleteMeshDataMatrix()
 {
-    Delete3dArray(cell_index_lists_, all_cells_);
-    Delete3dArray(cell_data_lists_, all_cells_);
+    if (cell_index_lists_ != nullptr)
+    {
+        Delete3dArray(cell_index_lists_, all_cells_);
+        Delete3dArray(cell_data_lists_, all_cells_);
+    }
+}
+//=================================================================================================//
+ConcurrentIndexVector &CellLinkedList::ParticleIndexesInCell(const Array3i &cell_index)
+{
+    return cell_index_lists_[cell_index[0]][cell_index[1]][cell_index[2]];
+}
+//=================================================================================================//
+ListDataVector &CellLinkedList::ListDataInCell(const Array3i &cell_index)
+{
+    return cell_data_lists_[cell_index[0]][cell_index[1]][cell_index[2]];
 }
 //=================================================================================================//
 void CellLinkedList::clearCellLists()
@@ -75,6 +88,7 @@ void CellLinkedList ::insertParticleIndex(size_t particle_index, const Vecd &par
 void CellLinkedList ::InsertListDataEntry(size_t particle_index,
                                           const Vecd &particle_position, Real volumetric)
 {
+    has_entries_in_cell_lists_ = true;
     Array3i cell_pos = CellIndexFromPosition(particle_position);
     cell_data_lists_[cell_pos[0]][cell_pos[1]][cell_pos[2]].emplace_back(
         std::make_tuple(particle_index, particle_position, volumetric));
@@ -84,6 +98,15 @@ ListData CellLinkedList::findNearestListDataEntry(const Vecd &position)
 {
     Real min_distance_sqr = MaxReal;
     ListData nearest_entry = std::make_tuple(MaxSize_t, MaxReal * Vecd::Ones(), MaxReal);
+    auto check_entry = [&](const ListData &list_data)
+    {
+        Real distance_sqr = (position - std::get<1>(list_data)).squaredNorm();
+        if (distance_sqr < min_distance_sqr)
+        {
+            min_distance_sqr = distance_sqr;
+            nearest_entry = list_data;
+        }
+    };
 
     Array3i cell = CellIndexFromPosition(position);
     mesh_for_each(
@@ -91,16 +114,10 @@ ListData CellLinkedList::findNearestListDataEntry(const Vecd &position)
         all_cells_.min(cell + 2 * Array3i::Ones()),
         [&](int l, int m, int n)
         {
-            ListDataVector &target_particles = cell_data_lists_[l][m][n];
-            for (const ListData &list_data : target_particles)
-            {
-                Real distance_sqr = (position - std::get<1>(list_data)).squaredNorm();
-                if (distance_sqr < min_distance_sqr)
-                {
-                    min_distance_sqr = distance_sqr;
-                    nearest_entry = list_data;
-                }
-            }
+            for (const ListData &list_data : ContiguousListData(Array3i(l, m, n)))
+                check_entry(list_data);
+            for (const ListData &list_data : CellDataList(Array3i(l, m, n)))
+                check_entry(list_data);
         });
     return nearest_entry;
 }
@@ -108,6 +125,7 @@ ListData CellLinkedList::findNearestListDataEntry(const Vecd &position)
 void CellLinkedList::
     tagBodyPartByCell(ConcurrentCellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included)
 {
+    has_tagged_cells_ = true;
     mesh_parallel_for(
         MeshRange(Array3i::Zero(), all_cells_),
         [&](int i, int j, int k)
@@ -124,13 +142,14 @@ void CellLinkedList::
                     }
                 });
             if (is_included == true)
-                cell_lists.push_back(&cell_index_lists_[i][j][k]);
+                cell_lists.push_back(&ParticleIndexesInCell(Array3i(i, j, k)));
         });
 }
 //=================================================================================================//
 void CellLinkedList::
     tagBoundingCells(StdVec<CellLists> &cell_data_lists, const BoundingBox &bounding_bounds, int axis)
 {
+    has_tagged_cells_ = true;
     int second_axis = NextAxis(axis);
     int third_axis = NextNextAxis(axis);
     Array3i body_lower_bound_cell_ = CellIndexFromPosition(bounding_bounds.first_);
@@ -150,8 +169,8 @@ void CellLinkedList::
                 cell[axis] = i;
                 cell[second_axis] = j;
                 cell[third_axis] = k;
-                cell_data_lists[0].first.push_back(&cell_index_lists_[cell[0]][cell[1]][cell[2]]);
-                cell_data_lists[0].second.push_back(&cell_data_lists_[cell[0]][cell[1]][cell[2]]);
+                cell_data_lists[0].first.push_back(&ParticleIndexesInCell(cell));
+                cell_data_lists[0].second.push_back(&ListDataInCell(cell));
             }
         }
     }
@@ -170,8 +189,8 @@ void CellLinkedList::
                 cell[axis] = i;
                 cell[second_axis] = j;
                 cell[third_axis] = k;
-                cell_data_lists[1].first.push_back(&cell_index_lists_[cell[0]][cell[1]][cell[2]]);
-                cell_data_lists[1].second.push_back(&cell_data_lists_[cell[0]][cell[1]][cell[2]]);
+                cell_data_lists[1].first.push_back(&ParticleIndexesInCell(cell));
+                cell_data_lists[1].second.push_back(&ListDataInCell(cell));
             }
         }
     }
@@ -231,7 +250,7 @@ void CellLinkedList::writeMeshFieldToPlt(std::ofstream &output_file)
         {
             for (int i = 0; i != number_of_operation[0]; ++i)
             {
-                output_file << cell_index_lists_[i][j][k].size() << " ";
+                output_file << cell_index_lists_[i][j][k].size() + ContiguousListData(Array3i(i, j, k)).size() << " ";
             }
             output_file << " \n";
         }
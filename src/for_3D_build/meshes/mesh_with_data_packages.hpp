@@ -43,9 +43,18 @@ template <class DataType>
 DataType GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
     probeDataPackage(PackageDataAddress<DataType> &pkg_data_addrs, const Vecd &position)
 {
-    Arrayi grid_idx = CellIndexFromPosition(position);
-    Vecd grid_pos = GridPositionFromIndex(grid_idx);
-    Vecd alpha = (position - grid_pos) / grid_spacing_;
+    Arrayi grid_idx;
+    Vecd alpha;
+    interpolationStencil(position, grid_idx, alpha);
+    return interpolateDataPackage(pkg_data_addrs, grid_idx, alpha);
+}
+//=================================================================================================//
+template <int PKG_SIZE, int ADDRS_BUFFER>
+template <class DataType>
+DataType GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
+    interpolateDataPackage(PackageDataAddress<DataType> &pkg_data_addrs,
+                           const Arrayi &grid_idx, const Vecd &alpha)
+{
     Vecd beta = Vecd::Ones() - alpha;
 
     DataType bilinear_1 = *pkg_data_addrs[grid_idx[0]][grid_idx[1]][grid_idx[2]] * beta[0] * beta[1] +
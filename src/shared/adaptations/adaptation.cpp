@@ -91,6 +91,12 @@ UniquePtr<BaseCellLinkedList> SPHAdaptation::
     return makeUnique<CellLinkedList>(domain_bounds, kernel_ptr_->CutOffRadius(), real_body, *this);
 }
 //=================================================================================================//
+UniquePtr<BaseCellLinkedList> SPHAdaptation::
+    createSparseCellLinkedList(const BoundingBox &domain_bounds, RealBody &real_body)
+{
+    return makeUnique<SparseCellLinkedList>(domain_bounds, kernel_ptr_->CutOffRadius(), real_body, *this);
+}
+//=================================================================================================//
 UniquePtr<BaseLevelSet> SPHAdaptation::createLevelSet(Shape &shape, Real refinement_ratio)
 {
     // estimate the required mesh levels
@@ -84,6 +84,8 @@ class SPHAdaptation
     virtual void initializeAdaptationVariables(BaseParticles &base_particles){};
 
     virtual UniquePtr<BaseCellLinkedList> createCellLinkedList(const BoundingBox &domain_bounds, RealBody &real_body);
+    /** cell linked list allocating only occupied cells, for single resolution only */
+    UniquePtr<BaseCellLinkedList> createSparseCellLinkedList(const BoundingBox &domain_bounds, RealBody &real_body);
     virtual UniquePtr<BaseLevelSet> createLevelSet(Shape &shape, Real refinement_ratio);
 
     template <class KernelType, typename... Args>
@@ -97,6 +97,16 @@ void SPHBody::readParticlesFromXmlForRestart(std::string &filefullpath)
     base_particles_->readParticleFromXmlForRestart(filefullpath);
 }
 //=================================================================================================//
+void SPHBody::writeParticlesToBinaryForRestart(std::string &filefullpath)
+{
+    base_particles_->writeParticlesToBinaryForRestart(filefullpath);
+}
+//=================================================================================================//
+void SPHBody::readParticlesFromBinaryForRestart(std::string &filefullpath)
+{
+    base_particles_->readParticleFromBinaryForRestart(filefullpath);
+}
+//=================================================================================================//
 void SPHBody::writeToXmlForReloadParticle(std::string &filefullpath)
 {
     base_particles_->writeToXmlForReloadParticle(filefullpath);
@@ -107,18 +117,45 @@ void SPHBody::readFromXmlForReloadParticle(std::string &filefullpath)
     base_particles_->readFromXmlForReloadParticle(filefullpath);
 }
 //=================================================================================================//
+void SPHBody::writeToBinaryForReloadParticle(std::string &filefullpath)
+{
+    base_particles_->writeToBinaryForReloadParticle(filefullpath);
+}
+//=================================================================================================//
+void SPHBody::readFromBinaryForReloadParticle(std::string &filefullpath)
+{
+    base_particles_->readFromBinaryForReloadParticle(filefullpath);
+}
+//=================================================================================================//
 BaseCellLinkedList &RealBody::getCellLinkedList()
 {
     if (!cell_linked_list_created_)
     {
-        cell_linked_list_ptr_ = sph_adaptation_->createCellLinkedList(getSPHSystemBounds(), *this);
+        cell_linked_list_ptr_ = use_sparse_cell_linked_list_
+                                    ? sph_adaptation_->createSparseCellLinkedList(getSPHSystemBounds(), *this)
+                                    : sph_adaptation_->createCellLinkedList(getSPHSystemBounds(), *this);
         cell_linked_list_created_ = true;
     }
     return *cell_linked_list_ptr_.get();
 }
 //=================================================================================================//
+void RealBody::useSparseCellLinkedList()
+{
+    if (cell_linked_list_created_)
+    {
+        std::cout << "\n Error: the cell linked list of " << getName() << " has already been created!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    use_sparse_cell_linked_list_ = true;
+}
+//=================================================================================================//
 void RealBody::updateCellLinkedList()
 {
+    SPHINXSYS_PROFILE_SCOPE(cell_linked_list_profile_.get([&]()
+                                                          { return getName() + ": updateCellLinkedList"; }),
+                            base_particles_->total_real_particles_,
+                            base_particles_->total_real_particles_ * (sizeof(Vecd) + sizeof(ListData)));
     getCellLinkedList().UpdateCellLists(*base_particles_);
 }
 //=================================================================================================//
@@ -42,6 +42,7 @@
 #include "base_particle_generator.h"
 #include "base_particles.h"
 #include "cell_linked_list.h"
+#include "dynamics_profiler.h"
 #include "particle_sorting.h"
 #include "sph_data_containers.h"
 #include "sph_system.h"
@@ -208,8 +209,12 @@ class SPHBody
     virtual void writeSurfaceParticlesToVtuFile(std::ofstream &output_file, BodySurface &surface_particles);
     virtual void writeParticlesToXmlForRestart(std::string &filefullpath);
     virtual void readParticlesFromXmlForRestart(std::string &filefullpath);
+    virtual void writeParticlesToBinaryForRestart(std::string &filefullpath);
+    virtual void readParticlesFromBinaryForRestart(std::string &filefullpath);
     virtual void writeToXmlForReloadParticle(std::string &filefullpath);
     virtual void readFromXmlForReloadParticle(std::string &filefullpath);
+    virtual void writeToBinaryForReloadParticle(std::string &filefullpath);
+    virtual void readFromBinaryForReloadParticle(std::string &filefullpath);
     virtual SPHBody *ThisObjectPtr() { return this; };
 };
 
@@ -229,28 +234,41 @@ class RealBody : public SPHBody
      * they have no interaction because they are too far.
      */
     SplitCellLists split_cell_lists_;
+    ContiguousSplitCellLists contiguous_split_cell_lists_;
     bool use_split_cell_lists_;
     size_t iteration_count_;
     bool cell_linked_list_created_;
+    bool use_sparse_cell_linked_list_;
+#if SPHINXSYS_USE_PROFILING
+    ProfileRecordHandle cell_linked_list_profile_;
+#endif
 
   public:
     template <typename... Args>
     RealBody(Args &&...args)
         : SPHBody(std::forward<Args>(args)...),
           use_split_cell_lists_(false), iteration_count_(1),
-          cell_linked_list_created_(false)
+          cell_linked_list_created_(false), use_sparse_cell_linked_list_(false)
     {
         this->getSPHSystem().real_bodies_.push_back(this);
         size_t number_of_split_cell_lists = pow(3, Dimensions);
         split_cell_lists_.resize(number_of_split_cell_lists);
+        contiguous_split_cell_lists_.cell_ranges_.resize(number_of_split_cell_lists);
     };
     virtual ~RealBody(){};
     BaseCellLinkedList &getCellLinkedList();
+    /** allocate only the occupied cells, to be called before the cell linked list is used */
+    void useSparseCellLinkedList();
     void setUseSplitCellLists() { use_split_cell_lists_ = true; };
     bool getUseSplitCellLists() { return use_split_cell_lists_; };
     SplitCellLists &getSplitCellLists() { return split_cell_lists_; };
+    ContiguousSplitCellLists &getContiguousSplitCellLists() { return contiguous_split_cell_lists_; };
     void updateCellLinkedList();
     void updateCellLinkedListWithParticleSort(size_t particle_sort_period);
+    /** choose the space-filling curve along which particles are sorted */
+    void setParticleSortingCurve(SpaceFillingCurve curve) { getCellLinkedList().setSpaceFillingCurve(curve); };
+    /** choose the algorithm by which particle data are sorted */
+    void setParticleSortingMethod(ParticleSortingMethod method) { base_particles_->particle_sorting_.setSortingMethod(method); };
 };
 } // namespace SPH
 #endif // BASE_BODY_H
@@ -22,7 +22,7 @@ void TreeBody::buildParticleConfiguration(ParticleConfiguration &particle_config
     /** Build configuration. */
     const StdLargeVec<Vecd> &pos = base_particles_->pos_;
     const StdLargeVec<Real> &Vol = base_particles_->Vol_;
-    NeighborBuilderInner neighbor_relation_inner(*this);
+    NeighborBuilderInner<> neighbor_relation_inner(*this);
     for (size_t n = 0; n != neighboring_ids.size(); ++n)
     {
         size_t index_j = neighboring_ids[n];
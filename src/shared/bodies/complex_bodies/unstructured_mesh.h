@@ -161,7 +161,6 @@ class GhostCreationFromMesh : public GeneralDataDelegateSimple
 
   protected:
     Ghost<ReserveSizeFactor> &ghost_boundary_;
-    std::mutex mutex_create_ghost_particle_; /**< mutex exclusion for memory conflict */
     StdLargeVec<Vecd> &node_coordinates_;
     vector<vector<vector<size_t>>> &mesh_topology_;
     StdLargeVec<Vecd> &pos_;
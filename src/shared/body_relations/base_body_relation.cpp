@@ -1,5 +1,7 @@
 #include "base_body_relation.h"
 #include "base_particle_dynamics.h"
+#include "particle_functors.h"
+#include "particle_iterators.h"
 
 namespace SPH
 {
@@ -15,6 +17,42 @@ RealBodyVector BodyPartsToRealBodies(BodyPartVector body_parts)
     return real_bodies;
 }
 //=================================================================================================//
+NeighborSkin::NeighborSkin(BaseParticles &base_particles)
+    : base_particles_(base_particles), total_real_particles_at_search_(0), total_searches_(0) {}
+//=================================================================================================//
+void NeighborSkin::recordSearch()
+{
+    total_searches_++;
+    total_real_particles_at_search_ = base_particles_.total_real_particles_;
+    pos_at_search_.resize(total_real_particles_at_search_);
+    unsorted_id_at_search_.resize(total_real_particles_at_search_);
+    StdLargeVec<Vecd> &pos = base_particles_.pos_;
+    StdLargeVec<size_t> &unsorted_id = base_particles_.unsorted_id_;
+    particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles_at_search_),
+                 [&](size_t i)
+                 {
+                     pos_at_search_[i] = pos[i];
+                     unsorted_id_at_search_[i] = unsorted_id[i];
+                 });
+}
+//=================================================================================================//
+Real NeighborSkin::MaximumDisplacement()
+{
+    if (base_particles_.total_real_particles_ != total_real_particles_at_search_)
+        return MaxReal;
+
+    StdLargeVec<Vecd> &pos = base_particles_.pos_;
+    StdLargeVec<size_t> &unsorted_id = base_particles_.unsorted_id_;
+    return particle_reduce(execution::ParallelPolicy(), IndexRange(0, total_real_particles_at_search_),
+                           Real(0), ReduceMax(),
+                           [&](size_t i) -> Real
+                           {
+                               return unsorted_id[i] == unsorted_id_at_search_[i]
+                                          ? (pos[i] - pos_at_search_[i]).norm()
+                                          : MaxReal;
+                           });
+}
+//=================================================================================================//
 SPHRelation::SPHRelation(SPHBody &sph_body)
     : sph_body_(sph_body), base_particles_(sph_body.getBaseParticles()) {}
 //=================================================================================================//
@@ -34,6 +72,7 @@ void BaseInnerRelation::resetNeighborhoodCurrentSize()
             for (size_t num = r.begin(); num != r.end(); ++num)
             {
                 inner_configuration_[num].current_size_ = 0;
+                inner_configuration_[num].skin_size_ = 0;
             }
         },
         ap);
@@ -61,6 +100,7 @@ void BaseContactRelation::resetNeighborhoodCurrentSize()
                 for (size_t num = r.begin(); num != r.end(); ++num)
                 {
                     contact_configuration_[k][num].current_size_ = 0;
+                    contact_configuration_[k][num].skin_size_ = 0;
                 }
             },
             ap);
@@ -96,6 +96,46 @@ struct SearchDepthAdaptiveContact
     };
 };
 
+/** @brief a small functor for obtaining search depth for a search radius enlarged by a skin
+ * @details Note that the search depth is defined on the target cell linked list.
+ */
+struct SearchDepthWithSkin
+{
+    int search_depth_;
+    SearchDepthWithSkin(Real search_radius, CellLinkedList *target_cell_linked_list)
+        : search_depth_(1 + (int)floor(search_radius / target_cell_linked_list->GridSpacing())){};
+    int operator()(size_t particle_index) const { return search_depth_; };
+};
+
+/**
+ * @class NeighborSkin
+ * @brief Tracks the particle displacements of a body since the last neighbor search.
+ * @details The configurations searched with a skin distance beyond the cut-off radius
+ * stay valid as long as the displacements of two particles add up to less than the skin.
+ * Particle sorting, creation or deletion since the search gives the maximum real as displacement,
+ * so that the neighbor search is always carried out after them.
+ */
+class NeighborSkin
+{
+  protected:
+    BaseParticles &base_particles_;
+    size_t total_real_particles_at_search_;
+    StdLargeVec<Vecd> pos_at_search_;
+    StdLargeVec<size_t> unsorted_id_at_search_;
+    size_t total_searches_;
+
+  public:
+    explicit NeighborSkin(BaseParticles &base_particles);
+    virtual ~NeighborSkin(){};
+
+    /** record the particle positions at the present neighbor search */
+    void recordSearch();
+    /** maximum particle displacement since the last recorded search */
+    Real MaximumDisplacement();
+    /** number of the recorded searches */
+    size_t TotalSearches() { return total_searches_; };
+};
+
 /** Transfer body parts to real bodies. **/
 RealBodyVector BodyPartsToRealBodies(BodyPartVector body_parts);
 
@@ -107,6 +147,15 @@ class SPHRelation
 {
   protected:
     SPHBody &sph_body_;
+#if SPHINXSYS_USE_PROFILING
+    ProfileRecordHandle profile_record_;
+    /** the record named by the body and the relation type */
+    ProfileRecord &profileRecord()
+    {
+        return profile_record_.get([&]()
+                                   { return sph_body_.getName() + ": " + profileTypeName(typeid(*this)); });
+    };
+#endif
 
   public:
     BaseParticles &base_particles_;
@@ -2,30 +2,178 @@
 #include "all_particles.h"
 #include "base_particle_dynamics.h"
 #include "cell_linked_list.hpp"
+#include "neighborhood.hpp"
 #include <numeric>
 
 namespace SPH
 {
 //=================================================================================================//
 ContactRelation::ContactRelation(SPHBody &sph_body, RealBodyVector contact_bodies)
-    : ContactRelationCrossResolution(sph_body, contact_bodies)
+    : ContactRelationCrossResolution(sph_body, contact_bodies),
+      skin_distance_(0.0), neighbor_skin_(nullptr)
+{
+    specializeKernel(true);
+}
+//=================================================================================================//
+void ContactRelation::specializeKernel(bool is_specialized)
 {
+    search_neighbors_within_cut_off_.clear();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
-        get_contact_neighbors_.push_back(
-            neighbor_builder_contact_ptrs_keeper_.createPtr<NeighborBuilderContact>(
-                sph_body_, *contact_bodies_[k]));
+        Kernel *kernel = NeighborBuilder::chooseKernel(sph_body_, *contact_bodies_[k]);
+        dispatchKernelType(kernel, is_specialized,
+                           [&](auto kernel_type_tag)
+                           {
+                               using KernelType = typename decltype(kernel_type_tag)::type;
+                               search_neighbors_within_cut_off_.push_back(
+                                   &ContactRelation::searchNeighborsByKernel<KernelType>);
+                           });
+    }
+}
+//=================================================================================================//
+void ContactRelation::usePackedNeighborStorage(Real reserve_ratio)
+{
+    packed_neighbor_storages_.clear();
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        packed_neighbor_storages_.push_back(
+            packed_neighbor_storage_ptrs_keeper_.createPtr<PackedNeighborStorage>(reserve_ratio));
+        packed_neighbor_storages_[k]->reallocate(contact_configuration_[k], 0);
+    }
+}
+//=================================================================================================//
+void ContactRelation::useVerletSkin(Real skin_distance)
+{
+    skin_distance_ = skin_distance;
+    get_contact_neighbors_with_skin_.clear();
+    get_search_depths_with_skin_.clear();
+    contact_neighbor_skins_.clear();
+    neighbor_skin_ = neighbor_skin_ptrs_keeper_.createPtr<NeighborSkin>(base_particles_);
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        get_contact_neighbors_with_skin_.push_back(
+            neighbor_builder_with_skin_ptrs_keeper_.createPtr<NeighborBuilderContactWithSkin>(
+                sph_body_, *contact_bodies_[k], skin_distance));
+        get_search_depths_with_skin_.push_back(
+            search_depth_with_skin_ptrs_keeper_.createPtr<SearchDepthWithSkin>(
+                get_contact_neighbors_with_skin_[k]->SearchRadius(), target_cell_linked_lists_[k]));
+        contact_neighbor_skins_.push_back(
+            neighbor_skin_ptrs_keeper_.createPtr<NeighborSkin>(contact_bodies_[k]->getBaseParticles()));
+    }
+}
+//=================================================================================================//
+void ContactRelation::searchNeighbors(size_t contact_index)
+{
+    ParticleConfiguration &configuration = contact_configuration_[contact_index];
+    parallel_for(
+        IndexRange(0, base_particles_.total_real_particles_),
+        [&](const IndexRange &r)
+        {
+            for (size_t num = r.begin(); num != r.end(); ++num)
+            {
+                configuration[num].current_size_ = 0;
+                configuration[num].skin_size_ = 0;
+            }
+        },
+        ap);
+
+    if (neighbor_skin_ == nullptr)
+    {
+        (this->*search_neighbors_within_cut_off_[contact_index])(contact_index);
+    }
+    else
+    {
+        NeighborBuilderContactWithSkin &get_contact_neighbor = *get_contact_neighbors_with_skin_[contact_index];
+        Real search_radius = get_contact_neighbor.SearchRadius();
+        target_cell_linked_lists_[contact_index]->searchNeighborsByParticles(
+            sph_body_, configuration, *get_search_depths_with_skin_[contact_index],
+            get_contact_neighbor, search_radius * search_radius);
     }
 }
 //=================================================================================================//
+template <class KernelType>
+void ContactRelation::searchNeighborsByKernel(size_t contact_index)
+{
+    NeighborBuilderContact<KernelType> get_contact_neighbor(sph_body_, *contact_bodies_[contact_index]);
+    target_cell_linked_lists_[contact_index]->searchNeighborsByParticles(
+        sph_body_, contact_configuration_[contact_index], *get_search_depths_[contact_index],
+        get_contact_neighbor, get_contact_neighbor.CutOffRadiusSqr());
+}
+//=================================================================================================//
+void ContactRelation::buildConfiguration(size_t contact_index)
+{
+    searchNeighbors(contact_index);
+    if (!packed_neighbor_storages_.empty())
+    {
+        size_t total_real_particles = base_particles_.total_real_particles_;
+        ParticleConfiguration &configuration = contact_configuration_[contact_index];
+        PackedNeighborStorage &packed_neighbor_storage = *packed_neighbor_storages_[contact_index];
+        if (!packed_neighbor_storage.checkCapacity(configuration, total_real_particles))
+        {
+            packed_neighbor_storage.reallocate(configuration, total_real_particles);
+            searchNeighbors(contact_index);
+        }
+    }
+
+    if (neighbor_skin_ != nullptr)
+    {
+        refreshNeighbors(contact_index);
+    }
+}
+//=================================================================================================//
+void ContactRelation::refreshNeighbors(size_t contact_index)
+{
+    StdLargeVec<Vecd> &pos = base_particles_.pos_;
+    BaseParticles &contact_particles = contact_bodies_[contact_index]->getBaseParticles();
+    StdLargeVec<Vecd> &contact_pos = contact_particles.pos_;
+    StdLargeVec<Real> &contact_Vol = contact_particles.Vol_;
+    NeighborBuilderContactWithSkin &get_contact_neighbor = *get_contact_neighbors_with_skin_[contact_index];
+    ParticleConfiguration &configuration = contact_configuration_[contact_index];
+    particle_for(execution::ParallelPolicy(), IndexRange(0, base_particles_.total_real_particles_),
+                 [&](size_t index_i)
+                 {
+                     get_contact_neighbor.updateNeighborsWithinSkin(
+                         configuration[index_i], pos[index_i], contact_pos, contact_Vol);
+                 });
+}
+//=================================================================================================//
 void ContactRelation::updateConfiguration()
 {
-    resetNeighborhoodCurrentSize();
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), base_particles_.total_real_particles_, 0);
+    if (neighbor_skin_ == nullptr)
+    {
+        for (size_t k = 0; k != contact_bodies_.size(); ++k)
+        {
+            buildConfiguration(k);
+        }
+        return;
+    }
+
+    // all configurations are searched together as they share the recorded positions of this body
+    Real maximum_displacement = neighbor_skin_->MaximumDisplacement();
+    bool is_within_skin = true;
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
-        target_cell_linked_lists_[k]->searchNeighborsByParticles(
-            sph_body_, contact_configuration_[k],
-            *get_search_depths_[k], *get_contact_neighbors_[k]);
+        is_within_skin = is_within_skin &&
+                         maximum_displacement + contact_neighbor_skins_[k]->MaximumDisplacement() < skin_distance_;
+    }
+
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        if (is_within_skin)
+        {
+            refreshNeighbors(k);
+        }
+        else
+        {
+            buildConfiguration(k);
+            contact_neighbor_skins_[k]->recordSearch();
+        }
+    }
+
+    if (!is_within_skin)
+    {
+        neighbor_skin_->recordSearch();
     }
 }
 //=================================================================================================//
@@ -56,6 +204,7 @@ void SurfaceContactRelation::resetNeighborhoodCurrentSize()
 //=================================================================================================//
 void SurfaceContactRelation::updateConfiguration()
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), base_particles_.total_real_particles_, 0);
     resetNeighborhoodCurrentSize();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
@@ -79,6 +228,7 @@ ContactRelationToBodyPart::
 //=================================================================================================//
 void ContactRelationToBodyPart::updateConfiguration()
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), base_particles_.total_real_particles_, 0);
     resetNeighborhoodCurrentSize();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
@@ -93,7 +243,6 @@ AdaptiveContactRelation::AdaptiveContactRelation(SPHBody &sph_body, RealBodyVect
 {
     cell_linked_list_levels_.resize(contact_bodies_.size());
     get_multi_level_search_range_.resize(contact_bodies_.size());
-    get_contact_neighbors_adaptive_.resize(contact_bodies_.size());
 
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
@@ -105,26 +254,40 @@ AdaptiveContactRelation::AdaptiveContactRelation(SPHBody &sph_body, RealBodyVect
                 adaptive_search_depth_ptr_vector_keeper_
                     .createPtr<SearchDepthAdaptiveContact>(
                         sph_body_, cell_linked_list_levels_[k][l]));
-
-            get_contact_neighbors_adaptive_[k].push_back(
-                neighbor_builder_contact_adaptive_ptr_vector_keeper_
-                    .createPtr<NeighborBuilderContactAdaptive>(
-                        sph_body, *contact_sph_bodies[k]));
         }
     }
+    specializeKernel(true);
+}
+//=================================================================================================//
+void AdaptiveContactRelation::specializeKernel(bool is_specialized)
+{
+    dispatchKernelType(sph_body_.sph_adaptation_->getKernel(), is_specialized,
+                       [&](auto kernel_type_tag)
+                       {
+                           using KernelType = typename decltype(kernel_type_tag)::type;
+                           search_neighbors_ = &AdaptiveContactRelation::searchNeighborsByKernel<KernelType>;
+                       });
+}
+//=================================================================================================//
+template <class KernelType>
+void AdaptiveContactRelation::searchNeighborsByKernel(size_t contact_index)
+{
+    NeighborBuilderContactAdaptive<KernelType> get_contact_neighbor_adaptive(sph_body_, *contact_bodies_[contact_index]);
+    for (size_t l = 0; l != cell_linked_list_levels_[contact_index].size(); ++l)
+    {
+        cell_linked_list_levels_[contact_index][l]->searchNeighborsByParticles(
+            sph_body_, contact_configuration_[contact_index],
+            *get_multi_level_search_range_[contact_index][l], get_contact_neighbor_adaptive);
+    }
 }
 //=================================================================================================//
 void AdaptiveContactRelation::updateConfiguration()
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), base_particles_.total_real_particles_, 0);
     resetNeighborhoodCurrentSize();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
-        for (size_t l = 0; l != cell_linked_list_levels_[k].size(); ++l)
-        {
-            cell_linked_list_levels_[k][l]->searchNeighborsByParticles(
-                sph_body_, contact_configuration_[k],
-                *get_multi_level_search_range_[k][l], *get_contact_neighbors_adaptive_[k][l]);
-        }
+        (this->*search_neighbors_)(k);
     }
 }
 //=================================================================================================//
@@ -147,6 +310,7 @@ ContactRelationToShell::ContactRelationToShell(SPHBody &sph_body, RealBodyVector
 //=================================================================================================//
 void ContactRelationToShell::updateConfiguration()
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), base_particles_.total_real_particles_, 0);
     resetNeighborhoodCurrentSize();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
@@ -175,6 +339,7 @@ ContactRelationFromShell::ContactRelationFromShell(SPHBody &sph_body, RealBodyVe
 //=================================================================================================//
 void ContactRelationFromShell::updateConfiguration()
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), base_particles_.total_real_particles_, 0);
     resetNeighborhoodCurrentSize();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
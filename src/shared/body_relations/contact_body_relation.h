@@ -74,15 +74,46 @@ class ContactRelationCrossResolution : public BaseContactRelation
 class ContactRelation : public ContactRelationCrossResolution
 {
   protected:
-    UniquePtrsKeeper<NeighborBuilderContact> neighbor_builder_contact_ptrs_keeper_;
+    UniquePtrsKeeper<PackedNeighborStorage> packed_neighbor_storage_ptrs_keeper_;
+    UniquePtrsKeeper<NeighborBuilderContactWithSkin> neighbor_builder_with_skin_ptrs_keeper_;
+    UniquePtrsKeeper<SearchDepthWithSkin> search_depth_with_skin_ptrs_keeper_;
+    UniquePtrsKeeper<NeighborSkin> neighbor_skin_ptrs_keeper_;
 
   public:
     ContactRelation(SPHBody &sph_body, RealBodyVector contact_bodies);
     virtual ~ContactRelation(){};
+
+    /** store the configurations in contiguous blocks instead of per-particle arrays */
+    void usePackedNeighborStorage(Real reserve_ratio = 0.2);
+    /** see InnerRelation::specializeKernel, the kernel of each contact is given by NeighborBuilder::chooseKernel */
+    void specializeKernel(bool is_specialized);
+    /**
+     * Search contact neighbors within the cut-off radius plus a skin distance (Verlet list)
+     * and only search again when the displacements of the particles of both bodies add up beyond the skin.
+     * Otherwise, the neighbors within the cut-off radius are selected again from the searched ones.
+     * Note that the neighbors only within the skin are kept after current_size_ of the neighborhood.
+     */
+    void useVerletSkin(Real skin_distance);
+    /** the displacement tracker of the particles of this body, nullptr without Verlet skin */
+    NeighborSkin *getNeighborSkin() { return neighbor_skin_; };
     virtual void updateConfiguration() override;
 
   protected:
-    StdVec<NeighborBuilderContact *> get_contact_neighbors_;
+    /** the neighbor search within the cut-off radius, selected for the kernel type of each contact */
+    StdVec<void (ContactRelation::*)(size_t)> search_neighbors_within_cut_off_;
+    StdVec<PackedNeighborStorage *> packed_neighbor_storages_;
+    Real skin_distance_;
+    StdVec<SearchDepthWithSkin *> get_search_depths_with_skin_;
+    StdVec<NeighborBuilderContactWithSkin *> get_contact_neighbors_with_skin_;
+    NeighborSkin *neighbor_skin_;                     /**< for the particles of this body */
+    StdVec<NeighborSkin *> contact_neighbor_skins_; /**< for the particles of the contact bodies */
+
+    void searchNeighbors(size_t contact_index);
+    template <class KernelType>
+    void searchNeighborsByKernel(size_t contact_index);
+    void buildConfiguration(size_t contact_index);
+    /** select the neighbors within the cut-off radius and compute their kernel values for the present positions */
+    void refreshNeighbors(size_t contact_index);
 };
 
 /**
@@ -138,17 +169,23 @@ class AdaptiveContactRelation : public BaseContactRelation
 {
   private:
     UniquePtrsKeeper<SearchDepthAdaptiveContact> adaptive_search_depth_ptr_vector_keeper_;
-    UniquePtrsKeeper<NeighborBuilderContactAdaptive> neighbor_builder_contact_adaptive_ptr_vector_keeper_;
 
   protected:
     StdVec<StdVec<SearchDepthAdaptiveContact *>> get_multi_level_search_range_;
     StdVec<StdVec<CellLinkedList *>> cell_linked_list_levels_;
-    StdVec<StdVec<NeighborBuilderContactAdaptive *>> get_contact_neighbors_adaptive_;
+    /** the neighbor search on all levels, selected for the kernel type of the body */
+    void (AdaptiveContactRelation::*search_neighbors_)(size_t);
+
+    template <class KernelType>
+    void searchNeighborsByKernel(size_t contact_index);
 
   public:
     AdaptiveContactRelation(SPHBody &body, RealBodyVector contact_bodies);
     virtual ~AdaptiveContactRelation(){};
 
+    /** see InnerRelation::specializeKernel */
+    void specializeKernel(bool is_specialized);
+
     virtual void updateConfiguration() override;
 };
 
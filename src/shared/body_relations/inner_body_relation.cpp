@@ -2,27 +2,142 @@
 #include "base_particle_dynamics.h"
 #include "base_particles.hpp"
 #include "cell_linked_list.hpp"
+#include "neighborhood.hpp"
 
 #include "tree_body.h"
 namespace SPH
 {
 //=================================================================================================//
 InnerRelation::InnerRelation(RealBody &real_body)
-    : BaseInnerRelation(real_body), get_inner_neighbor_(real_body),
-      cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList())) {}
+    : BaseInnerRelation(real_body),
+      cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList())),
+      packed_neighbor_storage_(nullptr), skin_distance_(0.0),
+      get_search_depth_with_skin_(nullptr), get_inner_neighbor_with_skin_(nullptr),
+      neighbor_skin_(nullptr)
+{
+    specializeKernel(true);
+}
+//=================================================================================================//
+void InnerRelation::usePackedNeighborStorage(Real reserve_ratio)
+{
+    packed_neighbor_storage_ = packed_neighbor_storage_keeper_.createPtr<PackedNeighborStorage>(reserve_ratio);
+    packed_neighbor_storage_->reallocate(inner_configuration_, 0);
+}
+//=================================================================================================//
+void InnerRelation::useVerletSkin(Real skin_distance)
+{
+    skin_distance_ = skin_distance;
+    get_inner_neighbor_with_skin_ =
+        neighbor_builder_with_skin_keeper_.createPtr<NeighborBuilderInnerWithSkin>(sph_body_, skin_distance);
+    get_search_depth_with_skin_ = search_depth_with_skin_keeper_.createPtr<SearchDepthWithSkin>(
+        get_inner_neighbor_with_skin_->SearchRadius(), &cell_linked_list_);
+    neighbor_skin_ = neighbor_skin_keeper_.createPtr<NeighborSkin>(base_particles_);
+}
+//=================================================================================================//
+void InnerRelation::specializeKernel(bool is_specialized)
+{
+    dispatchKernelType(sph_body_.sph_adaptation_->getKernel(), is_specialized,
+                       [&](auto kernel_type_tag)
+                       {
+                           using KernelType = typename decltype(kernel_type_tag)::type;
+                           search_neighbors_within_cut_off_ = &InnerRelation::searchNeighborsByKernel<KernelType>;
+                       });
+}
+//=================================================================================================//
+template <class KernelType>
+void InnerRelation::searchNeighborsByKernel()
+{
+    NeighborBuilderInner<KernelType> get_inner_neighbor(sph_body_);
+    // no prefilter by the isotropic cut-off radius for the virtual kernel, which may be anisotropic
+    std::is_same<KernelType, Kernel>::value
+        ? cell_linked_list_.searchNeighborsByParticles(
+              sph_body_, inner_configuration_, get_single_search_depth_, get_inner_neighbor)
+        : cell_linked_list_.searchNeighborsByParticles(
+              sph_body_, inner_configuration_, get_single_search_depth_, get_inner_neighbor,
+              get_inner_neighbor.CutOffRadiusSqr());
+}
+//=================================================================================================//
+void InnerRelation::searchNeighbors()
+{
+    resetNeighborhoodCurrentSize();
+    neighbor_skin_ == nullptr
+        ? (this->*search_neighbors_within_cut_off_)()
+        : cell_linked_list_.searchNeighborsByParticles(
+              sph_body_, inner_configuration_,
+              *get_search_depth_with_skin_, *get_inner_neighbor_with_skin_,
+              get_inner_neighbor_with_skin_->SearchRadiusSqr());
+}
+//=================================================================================================//
+void InnerRelation::buildConfiguration()
+{
+    searchNeighbors();
+    if (packed_neighbor_storage_ != nullptr &&
+        !packed_neighbor_storage_->checkCapacity(inner_configuration_, base_particles_.total_real_particles_))
+    {
+        packed_neighbor_storage_->reallocate(inner_configuration_, base_particles_.total_real_particles_);
+        searchNeighbors();
+    }
+
+    if (neighbor_skin_ != nullptr)
+    {
+        refreshNeighbors();
+    }
+}
+//=================================================================================================//
+void InnerRelation::refreshNeighbors()
+{
+    StdLargeVec<Vecd> &pos = base_particles_.pos_;
+    StdLargeVec<Real> &Vol = base_particles_.Vol_;
+    particle_for(execution::ParallelPolicy(), IndexRange(0, base_particles_.total_real_particles_),
+                 [&](size_t index_i)
+                 {
+                     get_inner_neighbor_with_skin_->updateNeighborsWithinSkin(
+                         inner_configuration_[index_i], pos[index_i], pos, Vol);
+                 });
+}
 //=================================================================================================//
 void InnerRelation::updateConfiguration()
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), base_particles_.total_real_particles_, 0);
+    if (neighbor_skin_ == nullptr)
+    {
+        buildConfiguration();
+        return;
+    }
+
+    if (2.0 * neighbor_skin_->MaximumDisplacement() < skin_distance_)
+    {
+        refreshNeighbors();
+    }
+    else
+    {
+        buildConfiguration();
+        neighbor_skin_->recordSearch();
+    }
+}
+//=================================================================================================//
+SymmetricInnerRelation::SymmetricInnerRelation(RealBody &real_body)
+    : BaseInnerRelation(real_body), get_symmetric_inner_neighbor_(real_body),
+      cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList())) {}
+//=================================================================================================//
+void SymmetricInnerRelation::updateConfiguration()
+{
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), base_particles_.total_real_particles_, 0);
+    StdLargeVec<Real> &Vol = base_particles_.Vol_;
+    Vol_at_search_.resize(base_particles_.real_particles_bound_);
+    particle_for(execution::ParallelPolicy(), IndexRange(0, base_particles_.total_real_particles_),
+                 [&](size_t index_i)
+                 { Vol_at_search_[index_i] = Vol[index_i]; });
+
     resetNeighborhoodCurrentSize();
     cell_linked_list_.searchNeighborsByParticles(
         sph_body_, inner_configuration_,
-        get_single_search_depth_, get_inner_neighbor_);
+        get_single_search_depth_, get_symmetric_inner_neighbor_);
 }
 //=================================================================================================//
 AdaptiveInnerRelation::
     AdaptiveInnerRelation(RealBody &real_body)
-    : BaseInnerRelation(real_body), total_levels_(0),
-      get_adaptive_inner_neighbor_(real_body)
+    : BaseInnerRelation(real_body), total_levels_(0)
 {
     MultilevelCellLinkedList &multi_level_cell_linked_list =
         DynamicCast<MultilevelCellLinkedList>(this, real_body.getCellLinkedList());
@@ -34,19 +149,38 @@ AdaptiveInnerRelation::
             adaptive_search_depth_ptr_vector_keeper_
                 .createPtr<SearchDepthAdaptive>(real_body, cell_linked_list_levels_[l]));
     }
+    specializeKernel(true);
 }
 //=================================================================================================//
-void AdaptiveInnerRelation::updateConfiguration()
+void AdaptiveInnerRelation::specializeKernel(bool is_specialized)
 {
-    resetNeighborhoodCurrentSize();
+    dispatchKernelType(sph_body_.sph_adaptation_->getKernel(), is_specialized,
+                       [&](auto kernel_type_tag)
+                       {
+                           using KernelType = typename decltype(kernel_type_tag)::type;
+                           search_neighbors_ = &AdaptiveInnerRelation::searchNeighborsByKernel<KernelType>;
+                       });
+}
+//=================================================================================================//
+template <class KernelType>
+void AdaptiveInnerRelation::searchNeighborsByKernel()
+{
+    NeighborBuilderInnerAdaptive<KernelType> get_adaptive_inner_neighbor(sph_body_);
     for (size_t l = 0; l != total_levels_; ++l)
     {
         cell_linked_list_levels_[l]->searchNeighborsByParticles(
             sph_body_, inner_configuration_,
-            *get_multi_level_search_depth_[l], get_adaptive_inner_neighbor_);
+            *get_multi_level_search_depth_[l], get_adaptive_inner_neighbor);
     }
 }
 //=================================================================================================//
+void AdaptiveInnerRelation::updateConfiguration()
+{
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), base_particles_.total_real_particles_, 0);
+    resetNeighborhoodCurrentSize();
+    (this->*search_neighbors_)();
+}
+//=================================================================================================//
 SelfSurfaceContactRelation::
     SelfSurfaceContactRelation(RealBody &real_body)
     : BaseInnerRelation(real_body),
@@ -66,6 +200,7 @@ void SelfSurfaceContactRelation::resetNeighborhoodCurrentSize()
 //=================================================================================================//
 void SelfSurfaceContactRelation::updateConfiguration()
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), base_particles_.total_real_particles_, 0);
     resetNeighborhoodCurrentSize();
     cell_linked_list_.searchNeighborsByParticles(
         body_surface_layer_, inner_configuration_,
@@ -78,6 +213,7 @@ TreeInnerRelation::TreeInnerRelation(RealBody &real_body)
 //=================================================================================================//
 void TreeInnerRelation::updateConfiguration()
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), base_particles_.total_real_particles_, 0);
     generative_tree_.buildParticleConfiguration(inner_configuration_);
 }
 //=================================================================================================//
@@ -89,6 +225,7 @@ ShellInnerRelationWithContactKernel::ShellInnerRelationWithContactKernel(RealBod
 //=================================================================================================//
 void ShellInnerRelationWithContactKernel::updateConfiguration()
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), base_particles_.total_real_particles_, 0);
     resetNeighborhoodCurrentSize();
     cell_linked_list_.searchNeighborsByParticles(
         sph_body_, inner_configuration_,
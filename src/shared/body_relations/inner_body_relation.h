@@ -39,15 +39,77 @@ namespace SPH
  */
 class InnerRelation : public BaseInnerRelation
 {
+  private:
+    UniquePtrKeeper<PackedNeighborStorage> packed_neighbor_storage_keeper_;
+    UniquePtrKeeper<NeighborBuilderInnerWithSkin> neighbor_builder_with_skin_keeper_;
+    UniquePtrKeeper<SearchDepthWithSkin> search_depth_with_skin_keeper_;
+    UniquePtrKeeper<NeighborSkin> neighbor_skin_keeper_;
+
   protected:
     SearchDepthSingleResolution get_single_search_depth_;
-    NeighborBuilderInner get_inner_neighbor_;
     CellLinkedList &cell_linked_list_;
+    PackedNeighborStorage *packed_neighbor_storage_;
+    Real skin_distance_;
+    SearchDepthWithSkin *get_search_depth_with_skin_;
+    NeighborBuilderInnerWithSkin *get_inner_neighbor_with_skin_;
+    NeighborSkin *neighbor_skin_;
+    /** the neighbor search within the cut-off radius, selected for the kernel type of the body */
+    void (InnerRelation::*search_neighbors_within_cut_off_)();
+
+    void searchNeighbors();
+    template <class KernelType>
+    void searchNeighborsByKernel();
+    void buildConfiguration();
+    /** select the neighbors within the cut-off radius and compute their kernel values for the present positions */
+    void refreshNeighbors();
 
   public:
     explicit InnerRelation(RealBody &real_body);
     virtual ~InnerRelation(){};
 
+    /** store the configuration in one contiguous block instead of per-particle arrays */
+    void usePackedNeighborStorage(Real reserve_ratio = 0.2);
+    /**
+     * Whether the neighbor search calls the kernel functions through the concrete kernel type,
+     * which is the default for the kernels KernelWendlandC2, KernelCubicBSpline and their tabulated versions,
+     * or through the virtual interface of Kernel. Both give the same configuration.
+     */
+    void specializeKernel(bool is_specialized);
+    /**
+     * Search neighbors within the cut-off radius plus a skin distance (Verlet list)
+     * and only search again when particles have moved further than half the skin.
+     * Otherwise, the neighbors within the cut-off radius are selected again from the searched ones.
+     * Note that the neighbors only within the skin are kept after current_size_ of the neighborhood.
+     */
+    void useVerletSkin(Real skin_distance);
+    /** the displacement tracker of the particles of this body, nullptr without Verlet skin */
+    NeighborSkin *getNeighborSkin() { return neighbor_skin_; };
+    virtual void updateConfiguration() override;
+};
+
+/**
+ * @class SymmetricInnerRelation
+ * @brief The relation within a SPH body with each particle pair included only once,
+ * i.e. as the neighbor of the particle with smaller index (half neighbor list).
+ * It is used by local dynamics with Inner<Symmetric> interaction,
+ * which scatter the pair contributions to both particles within InteractionSymmetric.
+ * Note that periodic boundary conditions, which insert particle images into the
+ * cell linked list, are not supported as the image pairs would be updated concurrently.
+ */
+class SymmetricInnerRelation : public BaseInnerRelation
+{
+  protected:
+    SearchDepthSingleResolution get_single_search_depth_;
+    NeighborBuilderInnerSymmetric get_symmetric_inner_neighbor_;
+    CellLinkedList &cell_linked_list_;
+
+  public:
+    /** the volumes at the neighbor search, with which dW_ijV_i is obtained from dW_ijV_j */
+    StdLargeVec<Real> Vol_at_search_;
+
+    explicit SymmetricInnerRelation(RealBody &real_body);
+    virtual ~SymmetricInnerRelation(){};
+
     virtual void updateConfiguration() override;
 };
 
@@ -63,13 +125,20 @@ class AdaptiveInnerRelation : public BaseInnerRelation
   protected:
     size_t total_levels_;
     StdVec<SearchDepthAdaptive *> get_multi_level_search_depth_;
-    NeighborBuilderInnerAdaptive get_adaptive_inner_neighbor_;
     StdVec<CellLinkedList *> cell_linked_list_levels_;
+    /** the neighbor search on all levels, selected for the kernel type of the body */
+    void (AdaptiveInnerRelation::*search_neighbors_)();
+
+    template <class KernelType>
+    void searchNeighborsByKernel();
 
   public:
     explicit AdaptiveInnerRelation(RealBody &real_body);
     virtual ~AdaptiveInnerRelation(){};
 
+    /** see InnerRelation::specializeKernel */
+    void specializeKernel(bool is_specialized);
+
     virtual void updateConfiguration() override;
 };
 
@@ -73,6 +73,20 @@ using Real = double;
 using EigMat = Eigen::MatrixXd;
 #endif
 
+/**
+ * Precision of the kernel values and distances stored in the neighbor configurations.
+ * With SPHINXSYS_USE_FLOAT_NEIGHBOR, they are stored in float while Real is still double,
+ * so that less memory is loaded by the particle interactions.
+ * The option is experimental and off by default until its accuracy is confirmed by
+ * the regression tests. Positions and particle states are always stored in Real,
+ * separate precisions for them are not provided yet.
+ */
+#if SPHINXSYS_USE_FLOAT || SPHINXSYS_USE_FLOAT_NEIGHBOR
+using NeighborReal = float;
+#else
+using NeighborReal = double;
+#endif
+
 /** Vector with integers. */
 using Array2i = Eigen::Array<int, 2, 1>;
 using Array3i = Eigen::Array<int, 3, 1>;
@@ -0,0 +1,158 @@
+#include "dynamics_profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+//=================================================================================================//
+namespace SPH
+{
+//=================================================================================================//
+DynamicsProfiler &DynamicsProfiler::instance()
+{
+    static DynamicsProfiler dynamics_profiler;
+    return dynamics_profiler;
+}
+//=================================================================================================//
+DynamicsProfiler::DynamicsProfiler()
+    : start_(TickCount::now()), is_timeline_enabled_(false) {}
+//=================================================================================================//
+DynamicsProfiler::~DynamicsProfiler()
+{
+    if (!records_.empty())
+        writeReport(std::cout);
+    if (is_timeline_enabled_)
+        writeTimeline(timeline_filefullpath_);
+}
+//=================================================================================================//
+ProfileRecord &DynamicsProfiler::getRecord(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ProfileRecord &record = records_[name];
+    record.name_ = name;
+    return record;
+}
+//=================================================================================================//
+void DynamicsProfiler::addCall(ProfileRecord &record, TickCount start, TickCount end,
+                               size_t particles, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    record.calls_++;
+    record.seconds_ += (end - start).seconds();
+    record.particles_ += particles;
+    record.bytes_ += bytes;
+    if (is_timeline_enabled_)
+    {
+        auto thread_number = thread_numbers_.emplace(std::this_thread::get_id(), thread_numbers_.size());
+        timeline_events_.push_back({&record, thread_number.first->second,
+                                    (start - start_).seconds() * 1.0e6, (end - start).seconds() * 1.0e6});
+    }
+}
+//=================================================================================================//
+void DynamicsProfiler::enableTimeline(const std::string &filefullpath)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_timeline_enabled_ = true;
+    timeline_filefullpath_ = filefullpath;
+}
+//=================================================================================================//
+void DynamicsProfiler::writeReport(std::ostream &output)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    StdVec<const ProfileRecord *> sorted_records;
+    for (const auto &entry : records_)
+        sorted_records.push_back(&entry.second);
+    std::sort(sorted_records.begin(), sorted_records.end(),
+              [](const ProfileRecord *a, const ProfileRecord *b)
+              { return a->seconds_ > b->seconds_; });
+
+    output << "\n=============================== SPHinXsys profile ===============================\n"
+           << "(inclusive wall time, bytes are upper-bound estimates from the registered particle variables)\n"
+           << std::setw(10) << "calls" << std::setw(14) << "seconds" << std::setw(14) << "ms/call"
+           << std::setw(14) << "Mparticles/s" << std::setw(12) << "GB/s" << "  name\n";
+    for (const ProfileRecord *record : sorted_records)
+    {
+        Real seconds = SMAX(record->seconds_, Eps);
+        output << std::setw(10) << record->calls_
+               << std::setw(14) << std::fixed << std::setprecision(4) << record->seconds_
+               << std::setw(14) << std::setprecision(4) << 1.0e3 * record->seconds_ / Real(SMAX(record->calls_, size_t(1)))
+               << std::setw(14) << std::setprecision(2) << 1.0e-6 * Real(record->particles_) / seconds
+               << std::setw(12) << std::setprecision(2) << 1.0e-9 * Real(record->bytes_) / seconds
+               << "  " << record->name_ << "\n";
+    }
+    output << std::defaultfloat << std::endl;
+}
+//=================================================================================================//
+void DynamicsProfiler::writeTimeline(const std::string &filefullpath)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+    out_file << "{\"traceEvents\":[\n";
+    for (size_t n = 0; n != timeline_events_.size(); ++n)
+    {
+        const TimelineEvent &event = timeline_events_[n];
+        std::string name = event.record_->name_;
+        std::replace(name.begin(), name.end(), '"', '\'');
+        std::replace(name.begin(), name.end(), '\\', '/');
+        out_file << "{\"name\":\"" << name << "\",\"cat\":\"sphinxsys\",\"ph\":\"X\""
+                 << ",\"ts\":" << std::fixed << std::setprecision(3) << event.start_
+                 << ",\"dur\":" << event.duration_
+                 << ",\"pid\":0,\"tid\":" << event.thread_ << "}"
+                 << (n + 1 != timeline_events_.size() ? ",\n" : "\n");
+    }
+    out_file << "]}\n";
+    out_file.close();
+}
+//=================================================================================================//
+thread_local ProfileRecord *ScopedProfile::active_record_ = nullptr;
+//=================================================================================================//
+ScopedProfile::ScopedProfile(ProfileRecord &record, size_t particles, size_t bytes)
+    : record_(&record), enclosing_record_(active_record_),
+      particles_(particles), bytes_(bytes), start_(TickCount::now())
+{
+    active_record_ = record_;
+}
+//=================================================================================================//
+ScopedProfile::~ScopedProfile()
+{
+    active_record_ = enclosing_record_;
+    if (enclosing_record_ != record_)
+        DynamicsProfiler::instance().addCall(*record_, start_, TickCount::now(), particles_, bytes_);
+}
+//=================================================================================================//
+std::string profileTypeName(const std::type_info &type_info)
+{
+    std::string type_name = type_info.name();
+#ifdef __GNUG__
+    int status = 0;
+    char *demangled_name = abi::__cxa_demangle(type_info.name(), nullptr, nullptr, &status);
+    if (status == 0)
+        type_name = demangled_name;
+    std::free(demangled_name);
+#endif
+    for (const std::string &prefix : {std::string("class "), std::string("struct "), std::string("SPH::")})
+    {
+        for (size_t position = type_name.find(prefix); position != std::string::npos;
+             position = type_name.find(prefix, position))
+            type_name.erase(position, prefix.size());
+    }
+    return type_name;
+}
+//=================================================================================================//
+size_t particleDataBytes(ParticleData &particle_data)
+{
+    size_t bytes = 0;
+    std::apply([&](auto &...variables)
+               { ((bytes += variables.size() * sizeof(typename std::remove_pointer_t<
+                                                     typename std::decay_t<decltype(variables)>::value_type>::value_type)),
+                  ...); },
+               particle_data);
+    return bytes;
+}
+//=================================================================================================//
+} // namespace SPH
+//=================================================================================================//
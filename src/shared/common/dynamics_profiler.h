@@ -0,0 +1,148 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	dynamics_profiler.h
+ * @brief 	Timing instrumentation of particle dynamics, body relations,
+ * 			cell linked list updates and state recording.
+ * @details The instrumentation is compiled in only when SPHINXSYS_USE_PROFILING is on.
+ * 			Otherwise, the profiling macros expand to nothing and their arguments are not evaluated.
+ * 			For each named record, the number of calls, the wall time, the number of processed particles
+ * 			and an estimate of the bytes touched are accumulated and reported at program exit.
+ * 			A timeline of all calls in the Chrome trace format can be enabled optionally.
+ * @author	Xiangyu Hu
+ */
+#ifndef DYNAMICS_PROFILER_H
+#define DYNAMICS_PROFILER_H
+
+#include "sph_data_containers.h"
+
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <typeinfo>
+
+namespace SPH
+{
+/**
+ * @struct ProfileRecord
+ * @brief Accumulated costs of a named dynamics.
+ * The time is inclusive, i.e. including that of the nested records.
+ */
+struct ProfileRecord
+{
+    std::string name_;
+    size_t calls_ = 0;
+    double seconds_ = 0.0;
+    size_t particles_ = 0;
+    size_t bytes_ = 0;
+};
+
+/**
+ * @class DynamicsProfiler
+ * @brief The registry of all profile records.
+ * The report is written to the screen and the timeline, if enabled,
+ * to its file when the program exits.
+ */
+class DynamicsProfiler
+{
+    struct TimelineEvent
+    {
+        const ProfileRecord *record_;
+        size_t thread_;
+        double start_, duration_; /**< in microseconds from the profiler start */
+    };
+
+  public:
+    static DynamicsProfiler &instance();
+    ~DynamicsProfiler();
+    /** the record is created at the first request and its address does not change afterwards */
+    ProfileRecord &getRecord(const std::string &name);
+    void addCall(ProfileRecord &record, TickCount start, TickCount end, size_t particles, size_t bytes);
+    /** record every call and write the timeline in the Chrome trace format at program exit */
+    void enableTimeline(const std::string &filefullpath);
+    void writeReport(std::ostream &output);
+    void writeTimeline(const std::string &filefullpath);
+
+  private:
+    DynamicsProfiler();
+    std::mutex mutex_;
+    TickCount start_;
+    std::map<std::string, ProfileRecord> records_;
+    bool is_timeline_enabled_;
+    std::string timeline_filefullpath_;
+    StdVec<TimelineEvent> timeline_events_;
+    std::map<std::thread::id, size_t> thread_numbers_;
+};
+
+/**
+ * @class ProfileRecordHandle
+ * @brief The record of an instrumented object, found by its name at the first use.
+ */
+class ProfileRecordHandle
+{
+    ProfileRecord *record_ = nullptr;
+
+  public:
+    template <class NameFunction>
+    ProfileRecord &get(const NameFunction &name_function)
+    {
+        if (record_ == nullptr)
+            record_ = &DynamicsProfiler::instance().getRecord(name_function());
+        return *record_;
+    };
+};
+
+/**
+ * @class ScopedProfile
+ * @brief Accumulates the time of a scope to a record.
+ * A scope nested within a scope of the same record in the same thread is not counted,
+ * e.g. when the exec of a derived dynamics calls that of its base class.
+ */
+class ScopedProfile
+{
+  public:
+    ScopedProfile(ProfileRecord &record, size_t particles, size_t bytes);
+    ~ScopedProfile();
+
+  private:
+    static thread_local ProfileRecord *active_record_;
+    ProfileRecord *record_;
+    ProfileRecord *enclosing_record_;
+    size_t particles_, bytes_;
+    TickCount start_;
+};
+
+/** readable type name of an instrumented object without the namespace SPH */
+std::string profileTypeName(const std::type_info &type_info);
+/** bytes of all registered variables for a particle, as an upper bound for those touched by a dynamics */
+size_t particleDataBytes(ParticleData &particle_data);
+} // namespace SPH
+
+#if SPHINXSYS_USE_PROFILING
+#define SPHINXSYS_PROFILE_SCOPE(record, particles, bytes) \
+    SPH::ScopedProfile scoped_profile(record, particles, bytes)
+#else
+#define SPHINXSYS_PROFILE_SCOPE(record, particles, bytes)
+#endif
+#endif // DYNAMICS_PROFILER_H
@@ -64,6 +64,17 @@ using DataListsInCells = StdLargeVec<ListDataVector *>;
 using ConcurrentCellLists = ConcurrentVec<ConcurrentIndexVector *>;
 /** Cell list for splitting algorithms. */
 using SplitCellLists = StdVec<ConcurrentCellLists>;
+/**
+ * Split cell lists given by the ranges of the cells in contiguous cell lists,
+ * i.e. the particles of a cell are particle_indexes_[first, second) of its range.
+ * They are used instead of the split cell lists when built.
+ */
+struct ContiguousSplitCellLists
+{
+    bool is_built_ = false;
+    StdVec<StdLargeVec<ParticlesBound>> cell_ranges_;
+    const size_t *particle_indexes_ = nullptr;
+};
 /** Cell list for periodic boundary condition algorithms. */
 using CellLists = std::pair<ConcurrentCellLists, DataListsInCells>;
 
@@ -127,6 +127,19 @@ Vecd BinaryShapes::findClosestPoint(const Vecd &probe_point)
     return pnt_closest;
 }
 //=================================================================================================//
+bool BinaryShapes::writeGeometryFingerprint(std::ostream &output)
+{
+    writeBinaryValue(output, uint64_t(sub_shapes_and_ops_.size()));
+    for (auto &sub_shape_and_op : sub_shapes_and_ops_)
+    {
+        writeBinaryString(output, sub_shape_and_op.first->getName());
+        writeBinaryValue(output, sub_shape_and_op.second);
+        if (!sub_shape_and_op.first->writeGeometryFingerprint(output))
+            return false;
+    }
+    return true;
+}
+//=================================================================================================//
 SubShapeAndOp *BinaryShapes::getSubShapeAndOpByName(const std::string &name)
 {
     for (auto &sub_shape_and_op : sub_shapes_and_ops_)
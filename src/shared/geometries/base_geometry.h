@@ -32,6 +32,7 @@
 
 #include "base_data_package.h"
 #include "sph_data_containers.h"
+#include <ostream>
 #include <string>
 
 namespace SPH
@@ -78,9 +79,11 @@ class Shape
     bool checkNotFar(const Vecd &probe_point, Real threshold);
     bool checkNearSurface(const Vecd &probe_point, Real threshold);
     /** Signed distance is negative for point within the shape. */
-    Real findSignedDistance(const Vecd &probe_point);
+    virtual Real findSignedDistance(const Vecd &probe_point);
     /** Normal direction point toward outside of the shape. */
-    Vecd findNormalDirection(const Vecd &probe_point);
+    virtual Vecd findNormalDirection(const Vecd &probe_point);
+    /** Write the parameters defining the geometry in binary, return false if not available. */
+    virtual bool writeGeometryFingerprint(std::ostream &output) { return false; };
 
   protected:
     std::string name_;
@@ -89,6 +92,35 @@ class Shape
     virtual BoundingBox findBounds() = 0;
 };
 
+/**
+ * Shapes, such as BVH triangle mesh and level set shapes, which answer findSignedDistance and
+ * findNormalDirection by their own query, named by the type SignedDistanceQuery,
+ * rather than by checkContain and findClosestPoint.
+ * Shape wrappers forward these functions to the wrapped shape only for such shapes.
+ */
+template <typename T, typename = void>
+struct has_signed_distance_query : std::false_type
+{
+};
+
+template <typename T>
+struct has_signed_distance_query<T, std::void_t<typename T::SignedDistanceQuery>> : std::true_type
+{
+};
+
+/** write a trivially copyable value in binary, e.g. for the geometry fingerprint of a shape */
+template <typename DataType>
+void writeBinaryValue(std::ostream &output, const DataType &value)
+{
+    output.write(reinterpret_cast<const char *>(&value), sizeof(DataType));
+}
+/** write a string with its length ahead, so that consecutive strings are not ambiguous */
+inline void writeBinaryString(std::ostream &output, const std::string &value)
+{
+    writeBinaryValue(output, uint64_t(value.size()));
+    output.write(value.data(), value.size());
+}
+
 using SubShapeAndOp = std::pair<Shape *, ShapeBooleanOps>;
 /**
  * @class BinaryShapes
@@ -124,6 +156,7 @@ class BinaryShapes : public Shape
     virtual bool isValid() override;
     virtual bool checkContain(const Vecd &pnt, bool BOUNDARY_INCLUDED = true) override;
     virtual Vecd findClosestPoint(const Vecd &probe_point) override;
+    virtual bool writeGeometryFingerprint(std::ostream &output) override;
     Shape *getSubShapeByName(const std::string &name);
     SubShapeAndOp *getSubShapeAndOpByName(const std::string &name);
     size_t getSubShapeIndexByName(const std::string &name);
@@ -1,5 +1,10 @@
 #include "level_set.h"
 #include "adaptation.h"
+#include "base_particle_dynamics.h"
+#include "base_particles.h"
+
+#include "tbb/parallel_sort.h"
+#include <cstring>
 
 namespace SPH
 {
@@ -27,6 +32,29 @@ Real BaseLevelSet::CutCellVolumeFraction(Real phi, const Vecd &phi_gradient, Rea
     return volume_fraction;
 }
 //=================================================================================================//
+void BaseLevelSet::probeLevelSetBatch(const Vecd *positions, const Real *h_ratios, size_t size,
+                                      LevelSetProbe *probes, int probe_variables)
+{
+    parallel_for(
+        IndexRange(0, size),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                Real h_ratio = h_ratios == nullptr ? 1.0 : h_ratios[i];
+                if (probe_variables & ProbeSignedDistance)
+                    probes[i].phi_ = probeSignedDistance(positions[i]);
+                if (probe_variables & ProbeLevelSetGradient)
+                    probes[i].phi_gradient_ = probeLevelSetGradient(positions[i]);
+                if (probe_variables & ProbeKernelIntegral)
+                    probes[i].kernel_weight_ = probeKernelIntegral(positions[i], h_ratio);
+                if (probe_variables & ProbeKernelGradientIntegral)
+                    probes[i].kernel_gradient_ = probeKernelGradientIntegral(positions[i], h_ratio);
+            }
+        },
+        ap);
+}
+//=================================================================================================//
 LevelSet::LevelSet(BoundingBox tentative_bounds, Real data_spacing, size_t buffer_size,
                    Shape &shape, SPHAdaptation &sph_adaptation)
     : MeshWithGridDataPackages<GridDataPackage<4, 1>>(tentative_bounds, data_spacing, buffer_size),
@@ -108,6 +136,58 @@ Vecd LevelSet::probeKernelGradientIntegral(const Vecd &position, Real h_ratio)
     return probeMesh(kernel_gradient_, position);
 }
 //=================================================================================================//
+void LevelSet::probeLevelSetBatch(const Vecd *positions, const Real *h_ratios, size_t size,
+                                  LevelSetProbe *probes, int probe_variables)
+{
+    // sort the positions by the linear index of their cells so that
+    // the queries in the same data package are processed together
+    StdVec<std::pair<size_t, size_t>> cell_and_position(size);
+    parallel_for(
+        IndexRange(0, size),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                Arrayi cell_index = CellIndexFromPosition(positions[i]);
+                cell_and_position[i] = std::make_pair(transferMeshIndexTo1D(all_cells_, cell_index), i);
+            }
+        },
+        ap);
+    tbb::parallel_sort(cell_and_position.begin(), cell_and_position.end());
+
+    parallel_for(
+        IndexRange(0, size),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                size_t i = cell_and_position[n].second;
+                LevelSetDataPackage *data_pkg =
+                    DataPackageFromCellIndex(transfer1DtoMeshIndex(all_cells_, cell_and_position[n].first));
+                // singular packages have all data addresses pointing to the same value
+                Arrayi grid_index = Arrayi::Zero();
+                Vecd alpha = Vecd::Zero();
+                if (data_pkg->isInnerPackage())
+                    data_pkg->interpolationStencil(positions[i], grid_index, alpha);
+
+                LevelSetProbe &probe = probes[i];
+                if (probe_variables & ProbeSignedDistance)
+                    probe.phi_ = data_pkg->interpolateDataPackage(
+                        data_pkg->getPackageDataAddress(phi_), grid_index, alpha);
+                if (probe_variables & ProbeLevelSetGradient)
+                    probe.phi_gradient_ = data_pkg->interpolateDataPackage(
+                        data_pkg->getPackageDataAddress(phi_gradient_), grid_index, alpha);
+                if (probe_variables & ProbeKernelIntegral)
+                    probe.kernel_weight_ = data_pkg->interpolateDataPackage(
+                        data_pkg->getPackageDataAddress(kernel_weight_), grid_index, alpha);
+                if (probe_variables & ProbeKernelGradientIntegral)
+                    probe.kernel_gradient_ = data_pkg->interpolateDataPackage(
+                        data_pkg->getPackageDataAddress(kernel_gradient_), grid_index, alpha);
+            }
+        },
+        ap);
+}
+//=================================================================================================//
 void LevelSet::redistanceInterface()
 {
     package_parallel_for(
@@ -204,6 +284,196 @@ void LevelSet::tagACellIsInnerPackage(const Arrayi &cell_index)
     }
 }
 //=============================================================================================//
+void LevelSet::writeToBinaryCache(const std::string &filefullpath, uint64_t cache_key,
+                                  const StdVec<std::string> &operations)
+{
+    std::ostringstream payload(std::ios::binary);
+    auto write_value = [&](const auto &value)
+    { payload.write(reinterpret_cast<const char *>(&value), sizeof(value)); };
+
+    for (int l = 0; l != Dimensions; ++l)
+        write_value(uint64_t(all_cells_[l]));
+    write_value(uint64_t(operations.size()));
+    for (const std::string &operation : operations)
+    {
+        write_value(uint64_t(operation.size()));
+        payload.write(operation.data(), operation.size());
+    }
+
+    // cell states: 0 and 1 for the two singular packages, 2 for inner and 3 for core packages
+    size_t total_cells = all_cells_.prod();
+    StdVec<LevelSetDataPackage *> data_pkgs;
+    for (size_t n = 0; n != total_cells; ++n)
+    {
+        LevelSetDataPackage *data_pkg = DataPackageFromCellIndex(transfer1DtoMeshIndex(all_cells_, n));
+        int8_t cell_state = data_pkg == singular_data_pkgs_addrs_[0] ? 0 : 1;
+        if (data_pkg->isInnerPackage())
+        {
+            cell_state = data_pkg->isCorePackage() ? 3 : 2;
+            data_pkgs.push_back(data_pkg);
+        }
+        write_value(cell_state);
+    }
+
+    write_value(uint64_t(data_pkgs.size()));
+    for (LevelSetDataPackage *data_pkg : data_pkgs)
+    {
+        write_value(data_pkg->getPackageData(phi_));
+        write_value(data_pkg->getPackageData(near_interface_id_));
+        write_value(data_pkg->getPackageData(phi_gradient_));
+        write_value(data_pkg->getPackageData(kernel_weight_));
+        write_value(data_pkg->getPackageData(kernel_gradient_));
+    }
+
+    std::string payload_data = payload.str();
+    std::ofstream out_file(filefullpath, std::ios::binary | std::ios::trunc);
+    const char format_name[8] = "SPHXLVS";
+    uint64_t header[4] = {LevelSetCacheVersion, cache_key, uint64_t(payload_data.size()),
+                          binaryDataChecksum(payload_data.data(), payload_data.size())};
+    out_file.write(format_name, sizeof(format_name));
+    out_file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    out_file.write(payload_data.data(), payload_data.size());
+    if (!out_file.good())
+    {
+        std::cout << "\n Error: failed in writing the level set cache file " << filefullpath << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=============================================================================================//
+bool LevelSet::readFromBinaryCache(const std::string &filefullpath, uint64_t cache_key,
+                                   StdVec<std::string> &operations)
+{
+    std::ifstream in_file(filefullpath, std::ios::binary);
+    std::string file_data((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+
+    const size_t header_size = 8 + 4 * sizeof(uint64_t);
+    uint64_t header[4] = {0, 0, 0, 0};
+    if (file_data.size() >= header_size)
+        std::memcpy(header, file_data.data() + 8, sizeof(header));
+    if (file_data.size() < header_size || std::string(file_data.data(), 7) != "SPHXLVS" ||
+        header[0] != LevelSetCacheVersion || header[1] != cache_key ||
+        header[2] != file_data.size() - header_size ||
+        header[3] != binaryDataChecksum(file_data.data() + header_size, header[2]))
+    {
+        std::cout << "\n Level set cache file " << filefullpath << " is invalid and will be rebuilt." << std::endl;
+        return false;
+    }
+
+    const char *cursor = file_data.data() + header_size;
+    const char *end = file_data.data() + file_data.size();
+    bool is_valid = true;
+    auto read_value = [&](auto &value)
+    {
+        is_valid = is_valid && size_t(end - cursor) >= sizeof(value);
+        if (is_valid)
+        {
+            std::memcpy(&value, cursor, sizeof(value));
+            cursor += sizeof(value);
+        }
+    };
+
+    for (int l = 0; l != Dimensions; ++l)
+    {
+        uint64_t cells = 0;
+        read_value(cells);
+        is_valid = is_valid && cells == uint64_t(all_cells_[l]);
+    }
+    uint64_t number_of_operations = 0;
+    read_value(number_of_operations);
+    StdVec<std::string> cached_operations;
+    for (size_t n = 0; is_valid && n != number_of_operations; ++n)
+    {
+        uint64_t operation_size = 0;
+        read_value(operation_size);
+        is_valid = is_valid && size_t(end - cursor) >= operation_size;
+        if (is_valid)
+        {
+            cached_operations.emplace_back(cursor, operation_size);
+            cursor += operation_size;
+        }
+    }
+
+    size_t total_cells = all_cells_.prod();
+    is_valid = is_valid && size_t(end - cursor) >= total_cells;
+    const int8_t *cell_states = reinterpret_cast<const int8_t *>(cursor);
+    StdVec<size_t> package_cells;
+    for (size_t n = 0; is_valid && n != total_cells; ++n)
+    {
+        if (cell_states[n] > 1)
+            package_cells.push_back(n);
+    }
+    cursor += is_valid ? total_cells : 0;
+
+    uint64_t number_of_packages = 0;
+    read_value(number_of_packages);
+    const size_t package_size = 2 * sizeof(LevelSetDataPackage::PackageData<Real>) +
+                                sizeof(LevelSetDataPackage::PackageData<int>) +
+                                2 * sizeof(LevelSetDataPackage::PackageData<Vecd>);
+    if (!is_valid || number_of_packages != package_cells.size() ||
+        size_t(end - cursor) != number_of_packages * package_size)
+    {
+        std::cout << "\n Level set cache file " << filefullpath << " is inconsistent with the mesh and will be rebuilt." << std::endl;
+        return false;
+    }
+
+    for (size_t n = 0; n != total_cells; ++n)
+    {
+        if (cell_states[n] < 2)
+            assignDataPackageAddress(transfer1DtoMeshIndex(all_cells_, n), singular_data_pkgs_addrs_[cell_states[n]]);
+    }
+
+    parallel_for(
+        IndexRange(0, package_cells.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                const char *package_data = cursor + n * package_size;
+                auto copy_package_data = [&](auto &data)
+                {
+                    std::memcpy(&data, package_data, sizeof(data));
+                    package_data += sizeof(data);
+                };
+                LevelSetDataPackage *new_data_pkg = createDataPackage(
+                    all_mesh_variables_, transfer1DtoMeshIndex(all_cells_, package_cells[n]),
+                    [&](LevelSetDataPackage *new_data_pkg)
+                    {
+                        copy_package_data(new_data_pkg->getPackageData(phi_));
+                        copy_package_data(new_data_pkg->getPackageData(near_interface_id_));
+                        copy_package_data(new_data_pkg->getPackageData(phi_gradient_));
+                        copy_package_data(new_data_pkg->getPackageData(kernel_weight_));
+                        copy_package_data(new_data_pkg->getPackageData(kernel_gradient_));
+                    });
+                if (cell_states[package_cells[n]] == 3)
+                {
+                    new_data_pkg->setCorePackage();
+                    core_data_pkgs_.push_back(new_data_pkg);
+                }
+                else
+                {
+                    new_data_pkg->setInnerPackage();
+                }
+                inner_data_pkgs_.push_back(new_data_pkg);
+            }
+        },
+        ap);
+
+    parallel_for(
+        IndexRange(0, total_cells),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                initializePackageAddressesInACell(transfer1DtoMeshIndex(all_cells_, n));
+            }
+        },
+        ap);
+
+    operations = cached_operations;
+    return true;
+}
+//=============================================================================================//
 Real LevelSet::upwindDifference(Real sign, Real df_p, Real df_n)
 {
     if (sign * df_p >= 0.0 && sign * df_n >= 0.0)
@@ -35,6 +35,31 @@
 
 namespace SPH
 {
+/** version of the binary level set cache format */
+constexpr uint64_t LevelSetCacheVersion = 1;
+
+/** variables interpolated in a batched probing of level set */
+enum LevelSetProbeVariable
+{
+    ProbeSignedDistance = 1,
+    ProbeLevelSetGradient = 2,
+    ProbeKernelIntegral = 4,
+    ProbeKernelGradientIntegral = 8
+};
+
+/**
+ * @struct LevelSetProbe
+ * @brief Level set variables probed at a position.
+ * Only the variables requested in a batched probing are set.
+ */
+struct LevelSetProbe
+{
+    Real phi_;
+    Vecd phi_gradient_;
+    Real kernel_weight_;
+    Vecd kernel_gradient_;
+};
+
 /**
  * @class BaseLevelSet
  * @brief A abstract describes a level set field defined on a mesh.
@@ -55,6 +80,10 @@ class BaseLevelSet : public BaseMeshField
     virtual Vecd probeLevelSetGradient(const Vecd &position) = 0;
     virtual Real probeKernelIntegral(const Vecd &position, Real h_ratio = 1.0) = 0;
     virtual Vecd probeKernelGradientIntegral(const Vecd &position, Real h_ratio = 1.0) = 0;
+    /** probe the variables given by the LevelSetProbeVariable bits at a batch of positions.
+     *  h_ratios can be nullptr for the unit ratio. */
+    virtual void probeLevelSetBatch(const Vecd *positions, const Real *h_ratios, size_t size,
+                                    LevelSetProbe *probes, int probe_variables);
 
   protected:
     Shape &shape_; /**< the geometry is described by the level set. */
@@ -96,10 +125,21 @@ class LevelSet : public MeshWithGridDataPackages<GridDataPackage<4, 1>>,
     virtual Vecd probeLevelSetGradient(const Vecd &position) override;
     virtual Real probeKernelIntegral(const Vecd &position, Real h_ratio = 1.0) override;
     virtual Vecd probeKernelGradientIntegral(const Vecd &position, Real h_ratio = 1.0) override;
+    /** The positions are grouped by data packages so that the package
+     *  and the interpolation stencil are found once for all probed variables. */
+    virtual void probeLevelSetBatch(const Vecd *positions, const Real *h_ratios, size_t size,
+                                    LevelSetProbe *probes, int probe_variables) override;
     virtual void writeMeshFieldToPlt(std::ofstream &output_file) override;
     bool isWithinCorePackage(Vecd position);
     Real computeKernelIntegral(const Vecd &position);
     Vecd computeKernelGradientIntegral(const Vecd &position);
+    /** write all data packages and the operations applied on them to a binary cache file. */
+    void writeToBinaryCache(const std::string &filefullpath, uint64_t cache_key,
+                            const StdVec<std::string> &operations);
+    /** fill the level set constructed with far field only by the data packages from a binary cache file.
+     *  Return false without changing the level set if the file is not a valid cache of the given key. */
+    bool readFromBinaryCache(const std::string &filefullpath, uint64_t cache_key,
+                             StdVec<std::string> &operations);
 
   protected:
     MeshVariable<Real> &phi_;
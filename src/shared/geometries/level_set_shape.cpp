@@ -1,6 +1,7 @@
 #include "level_set_shape.h"
 
 #include "base_body.h"
+#include "base_particles.h"
 #include "io_all.h"
 #include "sph_system.h"
 
@@ -9,52 +10,199 @@ namespace SPH
 //=================================================================================================//
 LevelSetShape::
     LevelSetShape(Shape &shape, SharedPtr<SPHAdaptation> sph_adaptation, Real refinement_ratio)
-    : Shape(shape.getName()), sph_adaptation_(sph_adaptation),
+    : Shape(shape.getName()), sph_adaptation_(sph_adaptation), cache_key_(0),
+      is_loaded_from_cache_(false), is_operation_checked_(false),
       level_set_(*level_set_keeper_.movePtr(sph_adaptation->createLevelSet(shape, refinement_ratio)))
 {
     bounding_box_ = shape.getBounds();
     is_bounds_found_ = true;
 }
 //=================================================================================================//
-LevelSetShape::LevelSetShape(SPHBody &sph_body, Shape &shape, Real refinement_ratio)
+LevelSetShape::LevelSetShape(SPHBody &sph_body, Shape &shape, Real refinement_ratio, bool use_level_set_cache)
     : Shape(shape.getName()),
-      level_set_(*level_set_keeper_.movePtr(
-          sph_body.sph_adaptation_->createLevelSet(shape, refinement_ratio)))
+      cache_folder_(use_level_set_cache ? sph_body.getSPHSystem().getIOEnvironment().reload_folder_ : ""),
+      cache_key_(0), is_loaded_from_cache_(false), is_operation_checked_(false),
+      level_set_(*level_set_keeper_.movePtr(createLevelSet(shape, *sph_body.sph_adaptation_, refinement_ratio)))
 {
     bounding_box_ = shape.getBounds();
     is_bounds_found_ = true;
+    if (!cache_filefullpath_.empty() && !is_loaded_from_cache_)
+        writeLevelSetCache();
+}
+//=================================================================================================//
+UniquePtr<BaseLevelSet> LevelSetShape::
+    createLevelSet(Shape &shape, SPHAdaptation &sph_adaptation, Real refinement_ratio)
+{
+    if (!cache_folder_.empty())
+    {
+        if (dynamic_cast<ParticleWithLocalRefinement *>(&sph_adaptation) != nullptr)
+        {
+            std::cout << "\n Warning: level set cache is not supported for multi-resolution, "
+                      << "the level set of " << shape.getName() << " is not cached." << std::endl;
+            return sph_adaptation.createLevelSet(shape, refinement_ratio);
+        }
+
+        // the same spacing as the finest level set given by SPHAdaptation::createLevelSet
+        Real data_spacing = sph_adaptation.ReferenceSpacing() / refinement_ratio;
+        if (!computeCacheKey(shape, sph_adaptation, data_spacing))
+        {
+            std::cout << "\n Warning: level set cache is not supported for shapes without geometry fingerprint, "
+                      << "the level set of " << shape.getName() << " is not cached." << std::endl;
+            return sph_adaptation.createLevelSet(shape, refinement_ratio);
+        }
+        std::stringstream cache_filename;
+        cache_filename << "LevelSet_" << shape.getName() << "_" << std::hex << cache_key_ << ".bin";
+        cache_filefullpath_ = cache_folder_ + "/" + cache_filename.str();
+
+        if (fs::exists(cache_filefullpath_))
+        {
+            UniquePtr<LevelSet> level_set = makeUnique<LevelSet>(shape.getBounds(), data_spacing, 4, shape, sph_adaptation);
+            if (level_set->readFromBinaryCache(cache_filefullpath_, cache_key_, cached_operations_))
+            {
+                is_loaded_from_cache_ = true;
+                return level_set;
+            }
+        }
+    }
+    return sph_adaptation.createLevelSet(shape, refinement_ratio);
+}
+//=================================================================================================//
+bool LevelSetShape::computeCacheKey(Shape &shape, SPHAdaptation &sph_adaptation, Real data_spacing)
+{
+    std::ostringstream geometry_data(std::ios::binary);
+    if (!shape.writeGeometryFingerprint(geometry_data))
+        return false;
+
+    std::ostringstream key_data(std::ios::binary);
+    auto write_value = [&](const auto &value)
+    { key_data.write(reinterpret_cast<const char *>(&value), sizeof(value)); };
+
+    Kernel &kernel = *sph_adaptation.getKernel();
+    BoundingBox bounds = shape.getBounds();
+    key_data << shape.getName() << kernel.Name();
+    write_value(Dimensions);
+    write_value(data_spacing);
+    write_value(sph_adaptation.ReferenceSpacing());
+    write_value(kernel.CutOffRadius());
+    write_value(bounds.first_);
+    write_value(bounds.second_);
+    key_data << geometry_data.str();
+
+    std::string key_string = key_data.str();
+    cache_key_ = binaryDataChecksum(key_string.data(), key_string.size());
+    return true;
+}
+//=================================================================================================//
+bool LevelSetShape::isCachedOperation(const std::string &operation_name, Real small_shift_factor)
+{
+    applied_operations_.push_back(operation_name + "(" + std::to_string(small_shift_factor) + ")");
+    if (is_loaded_from_cache_)
+    {
+        size_t index = applied_operations_.size() - 1;
+        if (index < cached_operations_.size())
+        {
+            if (cached_operations_[index] != applied_operations_.back())
+                reportUnappliedCachedOperations();
+            return true;
+        }
+
+        std::cout << "\n Warning: " << applied_operations_.back() << " of " << getName()
+                  << " is not found in the level set cache and is applied on the cached level set." << std::endl;
+        is_loaded_from_cache_ = false;
+    }
+    return false;
+}
+//=================================================================================================//
+void LevelSetShape::reportUnappliedCachedOperations()
+{
+    std::cout << "\n Error: the level set cache of " << getName() << " contains the operations";
+    for (const std::string &operation : cached_operations_)
+        std::cout << " " << operation;
+    std::cout << ", but the operations";
+    for (const std::string &operation : applied_operations_)
+        std::cout << " " << operation;
+    std::cout << " are applied. The cache file " << cache_filefullpath_
+              << " is deleted and will be rebuilt in the next run." << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    fs::remove(cache_filefullpath_);
+    exit(1);
+}
+//=================================================================================================//
+void LevelSetShape::checkCachedOperations()
+{
+    // the construction is finished with the operations applied before the first probing
+    if (is_loaded_from_cache_ && applied_operations_.size() != cached_operations_.size())
+        reportUnappliedCachedOperations();
+    is_operation_checked_ = true;
+}
+//=================================================================================================//
+void LevelSetShape::writeLevelSetCache()
+{
+    std::string filefullpath_tmp = cache_filefullpath_ + ".tmp";
+    DynamicCast<LevelSet>(this, &level_set_)->writeToBinaryCache(filefullpath_tmp, cache_key_, applied_operations_);
+    fs::rename(filefullpath_tmp, cache_filefullpath_);
 }
 //=================================================================================================//
 void LevelSetShape::writeLevelSet(SPHSystem &sph_system)
 {
+    if (!is_operation_checked_)
+        checkCachedOperations();
     MeshRecordingToPlt write_level_set_to_plt(sph_system, level_set_);
     write_level_set_to_plt.writeToFile(0);
 }
 //=================================================================================================//
 LevelSetShape *LevelSetShape::cleanLevelSet(Real small_shift_factor)
 {
-    level_set_.cleanInterface(small_shift_factor);
+    if (!isCachedOperation("cleanLevelSet", small_shift_factor))
+    {
+        level_set_.cleanInterface(small_shift_factor);
+        if (!cache_filefullpath_.empty())
+            writeLevelSetCache();
+    }
     return this;
 }
 //=================================================================================================//
 LevelSetShape *LevelSetShape::correctLevelSetSign(Real small_shift_factor)
 {
-    level_set_.correctTopology(small_shift_factor);
+    if (!isCachedOperation("correctLevelSetSign", small_shift_factor))
+    {
+        level_set_.correctTopology(small_shift_factor);
+        if (!cache_filefullpath_.empty())
+            writeLevelSetCache();
+    }
     return this;
 }
 //=================================================================================================//
 bool LevelSetShape::checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED)
 {
+    if (!is_operation_checked_)
+        checkCachedOperations();
     return level_set_.probeSignedDistance(probe_point) < 0.0 ? true : false;
 }
 //=================================================================================================//
 Vecd LevelSetShape::findClosestPoint(const Vecd &probe_point)
 {
+    if (!is_operation_checked_)
+        checkCachedOperations();
     Real phi = level_set_.probeSignedDistance(probe_point);
     Vecd normal = level_set_.probeNormalDirection(probe_point);
     return probe_point - phi * normal;
 }
 //=================================================================================================//
+Real LevelSetShape::findSignedDistance(const Vecd &probe_point)
+{
+    if (!is_operation_checked_)
+        checkCachedOperations();
+    return level_set_.probeSignedDistance(probe_point);
+}
+//=================================================================================================//
+Vecd LevelSetShape::findNormalDirection(const Vecd &probe_point)
+{
+    if (!is_operation_checked_)
+        checkCachedOperations();
+    return level_set_.probeNormalDirection(probe_point);
+}
+//=================================================================================================//
 BoundingBox LevelSetShape::findBounds()
 {
     if (!is_bounds_found_)
@@ -68,17 +216,31 @@ BoundingBox LevelSetShape::findBounds()
 //=================================================================================================//
 Vecd LevelSetShape::findLevelSetGradient(const Vecd &probe_point)
 {
+    if (!is_operation_checked_)
+        checkCachedOperations();
     return level_set_.probeLevelSetGradient(probe_point);
 }
 //=================================================================================================//
 Real LevelSetShape::computeKernelIntegral(const Vecd &probe_point, Real h_ratio)
 {
+    if (!is_operation_checked_)
+        checkCachedOperations();
     return level_set_.probeKernelIntegral(probe_point, h_ratio);
 }
 //=================================================================================================//
 Vecd LevelSetShape::computeKernelGradientIntegral(const Vecd &probe_point, Real h_ratio)
 {
+    if (!is_operation_checked_)
+        checkCachedOperations();
     return level_set_.probeKernelGradientIntegral(probe_point, h_ratio);
 }
 //=================================================================================================//
+void LevelSetShape::probeLevelSet(const Vecd *probe_points, const Real *h_ratios, size_t size,
+                                  LevelSetProbe *probes, int probe_variables)
+{
+    if (!is_operation_checked_)
+        checkCachedOperations();
+    level_set_.probeLevelSetBatch(probe_points, h_ratios, size, probes, probe_variables);
+}
+//=================================================================================================//
 } // namespace SPH
@@ -32,6 +32,7 @@
 #include "base_geometry.h"
 #include "level_set.h"
 
+#include <atomic>
 #include <string>
 
 namespace SPH
@@ -46,25 +47,55 @@ class LevelSetShape : public Shape
   private:
     UniquePtrKeeper<BaseLevelSet> level_set_keeper_;
     SharedPtr<SPHAdaptation> sph_adaptation_;
+    std::string cache_folder_;                 /**< empty if the level set cache is not used */
+    std::string cache_filefullpath_;           /**< cache file named by the cache key */
+    uint64_t cache_key_;                       /**< hash of the geometry, bounds, spacing and kernel */
+    bool is_loaded_from_cache_;                /**< the level set data are given by the cache file */
+    std::atomic<bool> is_operation_checked_;   /**< the applied operations are checked against the cached ones */
+    StdVec<std::string> cached_operations_;    /**< cleaning and correcting operations in the cache file */
+    StdVec<std::string> applied_operations_;   /**< cleaning and correcting operations applied so far */
+
+    UniquePtr<BaseLevelSet> createLevelSet(Shape &shape, SPHAdaptation &sph_adaptation, Real refinement_ratio);
+    /** compute the cache key, return false if the shape has no geometry fingerprint */
+    bool computeCacheKey(Shape &shape, SPHAdaptation &sph_adaptation, Real data_spacing);
+    /** register an operation, return true if it has been applied in the cached level set already */
+    bool isCachedOperation(const std::string &operation_name, Real small_shift_factor);
+    /** check at the first probing that all the cached operations have been applied */
+    void checkCachedOperations();
+    void reportUnappliedCachedOperations();
+    void writeLevelSetCache();
 
   public:
+    using SignedDistanceQuery = BaseLevelSet;
+
     /** refinement_ratio is between body reference resolution and level set resolution */
     LevelSetShape(Shape &shape, SharedPtr<SPHAdaptation> sph_adaptation, Real refinement_ratio = 1.0);
-    LevelSetShape(SPHBody &sph_body, Shape &shape, Real refinement_ratio = 1.0);
+    /** With use_level_set_cache, the level set, after cleaning and correcting, is saved in the reload folder
+     *  and loaded directly in later runs with the same shape, bounds, spacing and kernel.
+     *  The cache is for single resolution and shapes with geometry fingerprint only.
+     *  The operations applied before the first probing of the level set should be those in the cache,
+     *  otherwise the cache file is deleted and the program exits. */
+    LevelSetShape(SPHBody &sph_body, Shape &shape, Real refinement_ratio = 1.0, bool use_level_set_cache = false);
 
     virtual ~LevelSetShape(){};
 
     virtual bool checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED = true) override;
     virtual Vecd findClosestPoint(const Vecd &probe_point) override;
+    virtual Real findSignedDistance(const Vecd &probe_point) override;
+    virtual Vecd findNormalDirection(const Vecd &probe_point) override;
 
     Vecd findLevelSetGradient(const Vecd &probe_point);
     Real computeKernelIntegral(const Vecd &probe_point, Real h_ratio = 1.0);
     Vecd computeKernelGradientIntegral(const Vecd &probe_point, Real h_ratio = 1.0);
+    /** batched probing of the variables given by the LevelSetProbeVariable bits, h_ratios can be nullptr. */
+    void probeLevelSet(const Vecd *probe_points, const Real *h_ratios, size_t size,
+                       LevelSetProbe *probes, int probe_variables);
     /** small_shift_factor = 1.0 by default, can be increased for difficult geometries for smoothing */
     LevelSetShape *cleanLevelSet(Real small_shift_factor = 1.0);
     /** required to build level set from triangular mesh in stl file format. */
     LevelSetShape *correctLevelSetSign(Real small_shift_factor = 1.0);
     void writeLevelSet(SPHSystem &sph_system);
+    bool isLoadedFromCache() { return is_loaded_from_cache_; };
 
   protected:
     BaseLevelSet &level_set_; /**< narrow bounded level set mesh. */
@@ -57,6 +57,22 @@ class InverseShape : public BaseShapeType
     {
         return !BaseShapeType::checkContain(probe_point);
     };
+
+    /** Forwarded only to shapes with their own query, as Shape::findSignedDistance
+     *  already uses the inverted checkContain above. */
+    virtual Real findSignedDistance(const Vecd &probe_point) override
+    {
+        if constexpr (has_signed_distance_query<BaseShapeType>::value)
+            return -BaseShapeType::findSignedDistance(probe_point);
+        return Shape::findSignedDistance(probe_point);
+    };
+
+    virtual Vecd findNormalDirection(const Vecd &probe_point) override
+    {
+        if constexpr (has_signed_distance_query<BaseShapeType>::value)
+            return -BaseShapeType::findNormalDirection(probe_point);
+        return Shape::findNormalDirection(probe_point);
+    };
 };
 
 /**
@@ -102,6 +118,15 @@ class ExtrudeShape : public BaseShapeType
         closest_point += BaseShapeType::checkContain(probe_point) ? shift : -shift;
         return closest_point;
     };
+
+    /** Forwarded only to shapes with their own query, as Shape::findSignedDistance
+     *  already uses the extruded closest point above. */
+    virtual Real findSignedDistance(const Vecd &probe_point) override
+    {
+        if constexpr (has_signed_distance_query<BaseShapeType>::value)
+            return BaseShapeType::findSignedDistance(probe_point) - thickness_;
+        return Shape::findSignedDistance(probe_point);
+    };
 };
 } // namespace SPH
 
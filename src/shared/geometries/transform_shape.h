@@ -69,6 +69,36 @@ class TransformShape : public BaseShapeType
         return transform_.shiftFrameStationToBase(closest_point_origin);
     };
 
+    /** Forwarded only to shapes with their own query, as Shape::findSignedDistance
+     *  already transforms the probe point by checkContain and findClosestPoint above. */
+    virtual Real findSignedDistance(const Vecd &probe_point) override
+    {
+        if constexpr (has_signed_distance_query<BaseShapeType>::value)
+        {
+            Vecd input_pnt_origin = transform_.shiftBaseStationToFrame(probe_point);
+            return BaseShapeType::findSignedDistance(input_pnt_origin);
+        }
+        return Shape::findSignedDistance(probe_point);
+    };
+
+    virtual Vecd findNormalDirection(const Vecd &probe_point) override
+    {
+        if constexpr (has_signed_distance_query<BaseShapeType>::value)
+        {
+            Vecd input_pnt_origin = transform_.shiftBaseStationToFrame(probe_point);
+            return transform_.xformFrameVecToBase(BaseShapeType::findNormalDirection(input_pnt_origin));
+        }
+        return Shape::findNormalDirection(probe_point);
+    };
+
+    virtual bool writeGeometryFingerprint(std::ostream &output) override
+    {
+        writeBinaryValue(output, transform_.shiftFrameStationToBase(Vecd::Zero()));
+        for (int i = 0; i != Dimensions; ++i)
+            writeBinaryValue(output, transform_.xformFrameVecToBase(Vecd(Vecd::Unit(i))));
+        return BaseShapeType::writeGeometryFingerprint(output);
+    };
+
   protected:
     Transform transform_;
 
@@ -40,6 +40,7 @@
 #include "io_all.h"
 #include "parameterization.h"
 #include "all_regression_test_methods.h"
+#include "multi_rate_time_stepping.h"
 #include "sph_system.h"
 
 #endif // SPHINXSYS_H
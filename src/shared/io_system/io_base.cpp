@@ -11,6 +11,23 @@
 namespace SPH
 {
 //=============================================================================================//
+std::string selectBinaryOrXmlFile(const std::string &binary_filefullpath, const std::string &xml_filefullpath)
+{
+    bool has_binary_file = fs::exists(binary_filefullpath);
+    bool has_xml_file = fs::exists(xml_filefullpath);
+    if (has_binary_file && has_xml_file)
+    {
+        return fs::last_write_time(binary_filefullpath) >= fs::last_write_time(xml_filefullpath)
+                   ? binary_filefullpath
+                   : xml_filefullpath;
+    }
+    if (has_binary_file)
+        return binary_filefullpath;
+    if (has_xml_file)
+        return xml_filefullpath;
+    return std::string();
+}
+//=============================================================================================//
 BaseIO::BaseIO(SPHSystem &sph_system)
     : sph_system_(sph_system), io_environment_(sph_system.getIOEnvironment()) {}
 //=============================================================================================//
@@ -29,17 +46,36 @@ BodyStatesRecording::BodyStatesRecording(SPHBody &body)
 //=============================================================================================//
 void BodyStatesRecording::writeToFile()
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), totalRecordedParticles(), 0);
     writeWithFileName(convertPhysicalTimeToString(GlobalStaticVariables::physical_time_));
 }
 //=============================================================================================//
 void BodyStatesRecording::writeToFile(size_t iteration_step)
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), totalRecordedParticles(), 0);
     writeWithFileName(padValueWithZeros(iteration_step));
 };
+#if SPHINXSYS_USE_PROFILING
+//=============================================================================================//
+ProfileRecord &BodyStatesRecording::profileRecord()
+{
+    return profile_record_.get([&]()
+                               { return profileTypeName(typeid(*this)) + ": writeToFile"; });
+}
+//=============================================================================================//
+size_t BodyStatesRecording::totalRecordedParticles()
+{
+    size_t total_particles = 0;
+    for (SPHBody *body : bodies_)
+        total_particles += body->getBaseParticles().total_real_particles_;
+    return total_particles;
+}
+#endif
 //=============================================================================================//
-RestartIO::RestartIO(SPHBodyVector bodies)
+RestartIO::RestartIO(SPHBodyVector bodies, bool use_binary_format)
     : BaseIO(bodies[0]->getSPHSystem()), bodies_(bodies),
-      overall_file_path_(io_environment_.restart_folder_ + "/Restart_time_")
+      overall_file_path_(io_environment_.restart_folder_ + "/Restart_time_"),
+      use_binary_format_(use_binary_format)
 {
     std::transform(bodies.begin(), bodies.end(), std::back_inserter(file_names_),
                    [&](SPHBody *body) -> std::string
@@ -48,6 +84,31 @@ RestartIO::RestartIO(SPHBodyVector bodies)
 //=============================================================================================//
 void RestartIO::writeToFile(size_t iteration_step)
 {
+    for (size_t i = 0; i < bodies_.size(); ++i)
+    {
+        if (use_binary_format_)
+        {
+            // written to a temporary file first so that an interrupted writing leaves no broken restart file
+            std::string filefullpath = file_names_[i] + padValueWithZeros(iteration_step) + ".bin";
+            std::string temporary_filefullpath = filefullpath + ".tmp";
+            bodies_[i]->writeParticlesToBinaryForRestart(temporary_filefullpath);
+            fs::rename(temporary_filefullpath, filefullpath);
+            fs::remove(file_names_[i] + padValueWithZeros(iteration_step) + ".xml");
+        }
+        else
+        {
+            std::string filefullpath = file_names_[i] + padValueWithZeros(iteration_step) + ".xml";
+
+            if (fs::exists(filefullpath))
+            {
+                fs::remove(filefullpath);
+            }
+            bodies_[i]->writeParticlesToXmlForRestart(filefullpath);
+            fs::remove(file_names_[i] + padValueWithZeros(iteration_step) + ".bin");
+        }
+    }
+
+    // the restart time is written after the body files, so that its existence marks a complete restart step
     std::string overall_filefullpath = overall_file_path_ + padValueWithZeros(iteration_step) + ".dat";
     if (fs::exists(overall_filefullpath))
     {
@@ -56,17 +117,6 @@ void RestartIO::writeToFile(size_t iteration_step)
     std::ofstream out_file(overall_filefullpath.c_str(), std::ios::app);
     out_file << std::fixed << std::setprecision(9) << GlobalStaticVariables::physical_time_ << "   \n";
     out_file.close();
-
-    for (size_t i = 0; i < bodies_.size(); ++i)
-    {
-        std::string filefullpath = file_names_[i] + padValueWithZeros(iteration_step) + ".xml";
-
-        if (fs::exists(filefullpath))
-        {
-            fs::remove(filefullpath);
-        }
-        bodies_[i]->writeParticlesToXmlForRestart(filefullpath);
-    }
 }
 //=============================================================================================//
 Real RestartIO::readRestartTime(size_t restart_step)
@@ -91,21 +141,30 @@ void RestartIO::readFromFile(size_t restart_step)
 {
     for (size_t i = 0; i < bodies_.size(); ++i)
     {
-        std::string filefullpath = file_names_[i] + padValueWithZeros(restart_step) + ".xml";
+        std::string binary_filefullpath = file_names_[i] + padValueWithZeros(restart_step) + ".bin";
+        std::string xml_filefullpath = file_names_[i] + padValueWithZeros(restart_step) + ".xml";
+        std::string filefullpath = selectBinaryOrXmlFile(binary_filefullpath, xml_filefullpath);
 
-        if (!fs::exists(filefullpath))
+        if (filefullpath.empty())
         {
-            std::cout << "\n Error: the input file:" << filefullpath << " is not exists" << std::endl;
+            std::cout << "\n Error: the input file:" << xml_filefullpath << " is not exists" << std::endl;
             std::cout << __FILE__ << ':' << __LINE__ << std::endl;
             exit(1);
         }
 
-        bodies_[i]->readParticlesFromXmlForRestart(filefullpath);
+        if (filefullpath == binary_filefullpath)
+        {
+            bodies_[i]->readParticlesFromBinaryForRestart(filefullpath);
+        }
+        else
+        {
+            bodies_[i]->readParticlesFromXmlForRestart(filefullpath);
+        }
     }
 }
 //=============================================================================================//
 ReloadParticleIO::ReloadParticleIO(SPHBodyVector bodies)
-    : BaseIO(bodies[0]->getSPHSystem()), bodies_(bodies)
+    : BaseIO(bodies[0]->getSPHSystem()), bodies_(bodies), use_binary_format_(false)
 {
     std::transform(bodies.begin(), bodies.end(), std::back_inserter(file_names_),
                    [&](SPHBody *body) -> std::string
@@ -113,7 +172,7 @@ ReloadParticleIO::ReloadParticleIO(SPHBodyVector bodies)
 }
 //=============================================================================================//
 ReloadParticleIO::ReloadParticleIO(SPHBody &sph_body, const std::string &given_body_name)
-    : BaseIO(sph_body.getSPHSystem()), bodies_({&sph_body})
+    : BaseIO(sph_body.getSPHSystem()), bodies_({&sph_body}), use_binary_format_(false)
 {
     file_names_.push_back(io_environment_.reload_folder_ + "/" + given_body_name + "_rld.xml");
 }
@@ -125,13 +184,26 @@ void ReloadParticleIO::writeToFile(size_t iteration_step)
 {
     for (size_t i = 0; i < bodies_.size(); ++i)
     {
-        std::string filefullpath = file_names_[i];
-
-        if (fs::exists(filefullpath))
+        if (use_binary_format_)
         {
-            fs::remove(filefullpath);
+            // the binary file is named as the XML file but with the extension .bin
+            std::string filefullpath = fs::path(file_names_[i]).replace_extension(".bin").string();
+            std::string temporary_filefullpath = filefullpath + ".tmp";
+            bodies_[i]->writeToBinaryForReloadParticle(temporary_filefullpath);
+            fs::rename(temporary_filefullpath, filefullpath);
+            fs::remove(file_names_[i]);
+        }
+        else
+        {
+            std::string filefullpath = file_names_[i];
+
+            if (fs::exists(filefullpath))
+            {
+                fs::remove(filefullpath);
+            }
+            bodies_[i]->writeToXmlForReloadParticle(filefullpath);
+            fs::remove(fs::path(file_names_[i]).replace_extension(".bin"));
         }
-        bodies_[i]->writeToXmlForReloadParticle(filefullpath);
     }
 }
 //=============================================================================================//
@@ -140,16 +212,24 @@ void ReloadParticleIO::readFromFile(size_t restart_step)
     std::cout << "\n Reloading particles from files." << std::endl;
     for (size_t i = 0; i < bodies_.size(); ++i)
     {
-        std::string filefullpath = file_names_[i];
+        std::string binary_filefullpath = fs::path(file_names_[i]).replace_extension(".bin").string();
+        std::string filefullpath = selectBinaryOrXmlFile(binary_filefullpath, file_names_[i]);
 
-        if (!fs::exists(filefullpath))
+        if (filefullpath.empty())
         {
-            std::cout << "\n Error: the input file:" << filefullpath << " is not exists" << std::endl;
+            std::cout << "\n Error: the input file:" << file_names_[i] << " is not exists" << std::endl;
             std::cout << __FILE__ << ':' << __LINE__ << std::endl;
             exit(1);
         }
 
-        bodies_[i]->readFromXmlForReloadParticle(filefullpath);
+        if (filefullpath == binary_filefullpath)
+        {
+            bodies_[i]->readFromBinaryForReloadParticle(filefullpath);
+        }
+        else
+        {
+            bodies_[i]->readFromXmlForReloadParticle(filefullpath);
+        }
     }
 }
 //=================================================================================================//
@@ -45,6 +45,13 @@ namespace SPH
 {
 class SPHSystem;
 
+/**
+ * @brief Select the file for reading from the binary and XML files of the same data.
+ * Only one of them is kept when writing, but for files left by earlier runs,
+ * the newer one is taken. An empty string is returned if neither exists.
+ */
+std::string selectBinaryOrXmlFile(const std::string &binary_filefullpath, const std::string &xml_filefullpath);
+
 /**
  * @class BaseIO
  * @brief base class for write and read.
@@ -91,13 +98,22 @@ class BodyStatesRecording : public BaseIO
   protected:
     SPHBodyVector bodies_;
     bool state_recording_;
+#if SPHINXSYS_USE_PROFILING
+    ProfileRecordHandle profile_record_;
+    ProfileRecord &profileRecord();
+    size_t totalRecordedParticles();
+#endif
 
     virtual void writeWithFileName(const std::string &sequence) = 0;
 };
 
 /**
  * @class RestartIO
- * @brief Write and read the restart files in XML format.
+ * @brief Write and read the restart files in XML or binary format.
+ * The binary files are written with large sequential writes and
+ * read directly into the particle variables with checksums verified.
+ * Writing in one format removes the file of the other format for the same step,
+ * and the file to read is selected by selectBinaryOrXmlFile.
  */
 class RestartIO : public BaseIO
 {
@@ -105,11 +121,12 @@ class RestartIO : public BaseIO
     SPHBodyVector bodies_;
     std::string overall_file_path_;
     StdVec<std::string> file_names_;
+    bool use_binary_format_;
 
     Real readRestartTime(size_t restart_step);
 
   public:
-    RestartIO(SPHBodyVector bodies);
+    RestartIO(SPHBodyVector bodies, bool use_binary_format = false);
     virtual ~RestartIO(){};
 
     virtual void writeToFile(size_t iteration_step = 0) override;
@@ -124,19 +141,24 @@ class RestartIO : public BaseIO
 
 /**
  * @class ReloadParticleIO
- * @brief Write and read the particle-reloading files in XML format.
+ * @brief Write and read the particle-reloading files in XML or binary format.
+ * The binary files are memory mapped and copied directly into the particle variables
+ * when reloading, so that concurrent runs on a node share the page cache.
+ * As for RestartIO, only the file of the format last written is kept.
  */
 class ReloadParticleIO : public BaseIO
 {
   protected:
     SPHBodyVector bodies_;
     StdVec<std::string> file_names_;
+    bool use_binary_format_;
 
   public:
     ReloadParticleIO(SPHBodyVector bodies);
     ReloadParticleIO(SPHBody &sph_body);
     ReloadParticleIO(SPHBody &sph_body, const std::string &given_body_name);
     virtual ~ReloadParticleIO(){};
+    void useBinaryFormat() { use_binary_format_ = true; };
 
     virtual void writeToFile(size_t iteration_step = 0) override;
     virtual void readFromFile(size_t iteration_step = 0);
@@ -97,6 +97,69 @@ class ObservedQuantityRecording : public BodyStatesRecording,
     }
 };
 
+/**
+ * @class ProbedQuantityRecording
+ * @brief Write the quantity probed at the observer particles, e.g. thousands of probes on lines or planes,
+ * into one binary file for each output. No contact relation is required and the probing is carried out
+ * only when writing. The file starts with the format name SPHXPRB, the version, the number of probes
+ * and the physical time, followed by the binary blocks of the probe positions and the probed quantity
+ * in the same format as the binary restart files.
+ */
+template <typename VariableType>
+class ProbedQuantityRecording : public BodyStatesRecording,
+                                public ProbingAQuantity<VariableType>
+{
+  protected:
+    SPHBody &observer_;
+    BaseParticles &base_particles_;
+    const std::string quantity_name_;
+
+  public:
+    ProbedQuantityRecording(const std::string &quantity_name, SPHBody &observer, RealBodyVector target_bodies)
+        : BodyStatesRecording(observer),
+          ProbingAQuantity<VariableType>(observer, target_bodies, quantity_name),
+          observer_(observer), base_particles_(observer.getBaseParticles()),
+          quantity_name_(quantity_name){};
+    virtual ~ProbedQuantityRecording(){};
+
+    virtual void writeWithFileName(const std::string &sequence) override
+    {
+        this->exec();
+        std::string filefullpath = io_environment_.output_folder_ + "/" + observer_.getName() + "_" +
+                                   quantity_name_ + "_" + sequence + ".bin";
+        std::ofstream output_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+        if (!output_file.is_open())
+        {
+            std::cout << "\n Error: failed to open the probed quantity file: " << filefullpath << "!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        output_file.write("SPHXPRB", 8);
+        uint64_t version = 1;
+        uint64_t number_of_probes = base_particles_.total_real_particles_;
+        double physical_time = GlobalStaticVariables::physical_time_;
+        output_file.write(reinterpret_cast<const char *>(&version), sizeof(uint64_t));
+        output_file.write(reinterpret_cast<const char *>(&number_of_probes), sizeof(uint64_t));
+        output_file.write(reinterpret_cast<const char *>(&physical_time), sizeof(double));
+
+        WriteAParticleVariableToBinary write_variable_to_binary(output_file, base_particles_.total_real_particles_);
+        write_variable_to_binary("Position", base_particles_.pos_);
+        write_variable_to_binary(quantity_name_, *this->interpolated_quantities_);
+        output_file.close();
+        if (!output_file)
+        {
+            std::cout << "\n Error: failed to write the probed quantity file: " << filefullpath << "!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    };
+
+    StdLargeVec<VariableType> *getProbedQuantity()
+    {
+        return this->interpolated_quantities_;
+    }
+};
+
 /**
  * @class ReducedQuantityRecording
  * @brief write reduced quantity of a body
@@ -5,6 +5,10 @@
 
 #include "io_vtk.h"
 
+#ifdef ZLIB_AVAILABLE
+#include <zlib.h>
+#endif
+
 namespace SPH
 {
 //=============================================================================================//
@@ -83,6 +87,284 @@ void BodyStatesRecordingToVtp::writeWithFileName(const std::string &sequence)
     }
 }
 //=============================================================================================//
+std::string VtkAppendedData::encode(const char *data, size_t size)
+{
+    if (!use_compression_)
+    {
+        std::string encoded(sizeof(uint64_t) + size, '\0');
+        uint64_t header = size;
+        std::memcpy(&encoded[0], &header, sizeof(uint64_t));
+        std::memcpy(&encoded[sizeof(uint64_t)], data, size);
+        return encoded;
+    }
+#ifdef ZLIB_AVAILABLE
+    const size_t block_size = 1 << 15;
+    size_t number_of_blocks = (size + block_size - 1) / block_size;
+    StdVec<std::string> compressed_blocks(number_of_blocks);
+    StdVec<int> compression_results(number_of_blocks, Z_OK);
+    particle_for(execution::ParallelPolicy(), IndexRange(0, number_of_blocks),
+                 [&](size_t n)
+                 {
+                     size_t begin = n * block_size;
+                     uLong source_size = SMIN(block_size, size - begin);
+                     uLongf compressed_size = compressBound(source_size);
+                     std::string &block = compressed_blocks[n];
+                     block.resize(compressed_size);
+                     compression_results[n] = compress(reinterpret_cast<Bytef *>(&block[0]), &compressed_size,
+                                                       reinterpret_cast<const Bytef *>(data + begin), source_size);
+                     block.resize(compressed_size);
+                 });
+    for (size_t n = 0; n != number_of_blocks; ++n)
+    {
+        if (compression_results[n] != Z_OK)
+        {
+            std::cout << "\n Error: zlib failed to compress the VTK data with the error code "
+                      << compression_results[n] << "!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    }
+
+    StdVec<uint64_t> header = {number_of_blocks, block_size, size % block_size};
+    for (const std::string &block : compressed_blocks)
+        header.push_back(block.size());
+    std::string encoded(reinterpret_cast<const char *>(header.data()), header.size() * sizeof(uint64_t));
+    for (const std::string &block : compressed_blocks)
+        encoded += block;
+    return encoded;
+#else
+    std::cout << "\n Error: VTK data compression requires zlib, which is not found!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+#endif
+}
+//=============================================================================================//
+void VtkAppendedData::writeDataArrayHeader(std::ostream &output_stream, const std::string &name)
+{
+    for (const DataArray &data_array : data_arrays_)
+    {
+        if (data_array.name_ == name)
+        {
+            output_stream << "    <DataArray Name=\"" << name << "\" type=\"" << data_array.type_
+                          << "\" NumberOfComponents=\"" << data_array.number_of_components_
+                          << "\" format=\"appended\" offset=\"" << data_array.offset_ << "\"/>\n";
+        }
+    }
+}
+//=============================================================================================//
+void VtkAppendedData::writeAppendedData(std::ostream &output_stream)
+{
+    output_stream << " <AppendedData encoding=\"raw\">\n";
+    output_stream << "_";
+    for (const DataArray &data_array : data_arrays_)
+    {
+        output_stream.write(data_array.encoded_data_.data(), data_array.encoded_data_.size());
+    }
+    output_stream << "\n </AppendedData>\n";
+}
+//=============================================================================================//
+std::string VtkAppendedData::CompressorAttribute()
+{
+    return use_compression_ ? " compressor=\"vtkZLibDataCompressor\"" : "";
+}
+//=============================================================================================//
+BodyStatesRecordingToVtpBinary::
+    BodyStatesRecordingToVtpBinary(SPHBody &body, bool use_compression, size_t number_of_pieces)
+    : BodyStatesRecordingToVtpBinary(SPHBodyVector{&body}, use_compression, number_of_pieces) {}
+//=============================================================================================//
+BodyStatesRecordingToVtpBinary::
+    BodyStatesRecordingToVtpBinary(SPHBodyVector bodies, bool use_compression, size_t number_of_pieces)
+    : BodyStatesRecording(bodies), use_compression_(use_compression),
+      number_of_pieces_(SMAX(number_of_pieces, size_t(1)))
+{
+#ifndef ZLIB_AVAILABLE
+    if (use_compression_)
+    {
+        std::cout << "\n Warning: zlib is not found, the VTK data are written without compression!" << std::endl;
+        use_compression_ = false;
+    }
+#endif
+}
+//=============================================================================================//
+void BodyStatesRecordingToVtpBinary::writeWithFileName(const std::string &sequence)
+{
+    for (SPHBody *body : bodies_)
+    {
+        if (body->checkNewlyUpdated())
+        {
+            BaseParticles &base_particles = body->getBaseParticles();
+            base_particles.computeDerivedVariables();
+
+            if (state_recording_)
+            {
+                std::string file_name = body->getName() + "_" + sequence;
+                size_t total_real_particles = base_particles.total_real_particles_;
+                if (number_of_pieces_ == 1)
+                {
+                    writePiece(io_environment_.output_folder_ + "/" + file_name + ".vtp", *body, 0, total_real_particles);
+                }
+                else
+                {
+                    StdVec<std::string> piece_names;
+                    for (size_t k = 0; k != number_of_pieces_; ++k)
+                        piece_names.push_back(file_name + "_" + std::to_string(k) + ".vtp");
+
+                    particle_for(execution::ParallelPolicy(), IndexRange(0, number_of_pieces_),
+                                 [&](size_t k)
+                                 {
+                                     size_t begin = k * total_real_particles / number_of_pieces_;
+                                     size_t end = (k + 1) * total_real_particles / number_of_pieces_;
+                                     writePiece(io_environment_.output_folder_ + "/" + piece_names[k], *body, begin, end);
+                                 });
+                    writePieceCollection(io_environment_.output_folder_ + "/" + file_name + ".pvtp", *body, piece_names);
+                }
+            }
+        }
+        body->setNotNewlyUpdated();
+    }
+}
+//=============================================================================================//
+void BodyStatesRecordingToVtpBinary::
+    writePiece(const std::string &filefullpath, SPHBody &body, size_t begin, size_t end)
+{
+    BaseParticles &base_particles = body.getBaseParticles();
+    ParticleData &all_particle_data = base_particles.getAllParticleData();
+    const ParticleVariables &variables_to_write = base_particles.getVariablesToWrite();
+    size_t number_of_particles = end - begin;
+    VtkAppendedData appended_data(use_compression_);
+
+    appended_data.addDataArray<float>(
+        "Position", 3, number_of_particles, [&](size_t i, float *values)
+        {   Vec3d position = upgradeToVec3d(base_particles.pos_[begin + i]);
+            for (int k = 0; k != 3; ++k)
+                values[k] = float(position[k]); });
+    appended_data.addDataArray<int>(
+        "SortedParticle_ID", 1, number_of_particles, [&](size_t i, int *values)
+        { values[0] = int(begin + i); });
+    appended_data.addDataArray<int>(
+        "UnsortedParticle_ID", 1, number_of_particles, [&](size_t i, int *values)
+        { values[0] = int(base_particles.unsorted_id_[begin + i]); });
+
+    constexpr int type_index_int = DataTypeIndex<int>::value;
+    for (DiscreteVariable<int> *variable : std::get<type_index_int>(variables_to_write))
+    {
+        StdLargeVec<int> &variable_data = *(std::get<type_index_int>(all_particle_data)[variable->IndexInContainer()]);
+        appended_data.addDataArray<int>(
+            variable->Name(), 1, number_of_particles, [&](size_t i, int *values)
+            { values[0] = variable_data[begin + i]; });
+    }
+
+    constexpr int type_index_Real = DataTypeIndex<Real>::value;
+    for (DiscreteVariable<Real> *variable : std::get<type_index_Real>(variables_to_write))
+    {
+        StdLargeVec<Real> &variable_data = *(std::get<type_index_Real>(all_particle_data)[variable->IndexInContainer()]);
+        appended_data.addDataArray<float>(
+            variable->Name(), 1, number_of_particles, [&](size_t i, float *values)
+            { values[0] = float(variable_data[begin + i]); });
+    }
+
+    constexpr int type_index_Vecd = DataTypeIndex<Vecd>::value;
+    for (DiscreteVariable<Vecd> *variable : std::get<type_index_Vecd>(variables_to_write))
+    {
+        StdLargeVec<Vecd> &variable_data = *(std::get<type_index_Vecd>(all_particle_data)[variable->IndexInContainer()]);
+        appended_data.addDataArray<float>(
+            variable->Name(), 3, number_of_particles, [&](size_t i, float *values)
+            {   Vec3d vector_value = upgradeToVec3d(variable_data[begin + i]);
+                for (int k = 0; k != 3; ++k)
+                    values[k] = float(vector_value[k]); });
+    }
+
+    constexpr int type_index_Matd = DataTypeIndex<Matd>::value;
+    for (DiscreteVariable<Matd> *variable : std::get<type_index_Matd>(variables_to_write))
+    {
+        StdLargeVec<Matd> &variable_data = *(std::get<type_index_Matd>(all_particle_data)[variable->IndexInContainer()]);
+        appended_data.addDataArray<float>(
+            variable->Name(), 9, number_of_particles, [&](size_t i, float *values)
+            {   Mat3d matrix_value = upgradeToMat3d(variable_data[begin + i]);
+                for (int k = 0; k != 3; ++k)
+                    for (int l = 0; l != 3; ++l)
+                        values[3 * k + l] = float(matrix_value(l, k)); });
+    }
+
+    appended_data.addDataArray<int>(
+        "connectivity", 1, number_of_particles, [&](size_t i, int *values)
+        { values[0] = int(i); });
+    appended_data.addDataArray<int>(
+        "offsets", 1, number_of_particles, [&](size_t i, int *values)
+        { values[0] = int(i + 1); });
+
+    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+    out_file << "<?xml version=\"1.0\"?>\n";
+    out_file << "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\""
+             << appended_data.CompressorAttribute() << ">\n";
+    out_file << " <PolyData>\n";
+    out_file << "  <Piece Name =\"" << body.getName() << "\" NumberOfPoints=\"" << number_of_particles
+             << "\" NumberOfVerts=\"" << number_of_particles << "\">\n";
+
+    out_file << "   <Points>\n";
+    appended_data.writeDataArrayHeader(out_file, "Position");
+    out_file << "   </Points>\n";
+
+    out_file << "   <PointData  Vectors=\"vector\">\n";
+    appended_data.writeDataArrayHeader(out_file, "SortedParticle_ID");
+    appended_data.writeDataArrayHeader(out_file, "UnsortedParticle_ID");
+    for (DiscreteVariable<int> *variable : std::get<type_index_int>(variables_to_write))
+        appended_data.writeDataArrayHeader(out_file, variable->Name());
+    for (DiscreteVariable<Real> *variable : std::get<type_index_Real>(variables_to_write))
+        appended_data.writeDataArrayHeader(out_file, variable->Name());
+    for (DiscreteVariable<Vecd> *variable : std::get<type_index_Vecd>(variables_to_write))
+        appended_data.writeDataArrayHeader(out_file, variable->Name());
+    for (DiscreteVariable<Matd> *variable : std::get<type_index_Matd>(variables_to_write))
+        appended_data.writeDataArrayHeader(out_file, variable->Name());
+    out_file << "   </PointData>\n";
+
+    out_file << "   <Verts>\n";
+    appended_data.writeDataArrayHeader(out_file, "connectivity");
+    appended_data.writeDataArrayHeader(out_file, "offsets");
+    out_file << "   </Verts>\n";
+
+    out_file << "  </Piece>\n";
+    out_file << " </PolyData>\n";
+    appended_data.writeAppendedData(out_file);
+    out_file << "</VTKFile>\n";
+    out_file.close();
+}
+//=============================================================================================//
+void BodyStatesRecordingToVtpBinary::
+    writePieceCollection(const std::string &filefullpath, SPHBody &body, const StdVec<std::string> &piece_names)
+{
+    BaseParticles &base_particles = body.getBaseParticles();
+    const ParticleVariables &variables_to_write = base_particles.getVariablesToWrite();
+
+    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+    out_file << "<?xml version=\"1.0\"?>\n";
+    out_file << "<VTKFile type=\"PPolyData\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n";
+    out_file << " <PPolyData GhostLevel=\"0\">\n";
+    out_file << "  <PPoints>\n";
+    out_file << "   <PDataArray Name=\"Position\" type=\"Float32\" NumberOfComponents=\"3\"/>\n";
+    out_file << "  </PPoints>\n";
+
+    out_file << "  <PPointData Vectors=\"vector\">\n";
+    out_file << "   <PDataArray Name=\"SortedParticle_ID\" type=\"Int32\" NumberOfComponents=\"1\"/>\n";
+    out_file << "   <PDataArray Name=\"UnsortedParticle_ID\" type=\"Int32\" NumberOfComponents=\"1\"/>\n";
+    for (DiscreteVariable<int> *variable : std::get<DataTypeIndex<int>::value>(variables_to_write))
+        out_file << "   <PDataArray Name=\"" << variable->Name() << "\" type=\"Int32\" NumberOfComponents=\"1\"/>\n";
+    for (DiscreteVariable<Real> *variable : std::get<DataTypeIndex<Real>::value>(variables_to_write))
+        out_file << "   <PDataArray Name=\"" << variable->Name() << "\" type=\"Float32\" NumberOfComponents=\"1\"/>\n";
+    for (DiscreteVariable<Vecd> *variable : std::get<DataTypeIndex<Vecd>::value>(variables_to_write))
+        out_file << "   <PDataArray Name=\"" << variable->Name() << "\" type=\"Float32\" NumberOfComponents=\"3\"/>\n";
+    for (DiscreteVariable<Matd> *variable : std::get<DataTypeIndex<Matd>::value>(variables_to_write))
+        out_file << "   <PDataArray Name=\"" << variable->Name() << "\" type=\"Float32\" NumberOfComponents=\"9\"/>\n";
+    out_file << "  </PPointData>\n";
+
+    for (const std::string &piece_name : piece_names)
+        out_file << "  <Piece Source=\"" << piece_name << "\"/>\n";
+
+    out_file << " </PPolyData>\n";
+    out_file << "</VTKFile>\n";
+    out_file.close();
+}
+//=============================================================================================//
 void BodyStatesRecordingToVtpString::writeWithFileName(const std::string &sequence)
 {
     for (SPHBody *body : bodies_)
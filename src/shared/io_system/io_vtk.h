@@ -51,6 +51,73 @@ class BodyStatesRecordingToVtp : public BodyStatesRecording
     virtual void writeWithFileName(const std::string &sequence) override;
 };
 
+/**
+ * @class VtkAppendedData
+ * @brief Data arrays encoded as raw binary for the appended data section of a VTK XML file.
+ * Each array is preceded by a UInt64 header giving its size in bytes.
+ * With compression, the array is split into blocks compressed with zlib in parallel,
+ * and the header gives the number and the sizes of the blocks.
+ */
+class VtkAppendedData
+{
+  public:
+    explicit VtkAppendedData(bool use_compression) : use_compression_(use_compression){};
+    virtual ~VtkAppendedData(){};
+
+    /** Add an array whose components of each entry are given by component_function(index, values). */
+    template <typename OutputType, class ComponentFunction>
+    void addDataArray(const std::string &name, int number_of_components, size_t size,
+                      const ComponentFunction &component_function)
+    {
+        StdLargeVec<OutputType> values(size * number_of_components);
+        particle_for(execution::ParallelPolicy(), IndexRange(0, size),
+                     [&](size_t i)
+                     { component_function(i, &values[i * number_of_components]); });
+        std::string type = std::is_same<OutputType, int>::value ? "Int32" : "Float32";
+        data_arrays_.push_back({name, type, number_of_components, offset_,
+                                encode(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(OutputType))});
+        offset_ += data_arrays_.back().encoded_data_.size();
+    };
+    void writeDataArrayHeader(std::ostream &output_stream, const std::string &name);
+    void writeAppendedData(std::ostream &output_stream);
+    std::string CompressorAttribute();
+
+  protected:
+    struct DataArray
+    {
+        std::string name_, type_;
+        int number_of_components_;
+        size_t offset_;
+        std::string encoded_data_;
+    };
+    bool use_compression_;
+    size_t offset_ = 0;
+    StdVec<DataArray> data_arrays_;
+    std::string encode(const char *data, size_t size);
+};
+
+/**
+ * @class BodyStatesRecordingToVtpBinary
+ * @brief Write files for bodies with VTK XML format with raw appended binary data,
+ * optionally compressed with zlib. The data arrays are formatted in parallel.
+ * The particles of a body can be written in several pieces in parallel,
+ * each as a vtp file, together with a pvtp file collecting the pieces.
+ */
+class BodyStatesRecordingToVtpBinary : public BodyStatesRecording
+{
+  public:
+    BodyStatesRecordingToVtpBinary(SPHBody &body, bool use_compression = false, size_t number_of_pieces = 1);
+    BodyStatesRecordingToVtpBinary(SPHBodyVector bodies, bool use_compression = false, size_t number_of_pieces = 1);
+    virtual ~BodyStatesRecordingToVtpBinary(){};
+
+  protected:
+    bool use_compression_;
+    size_t number_of_pieces_;
+    virtual void writeWithFileName(const std::string &sequence) override;
+    void writePiece(const std::string &filefullpath, SPHBody &body, size_t begin, size_t end);
+    void writePieceCollection(const std::string &filefullpath, SPHBody &body, const StdVec<std::string> &piece_names);
+};
+
 /**
  * @class BodyStatesRecordingToVtpString
  * @brief  Write strings for bodies
@@ -0,0 +1,74 @@
+#include "memory_mapped_file.h"
+
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SPH
+{
+//=================================================================================================//
+MemoryMappedFile::MemoryMappedFile(const std::string &filefullpath)
+    : data_(nullptr), size_(0)
+{
+    bool is_mapped = false;
+#ifdef _WIN32
+    file_handle_ = CreateFileA(filefullpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    mapping_handle_ = nullptr;
+    LARGE_INTEGER file_size;
+    if (file_handle_ != INVALID_HANDLE_VALUE && GetFileSizeEx(file_handle_, &file_size))
+    {
+        size_ = size_t(file_size.QuadPart);
+        mapping_handle_ = CreateFileMappingA(file_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_handle_ != nullptr)
+        {
+            data_ = static_cast<const char *>(MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+            is_mapped = data_ != nullptr;
+        }
+    }
+#else
+    int file_descriptor = open(filefullpath.c_str(), O_RDONLY);
+    struct stat file_status;
+    if (file_descriptor != -1 && fstat(file_descriptor, &file_status) == 0)
+    {
+        size_ = size_t(file_status.st_size);
+        void *address = mmap(nullptr, size_, PROT_READ, MAP_SHARED, file_descriptor, 0);
+        if (address != MAP_FAILED)
+        {
+            data_ = static_cast<const char *>(address);
+            is_mapped = true;
+            madvise(address, size_, MADV_SEQUENTIAL);
+        }
+    }
+    if (file_descriptor != -1)
+    {
+        close(file_descriptor); // the mapping remains valid after the file is closed
+    }
+#endif
+    if (!is_mapped)
+    {
+        std::cout << "\n Error: the file:" << filefullpath << " can not be mapped to memory!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
+MemoryMappedFile::~MemoryMappedFile()
+{
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(mapping_handle_);
+    CloseHandle(file_handle_);
+#else
+    munmap(const_cast<char *>(data_), size_);
+#endif
+}
+//=================================================================================================//
+} // namespace SPH
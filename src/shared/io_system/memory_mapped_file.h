@@ -0,0 +1,65 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	memory_mapped_file.h
+ * @brief 	Read-only memory mapping of a file.
+ * @details The file is mapped to memory by the operating system instead of being read
+ *          through a stream. Processes mapping the same file on one node share
+ *          the pages of the page cache.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef MEMORY_MAPPED_FILE_H
+#define MEMORY_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+
+namespace SPH
+{
+/**
+ * @class MemoryMappedFile
+ * @brief A file mapped to memory for reading, unmapped when destroyed.
+ */
+class MemoryMappedFile
+{
+  public:
+    explicit MemoryMappedFile(const std::string &filefullpath);
+    virtual ~MemoryMappedFile();
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+    const char *Data() const { return data_; };
+    size_t Size() const { return size_; };
+
+  protected:
+    const char *data_;
+    size_t size_;
+#ifdef _WIN32
+    void *file_handle_;
+    void *mapping_handle_;
+#endif
+};
+} // namespace SPH
+#endif // MEMORY_MAPPED_FILE_H
@@ -98,19 +98,19 @@ Real Kernel::d2W(const Real &r_ij, const Vec3d &displacement) const
 Real Kernel::W(const Real &h_ratio, const Real &r_ij, const Real &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_W_1D_ * W_1D(q) * h_factor_W_1D_(h_ratio);
+    return FactorW1D(h_ratio) * W_1D(q);
 }
 //=================================================================================================//
 Real Kernel::W(const Real &h_ratio, const Real &r_ij, const Vec2d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_W_2D_ * W_2D(q) * h_factor_W_2D_(h_ratio);
+    return FactorW2D(h_ratio) * W_2D(q);
 }
 //=================================================================================================//
 Real Kernel::W(const Real &h_ratio, const Real &r_ij, const Vec3d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_W_3D_ * W_3D(q) * h_factor_W_3D_(h_ratio);
+    return FactorW3D(h_ratio) * W_3D(q);
 }
 //=================================================================================================//
 Real Kernel::W0(const Real &h_ratio, const Real &point_i) const
@@ -131,19 +131,19 @@ Real Kernel::W0(const Real &h_ratio, const Vec3d &point_i) const
 Real Kernel::dW(const Real &h_ratio, const Real &r_ij, const Real &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_dW_1D_ * dW_1D(q) * h_factor_dW_1D_(h_ratio);
+    return FactordW1D(h_ratio) * dW_1D(q);
 }
 //=================================================================================================//
 Real Kernel::dW(const Real &h_ratio, const Real &r_ij, const Vec2d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_dW_2D_ * dW_2D(q) * h_factor_dW_2D_(h_ratio);
+    return FactordW2D(h_ratio) * dW_2D(q);
 }
 //=================================================================================================//
 Real Kernel::dW(const Real &h_ratio, const Real &r_ij, const Vec3d &displacement) const
 {
     Real q = r_ij * inv_h_ * h_ratio;
-    return factor_dW_3D_ * dW_3D(q) * h_factor_dW_1D_(h_ratio);
+    return FactordW3D(h_ratio) * dW_3D(q);
 }
 //=================================================================================================//
 Real Kernel::d2W(const Real &h_ratio, const Real &r_ij, const Real &displacement) const
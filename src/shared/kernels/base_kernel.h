@@ -87,6 +87,10 @@ class Kernel
     Real FactorW1D() const { return factor_W_1D_; };
     Real FactorW2D() const { return factor_W_2D_; };
     Real FactorW3D() const { return factor_W_3D_; };
+    Real FactordW1D() const { return factor_dW_1D_; };
+    Real FactordW2D() const { return factor_dW_2D_; };
+    Real FactordW3D() const { return factor_dW_3D_; };
+    Real InverseSmoothingLength() const { return inv_h_; };
     
     /**
      * unit vector pointing from j to i or inter-particle surface direction
@@ -189,6 +193,13 @@ class Kernel
   public:
     Real CutOffRadius(Real h_ratio) const { return rc_ref_ / h_ratio; };
     Real CutOffRadiusSqr(Real h_ratio) const { return rc_ref_sqr_ / (h_ratio * h_ratio); };
+    /** Normalization factors of the kernel function and its derivative for variable smoothing length **/
+    Real FactorW1D(Real h_ratio) const { return factor_W_1D_ * h_factor_W_1D_(h_ratio); };
+    Real FactorW2D(Real h_ratio) const { return factor_W_2D_ * h_factor_W_2D_(h_ratio); };
+    Real FactorW3D(Real h_ratio) const { return factor_W_3D_ * h_factor_W_3D_(h_ratio); };
+    Real FactordW1D(Real h_ratio) const { return factor_dW_1D_ * h_factor_dW_1D_(h_ratio); };
+    Real FactordW2D(Real h_ratio) const { return factor_dW_2D_ * h_factor_dW_2D_(h_ratio); };
+    Real FactordW3D(Real h_ratio) const { return factor_dW_3D_ * h_factor_dW_1D_(h_ratio); };
 
     Real W(const Real &h_ratio, const Real &r_ij, const Real &displacement) const;
     Real W(const Real &h_ratio, const Real &r_ij, const Vec2d &displacement) const;
@@ -31,11 +31,15 @@
 
 #include "base_kernel.h"
 
+#include <cmath>
+
 namespace SPH
 {
 /**
  * @class Kernel Cubic B_Spline
  * @brief Kernel Cubic B_Spline
+ * The kernel functions are final and defined inline,
+ * so that they are inlined when called through the concrete kernel type.
  */
 class KernelCubicBSpline : public Kernel
 {
@@ -46,17 +50,84 @@ class KernelCubicBSpline : public Kernel
      * Calculates the kernel value for
      * the given distance of two particles
      */
-    virtual Real W_1D(const Real q) const override;
-    virtual Real W_2D(const Real q) const override;
-    virtual Real W_3D(const Real q) const override;
+    virtual Real W_1D(const Real q) const override final;
+    virtual Real W_2D(const Real q) const override final;
+    virtual Real W_3D(const Real q) const override final;
 
-    virtual Real dW_1D(const Real q) const override;
-    virtual Real dW_2D(const Real q) const override;
-    virtual Real dW_3D(const Real q) const override;
+    virtual Real dW_1D(const Real q) const override final;
+    virtual Real dW_2D(const Real q) const override final;
+    virtual Real dW_3D(const Real q) const override final;
 
-    virtual Real d2W_1D(const Real q) const override;
-    virtual Real d2W_2D(const Real q) const override;
-    virtual Real d2W_3D(const Real q) const override;
+    virtual Real d2W_1D(const Real q) const override final;
+    virtual Real d2W_2D(const Real q) const override final;
+    virtual Real d2W_3D(const Real q) const override final;
 };
+//=================================================================================================//
+inline Real KernelCubicBSpline::W_1D(const Real q) const
+{
+    if (q < 1.0)
+    {
+        return (1.0 - 3.0 * pow(q, 2) * (1.0 - q / 2.0) / 2.0);
+    }
+    else
+    {
+        return pow(2.0 - q, 3) / 4.0;
+    }
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::W_2D(const Real q) const
+{
+    return W_1D(q);
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::W_3D(const Real q) const
+{
+    return W_2D(q);
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::dW_1D(const Real q) const
+{
+    if (q < 1.0)
+    {
+        return (9.0 * pow(q, 2) / 4.0 - 3.0 * q);
+    }
+    else
+    {
+        return (-1.0) * 3.0 * pow(2.0 - q, 2) / 4.0;
+    }
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::dW_2D(const Real q) const
+{
+    return dW_1D(q);
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::dW_3D(const Real q) const
+{
+    return dW_2D(q);
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::d2W_1D(const Real q) const
+{
+    if (q < 1.0)
+    {
+        return 9.0 * q / 2.0 - 3.0;
+    }
+    else
+    {
+        return 3.0 * (2.0 - q) / 2.0;
+    }
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::d2W_2D(const Real q) const
+{
+    return d2W_1D(q);
+}
+//=================================================================================================//
+inline Real KernelCubicBSpline::d2W_3D(const Real q) const
+{
+    return d2W_2D(q);
+}
+//=================================================================================================//
 } // namespace SPH
 #endif // KERNEL_CUBIC_B_SPLINE_H
\ No newline at end of file
@@ -64,17 +64,17 @@ class KernelTabulated : public Kernel
   public:
     explicit KernelTabulated(Real h, int kernel_resolution);
 
-    virtual Real W_1D(const Real q) const override;
-    virtual Real W_2D(const Real q) const override;
-    virtual Real W_3D(const Real q) const override;
+    virtual Real W_1D(const Real q) const override final;
+    virtual Real W_2D(const Real q) const override final;
+    virtual Real W_3D(const Real q) const override final;
 
-    virtual Real dW_1D(const Real q) const override;
-    virtual Real dW_2D(const Real q) const override;
-    virtual Real dW_3D(const Real q) const override;
+    virtual Real dW_1D(const Real q) const override final;
+    virtual Real dW_2D(const Real q) const override final;
+    virtual Real dW_3D(const Real q) const override final;
 
-    virtual Real d2W_1D(const Real q) const override;
-    virtual Real d2W_2D(const Real q) const override;
-    virtual Real d2W_3D(const Real q) const override;
+    virtual Real d2W_1D(const Real q) const override final;
+    virtual Real d2W_2D(const Real q) const override final;
+    virtual Real d2W_3D(const Real q) const override final;
 };
 //=================================================================================================//
 template <class KernelType>
@@ -31,11 +31,15 @@
 
 #include "base_kernel.h"
 
+#include <cmath>
+
 namespace SPH
 {
 /**
  * @class KernelWendlandC2
  * @brief Kernel WendlandC2
+ * The kernel functions are final and defined inline,
+ * so that they are inlined when called through the concrete kernel type.
  */
 class KernelWendlandC2 : public Kernel
 {
@@ -46,17 +50,63 @@ class KernelWendlandC2 : public Kernel
      * Calculates the kernel value for
      * the given distance of two particles
      */
-    virtual Real W_1D(const Real q) const override;
-    virtual Real W_2D(const Real q) const override;
-    virtual Real W_3D(const Real q) const override;
+    virtual Real W_1D(const Real q) const override final;
+    virtual Real W_2D(const Real q) const override final;
+    virtual Real W_3D(const Real q) const override final;
 
-    virtual Real dW_1D(const Real q) const override;
-    virtual Real dW_2D(const Real q) const override;
-    virtual Real dW_3D(const Real q) const override;
+    virtual Real dW_1D(const Real q) const override final;
+    virtual Real dW_2D(const Real q) const override final;
+    virtual Real dW_3D(const Real q) const override final;
 
-    virtual Real d2W_1D(const Real q) const override;
-    virtual Real d2W_2D(const Real q) const override;
-    virtual Real d2W_3D(const Real q) const override;
+    virtual Real d2W_1D(const Real q) const override final;
+    virtual Real d2W_2D(const Real q) const override final;
+    virtual Real d2W_3D(const Real q) const override final;
 };
+//=================================================================================================//
+inline Real KernelWendlandC2::W_1D(const Real q) const
+{
+    return pow(1.0 - 0.5 * q, 4) * (1.0 + 2.0 * q);
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::W_2D(const Real q) const
+{
+    return W_1D(q);
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::W_3D(const Real q) const
+{
+    return W_2D(q);
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::dW_1D(const Real q) const
+{
+    return 0.625 * pow(q - 2.0, 3) * q;
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::dW_2D(const Real q) const
+{
+    return dW_1D(q);
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::dW_3D(const Real q) const
+{
+    return dW_2D(q);
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::d2W_1D(const Real q) const
+{
+    return 1.25 * pow(q - 2.0, 2) * (2.0 * q - 1.0);
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::d2W_2D(const Real q) const
+{
+    return d2W_1D(q);
+}
+//=================================================================================================//
+inline Real KernelWendlandC2::d2W_3D(const Real q) const
+{
+    return d2W_2D(q);
+}
+//=================================================================================================//
 } // namespace SPH
 #endif // KERNEL_WENLAND_C2_H
\ No newline at end of file
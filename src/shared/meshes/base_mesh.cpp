@@ -49,6 +49,70 @@ size_t BaseMesh::MortonCode(const size_t &i)
     return x;
 }
 //=================================================================================================//
+int BaseMesh::HilbertOrderBits()
+{
+    int bits = 1;
+    while ((1 << bits) < all_grid_points_.maxCoeff())
+        ++bits;
+    return bits;
+}
+//=================================================================================================//
+size_t BaseMesh::HilbertCode(const Arrayi &mesh_index, int bits)
+{
+    Arrayi x = mesh_index;
+    // inverse undo excess work
+    for (int q = 1 << (bits - 1); q > 1; q >>= 1)
+    {
+        int p = q - 1;
+        for (int i = 0; i != Dimensions; ++i)
+        {
+            if (x[i] & q)
+            {
+                x[0] ^= p; // invert
+            }
+            else
+            {
+                int t = (x[0] ^ x[i]) & p; // exchange
+                x[0] ^= t;
+                x[i] ^= t;
+            }
+        }
+    }
+    // gray encode
+    for (int i = 1; i != Dimensions; ++i)
+        x[i] ^= x[i - 1];
+    int t = 0;
+    for (int q = 1 << (bits - 1); q > 1; q >>= 1)
+        if (x[Dimensions - 1] & q)
+            t ^= q - 1;
+    for (int i = 0; i != Dimensions; ++i)
+        x[i] ^= t;
+    // interleave the transposed form into a single index
+    size_t code = 0;
+    for (int b = bits - 1; b >= 0; --b)
+        for (int i = 0; i != Dimensions; ++i)
+            code = (code << 1) | ((x[i] >> b) & 1);
+    return code;
+}
+//=================================================================================================//
+size_t BaseMesh::transferMeshIndexToHilbertOrder(const Arrayi &mesh_index)
+{
+    return HilbertCode(mesh_index, HilbertOrderBits());
+}
+//=================================================================================================//
+size_t BaseMesh::transferMeshIndexToCurveOrder(const Arrayi &mesh_index, SpaceFillingCurve curve, int hilbert_bits)
+{
+    switch (curve)
+    {
+    case SpaceFillingCurve::Linear:
+        return transferMeshIndexTo1D(all_grid_points_, mesh_index);
+    case SpaceFillingCurve::Hilbert:
+        return HilbertCode(mesh_index, hilbert_bits);
+    default:
+        return transferMeshIndexToMortonOrder(mesh_index);
+    }
+}
+//=================================================================================================//
 Mesh::Mesh(BoundingBox tentative_bounds, Real grid_spacing, size_t buffer_width)
     : BaseMesh(tentative_bounds, grid_spacing, buffer_width),
       all_cells_{this->AllCellsFromAllGridPoints(this->AllGridPoints())},
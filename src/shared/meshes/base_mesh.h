@@ -46,6 +46,14 @@ using namespace std::placeholders;
 
 namespace SPH
 {
+/** Space-filling curves for ordering mesh cells, and hence sorted particles. */
+enum class SpaceFillingCurve
+{
+    Linear,  /**< row-major order given by transferMeshIndexTo1D */
+    Morton,  /**< Z-order by bit interleaving */
+    Hilbert, /**< Hilbert order, neighboring codes are always neighboring cells */
+};
+
 /**
  * @class BaseMesh
  * @brief Base class for all structured meshes which may be grid or cell based.
@@ -96,6 +104,17 @@ class BaseMesh
     size_t MortonCode(const size_t &i);
     /** Converts mesh index into a Morton order. */
     size_t transferMeshIndexToMortonOrder(const Arrayi &mesh_index);
+    /** Number of bits per axis for a Hilbert order covering all grid points. */
+    int HilbertOrderBits();
+    /** Converts mesh index into a Hilbert order with the given bits per axis.
+     * Based on the transpose algorithm from J. Skilling,
+     * Programming the Hilbert curve, AIP Conference Proceedings 707, 381 (2004).
+     */
+    size_t HilbertCode(const Arrayi &mesh_index, int bits);
+    /** Converts mesh index into a Hilbert order. */
+    size_t transferMeshIndexToHilbertOrder(const Arrayi &mesh_index);
+    /** Converts mesh index into the order along a given space-filling curve. */
+    size_t transferMeshIndexToCurveOrder(const Arrayi &mesh_index, SpaceFillingCurve curve, int hilbert_bits);
 };
 
 /**
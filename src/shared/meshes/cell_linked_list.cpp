@@ -6,13 +6,16 @@
 #include "base_particles.h"
 #include "particle_iterators.h"
 
+#include <thread>
+
 namespace SPH
 {
 //=================================================================================================//
 BaseCellLinkedList::
     BaseCellLinkedList(RealBody &real_body, SPHAdaptation &sph_adaptation)
     : BaseMeshField("CellLinkedList"),
-      real_body_(real_body), kernel_(*sph_adaptation.getKernel()) {}
+      real_body_(real_body), kernel_(*sph_adaptation.getKernel()),
+      space_filling_curve_(SpaceFillingCurve::Morton) {}
 //=================================================================================================//
 void BaseCellLinkedList::clearSplitCellLists(SplitCellLists &split_cell_lists)
 {
@@ -22,14 +25,175 @@ void BaseCellLinkedList::clearSplitCellLists(SplitCellLists &split_cell_lists)
 //=================================================================================================//
 CellLinkedList::CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
                                RealBody &real_body, SPHAdaptation &sph_adaptation)
-    : BaseCellLinkedList(real_body, sph_adaptation), Mesh(tentative_bounds, grid_spacing, 2)
+    : CellLinkedList(tentative_bounds, grid_spacing, real_body, sph_adaptation, true) {}
+//=================================================================================================//
+CellLinkedList::CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
+                               RealBody &real_body, SPHAdaptation &sph_adaptation,
+                               bool allocate_mesh_data_matrix)
+    : BaseCellLinkedList(real_body, sph_adaptation), Mesh(tentative_bounds, grid_spacing, 2),
+      use_contiguous_cell_lists_(false), contiguous_cell_lists_built_(false),
+      has_tagged_cells_(false), has_entries_in_cell_lists_(false),
+      prefilter_batch_size_(max_prefilter_batch_size_)
 {
-    allocateMeshDataMatrix();
+    if (allocate_mesh_data_matrix)
+        allocateMeshDataMatrix();
     single_cell_linked_list_level_.push_back(this);
 }
 //=================================================================================================//
+ListDataVector &CellLinkedList::CellDataListWithoutMatrix(const Arrayi &cell_index)
+{
+    std::cout << "\n Error: the mesh data matrices of the cell linked list are not allocated!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
+void CellLinkedList::useContiguousCellLists()
+{
+    if (cell_data_lists_ == nullptr)
+    {
+        std::cout << "\n Error: contiguous cell lists require the mesh data matrices!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    use_contiguous_cell_lists_ = true;
+    size_t number_of_cells = all_cells_.prod();
+    StdLargeVec<std::atomic<size_t>>(number_of_cells).swap(cell_cursors_);
+    cell_offsets_.resize(number_of_cells + 1);
+}
+//=================================================================================================//
+void CellLinkedList::setPrefilterBatchSize(size_t batch_size)
+{
+    if (batch_size > max_prefilter_batch_size_)
+    {
+        std::cout << "\n Error: the prefilter batch size " << batch_size << " is larger than "
+                  << max_prefilter_batch_size_ << "!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    prefilter_batch_size_ = batch_size;
+}
+//=================================================================================================//
+void CellLinkedList::updateContiguousCellLists(BaseParticles &base_particles)
+{
+    if (has_entries_in_cell_lists_)
+    {
+        clearCellLists();
+        UpdateCellListData(base_particles);
+        has_entries_in_cell_lists_ = false;
+    }
+
+    StdLargeVec<Vecd> &pos = base_particles.pos_;
+    StdLargeVec<Real> &Vol = base_particles.Vol_;
+    size_t total_real_particles = base_particles.total_real_particles_;
+    particle_cell_.resize(total_real_particles);
+    contiguous_particle_indexes_.resize(total_real_particles);
+    contiguous_list_data_.resize(total_real_particles);
+    for (int axis = 0; axis != Dimensions; ++axis)
+        contiguous_coordinates_[axis].resize(total_real_particles);
+    size_t number_of_cells = cell_cursors_.size();
+
+    parallel_for(
+        IndexRange(0, number_of_cells),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                cell_cursors_[i].store(0, std::memory_order_relaxed);
+            }
+        },
+        ap);
+
+    // first pass: histogram of particles in cells
+    parallel_for(
+        IndexRange(0, total_real_particles),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                size_t cell = transferMeshIndexTo1D(all_cells_, CellIndexFromPosition(pos[i]));
+                particle_cell_[i] = cell;
+                cell_cursors_[cell].fetch_add(1, std::memory_order_relaxed);
+            }
+        },
+        ap);
+
+    // prefix sum for the offsets, the cursors are then set to the beginning of each cell
+    cell_offsets_[number_of_cells] =
+        particle_scan(execution::ParallelPolicy(), IndexRange(0, number_of_cells), cell_offsets_,
+                      [&](size_t i)
+                      { return cell_cursors_[i].load(std::memory_order_relaxed); });
+    parallel_for(
+        IndexRange(0, number_of_cells),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                cell_cursors_[i].store(cell_offsets_[i], std::memory_order_relaxed);
+            }
+        },
+        ap);
+
+    // second pass: scatter the particles into their cells
+    parallel_for(
+        IndexRange(0, total_real_particles),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                size_t position = cell_cursors_[particle_cell_[i]].fetch_add(1, std::memory_order_relaxed);
+                contiguous_particle_indexes_[position] = i;
+                contiguous_list_data_[position] = std::make_tuple(i, pos[i], Vol[i]);
+                for (int axis = 0; axis != Dimensions; ++axis)
+                    contiguous_coordinates_[axis][position] = pos[i][axis];
+            }
+        },
+        ap);
+
+    contiguous_cell_lists_built_ = true;
+
+    if (real_body_.getUseSplitCellLists())
+    {
+        updateContiguousSplitCellLists(real_body_.getContiguousSplitCellLists());
+    }
+}
+//=================================================================================================//
+void CellLinkedList::updateContiguousSplitCellLists(ContiguousSplitCellLists &split_cell_lists)
+{
+    // the cells of a split list are those with the same mesh index modulo 3
+    for (size_t k = 0; k != split_cell_lists.cell_ranges_.size(); ++k)
+    {
+        Arrayi split_index = transfer1DtoMeshIndex(3 * Arrayi::Ones(), k);
+        Arrayi split_cells = (all_cells_ - split_index + 2 * Arrayi::Ones()) / 3;
+        StdLargeVec<ParticlesBound> &cell_ranges = split_cell_lists.cell_ranges_[k];
+        cell_ranges.resize(split_cells.prod());
+        parallel_for(
+            IndexRange(0, cell_ranges.size()),
+            [&](const IndexRange &r)
+            {
+                for (size_t l = r.begin(); l != r.end(); ++l)
+                {
+                    Arrayi cell_index = split_index + 3 * transfer1DtoMeshIndex(split_cells, l);
+                    size_t cell = transferMeshIndexTo1D(all_cells_, cell_index);
+                    cell_ranges[l] = ParticlesBound(cell_offsets_[cell], cell_offsets_[cell + 1]);
+                }
+            },
+            ap);
+    }
+    split_cell_lists.particle_indexes_ = contiguous_particle_indexes_.data();
+    split_cell_lists.is_built_ = true;
+}
+//=================================================================================================//
 void CellLinkedList::UpdateCellLists(BaseParticles &base_particles)
 {
+    if (use_contiguous_cell_lists_ && !has_tagged_cells_)
+    {
+        updateContiguousCellLists(base_particles);
+        return;
+    }
+
+    contiguous_cell_lists_built_ = false;
+    real_body_.getContiguousSplitCellLists().is_built_ = false;
+    has_entries_in_cell_lists_ = true;
     clearCellLists();
     StdLargeVec<Vecd> &pos_n = base_particles.pos_;
     size_t total_real_particles = base_particles.total_real_particles_;
@@ -57,11 +221,201 @@ StdLargeVec<size_t> &CellLinkedList::computingSequence(BaseParticles &base_parti
     StdLargeVec<Vecd> &pos = base_particles.pos_;
     StdLargeVec<size_t> &sequence = base_particles.sequence_;
     size_t total_real_particles = base_particles.total_real_particles_;
-    particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles), [&](size_t i)
-                 { sequence[i] = transferMeshIndexToMortonOrder(CellIndexFromPosition(pos[i])); });
+    int hilbert_bits = HilbertOrderBits();
+    particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles),
+                 [&](size_t i)
+                 {
+                     sequence[i] = transferMeshIndexToCurveOrder(
+                         CellIndexFromPosition(pos[i]), space_filling_curve_, hilbert_bits);
+                 });
     return sequence;
 }
 //=================================================================================================//
+SparseCellLinkedList::SparseCellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
+                                           RealBody &real_body, SPHAdaptation &sph_adaptation)
+    : CellLinkedList(tentative_bounds, grid_spacing, real_body, sph_adaptation, false) {}
+//=================================================================================================//
+size_t SparseCellLinkedList::CellIndexTo1D(const Arrayi &cell_index)
+{
+    size_t cell_index_1d = 0;
+    for (int n = 0; n != Dimensions; ++n)
+    {
+        cell_index_1d = cell_index_1d * all_cells_[n] + cell_index[n];
+    }
+    return cell_index_1d;
+}
+//=================================================================================================//
+SparseCellLinkedList::OccupiedCell &SparseCellLinkedList::
+    findOrCreateOccupiedCell(const Arrayi &cell_index, bool is_referred)
+{
+    size_t cell_index_1d = CellIndexTo1D(cell_index);
+    auto found = occupied_cell_number_.find(cell_index_1d);
+    if (found == occupied_cell_number_.end())
+    {
+        // only the thread inserting the cell into the map allocates it, the others wait for it
+        auto inserted = occupied_cell_number_.emplace(cell_index_1d, MaxSize_t);
+        found = inserted.first;
+        if (inserted.second)
+        {
+            size_t free_cell = number_of_taken_free_cells_.fetch_add(1);
+            size_t new_cell_number = free_cell < free_cells_.size()
+                                         ? free_cells_[free_cell]
+                                         : occupied_cells_.grow_by(1) - occupied_cells_.begin();
+            OccupiedCell &new_cell = occupied_cells_[new_cell_number];
+            new_cell.cell_index_1d_ = cell_index_1d;
+            new_cell.is_in_use_ = true;
+            if (is_referred)
+                new_cell.is_referred_ = true;
+            found->second.store(new_cell_number, std::memory_order_release);
+            return new_cell;
+        }
+    }
+
+    size_t cell_number = found->second.load(std::memory_order_acquire);
+    while (cell_number == MaxSize_t)
+    {
+        std::this_thread::yield();
+        cell_number = found->second.load(std::memory_order_acquire);
+    }
+    OccupiedCell &occupied_cell = occupied_cells_[cell_number];
+    if (is_referred)
+        occupied_cell.is_referred_ = true;
+    return occupied_cell;
+}
+//=================================================================================================//
+void SparseCellLinkedList::recycleEmptyCells()
+{
+    free_cells_.erase(free_cells_.begin(),
+                      free_cells_.begin() + SMIN(number_of_taken_free_cells_.load(), free_cells_.size()));
+    number_of_taken_free_cells_ = 0;
+    for (size_t i = 0; i != occupied_cells_.size(); ++i)
+    {
+        OccupiedCell &occupied_cell = occupied_cells_[i];
+        if (occupied_cell.is_in_use_ && !occupied_cell.is_referred_ &&
+            occupied_cell.particle_indexes_.empty() && occupied_cell.list_data_.empty())
+        {
+            occupied_cell_number_.unsafe_erase(occupied_cell.cell_index_1d_);
+            occupied_cell.is_in_use_ = false;
+            ConcurrentIndexVector().swap(occupied_cell.particle_indexes_);
+            ListDataVector().swap(occupied_cell.list_data_);
+            free_cells_.push_back(i);
+        }
+    }
+}
+//=================================================================================================//
+ListDataVector &SparseCellLinkedList::CellDataListWithoutMatrix(const Arrayi &cell_index)
+{
+    auto found = occupied_cell_number_.find(CellIndexTo1D(cell_index));
+    return found != occupied_cell_number_.end() ? occupied_cells_[found->second.load()].list_data_ : empty_list_data_;
+}
+//=================================================================================================//
+ConcurrentIndexVector &SparseCellLinkedList::ParticleIndexesInCell(const Arrayi &cell_index)
+{
+    return findOrCreateOccupiedCell(cell_index, true).particle_indexes_;
+}
+//=================================================================================================//
+ListDataVector &SparseCellLinkedList::ListDataInCell(const Arrayi &cell_index)
+{
+    return findOrCreateOccupiedCell(cell_index, true).list_data_;
+}
+//=================================================================================================//
+void SparseCellLinkedList::clearCellLists()
+{
+    recycleEmptyCells();
+    parallel_for(
+        IndexRange(0, occupied_cells_.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                occupied_cells_[i].particle_indexes_.clear();
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void SparseCellLinkedList::UpdateCellListData(BaseParticles &base_particles)
+{
+    StdLargeVec<Vecd> &pos = base_particles.pos_;
+    StdLargeVec<Real> &Vol = base_particles.Vol_;
+    parallel_for(
+        IndexRange(0, occupied_cells_.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                ListDataVector &list_data = occupied_cells_[i].list_data_;
+                ConcurrentIndexVector &cell_list = occupied_cells_[i].particle_indexes_;
+                list_data.clear();
+                for (size_t s = 0; s != cell_list.size(); ++s)
+                {
+                    size_t index = cell_list[s];
+                    list_data.emplace_back(std::make_tuple(index, pos[index], Vol[index]));
+                }
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void SparseCellLinkedList::updateSplitCellLists(SplitCellLists &split_cell_lists)
+{
+    clearSplitCellLists(split_cell_lists);
+    parallel_for(
+        IndexRange(0, occupied_cells_.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                OccupiedCell &occupied_cell = occupied_cells_[i];
+                if (occupied_cell.particle_indexes_.size() != 0)
+                {
+                    Arrayi cell_index = transfer1DtoMeshIndex(all_cells_, occupied_cell.cell_index_1d_);
+                    Arrayi split_index = cell_index - 3 * (cell_index / 3);
+                    split_cell_lists[transferMeshIndexTo1D(3 * Arrayi::Ones(), split_index)]
+                        .push_back(&occupied_cell.particle_indexes_);
+                }
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void SparseCellLinkedList::insertParticleIndex(size_t particle_index, const Vecd &particle_position)
+{
+    findOrCreateOccupiedCell(CellIndexFromPosition(particle_position))
+        .particle_indexes_.emplace_back(particle_index);
+}
+//=================================================================================================//
+void SparseCellLinkedList::InsertListDataEntry(size_t particle_index, const Vecd &particle_position, Real volumetric)
+{
+    findOrCreateOccupiedCell(CellIndexFromPosition(particle_position))
+        .list_data_.emplace_back(std::make_tuple(particle_index, particle_position, volumetric));
+}
+//=================================================================================================//
+void SparseCellLinkedList::writeMeshFieldToPlt(std::ofstream &output_file)
+{
+    std::string axis_names[3] = {"x", "y", "z"};
+    output_file << "\n";
+    output_file << "title='View'"
+                << "\n";
+    output_file << "variables= ";
+    for (int n = 0; n != Dimensions; ++n)
+        output_file << axis_names[n] << ", ";
+    output_file << "particles_in_cell "
+                << "\n";
+    output_file << "zone i=" << NumberOfOccupiedCells()
+                << "  DATAPACKING=POINT  SOLUTIONTIME=" << 0 << "\n";
+
+    for (size_t i = 0; i != occupied_cells_.size(); ++i)
+    {
+        if (!occupied_cells_[i].is_in_use_)
+            continue;
+        Vecd data_position = CellPositionFromIndex(transfer1DtoMeshIndex(all_cells_, occupied_cells_[i].cell_index_1d_));
+        for (int n = 0; n != Dimensions; ++n)
+            output_file << data_position[n] << " ";
+        output_file << occupied_cells_[i].particle_indexes_.size() << " \n";
+    }
+}
+//=================================================================================================//
 MultilevelCellLinkedList::MultilevelCellLinkedList(
     BoundingBox tentative_bounds, Real reference_grid_spacing,
     size_t total_levels, RealBody &real_body, SPHAdaptation &sph_adaptation)
@@ -132,12 +486,14 @@ StdLargeVec<size_t> &MultilevelCellLinkedList::computingSequence(BaseParticles &
     StdLargeVec<Vecd> &pos = base_particles.pos_;
     StdLargeVec<size_t> &sequence = base_particles.sequence_;
     size_t total_real_particles = base_particles.total_real_particles_;
+    int hilbert_bits = mesh_levels_.back()->HilbertOrderBits();
     particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles),
                  [&](size_t i)
                  {
-						 size_t level = getMeshLevel(kernel_.CutOffRadius(h_ratio_[i]));
-						 sequence[i] = mesh_levels_[level]->transferMeshIndexToMortonOrder(
-						 mesh_levels_[level]->CellIndexFromPosition(pos[i])); });
+                     size_t level = getMeshLevel(kernel_.CutOffRadius(h_ratio_[i]));
+                     sequence[i] = mesh_levels_[level]->transferMeshIndexToCurveOrder(
+                         mesh_levels_[level]->CellIndexFromPosition(pos[i]), space_filling_curve_, hilbert_bits);
+                 });
 
     return sequence;
 }
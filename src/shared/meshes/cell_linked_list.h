@@ -35,6 +35,11 @@
 #include "base_mesh.h"
 #include "neighborhood.h"
 
+#include "tbb/concurrent_unordered_map.h"
+
+#include <array>
+#include <atomic>
+
 namespace SPH
 {
 
@@ -45,6 +50,16 @@ class Kernel;
 class SPHAdaptation;
 class CellLinkedList;
 
+/** A range of list data stored contiguously. */
+struct ListDataRange
+{
+    const ListData *first_;
+    const ListData *last_;
+    const ListData *begin() const { return first_; };
+    const ListData *end() const { return last_; };
+    size_t size() const { return last_ - first_; };
+};
+
 /**
  * @class BaseCellLinkedList
  * @brief The Abstract class for mesh cell linked list derived from BaseMeshField.
@@ -54,6 +69,7 @@ class BaseCellLinkedList : public BaseMeshField
   protected:
     RealBody &real_body_;
     Kernel &kernel_;
+    SpaceFillingCurve space_filling_curve_; /**< the curve ordering the sorted particles */
 
     /** clear split cell lists in this mesh*/
     virtual void clearSplitCellLists(SplitCellLists &split_cell_lists);
@@ -64,6 +80,11 @@ class BaseCellLinkedList : public BaseMeshField
     BaseCellLinkedList(RealBody &real_body, SPHAdaptation &sph_adaptation);
     virtual ~BaseCellLinkedList(){};
 
+    /** set the space-filling curve used for computing the sorting sequence */
+    void setSpaceFillingCurve(SpaceFillingCurve curve) { space_filling_curve_ = curve; };
+    SpaceFillingCurve getSpaceFillingCurve() { return space_filling_curve_; };
+    /** bin the particles into contiguous cell lists, only for single resolution cell linked list */
+    virtual void useContiguousCellLists(){};
     /** access concrete cell linked list levels*/
     virtual StdVec<CellLinkedList *> CellLinkedListLevels() = 0;
     /** update the cell lists */
@@ -93,20 +114,69 @@ class CellLinkedList : public BaseCellLinkedList, public Mesh
 
   protected:
     /** using concurrent vectors due to writing conflicts when building the list */
-    MeshDataMatrix<ConcurrentIndexVector> cell_index_lists_;
+    MeshDataMatrix<ConcurrentIndexVector> cell_index_lists_{nullptr};
     /** non-concurrent list data rewritten for building neighbor list */
-    MeshDataMatrix<ListDataVector> cell_data_lists_;
+    MeshDataMatrix<ListDataVector> cell_data_lists_{nullptr};
+    /**
+     * Contiguous cell lists built by two-pass binning, i.e. counting the particles in each cell,
+     * a prefix sum for the offsets of the cells and then scattering the particles.
+     * They are used instead of the cell index lists when the latter are not referred by
+     * body parts or domain bounding. The split cell lists are then given by the ranges
+     * of the cells in the contiguous lists. The cell data lists are still
+     * used for the entries inserted after binning, such as those of ghost particles.
+     */
+    bool use_contiguous_cell_lists_;
+    bool contiguous_cell_lists_built_;
+    bool has_tagged_cells_;
+    std::atomic<bool> has_entries_in_cell_lists_;
+    StdLargeVec<size_t> particle_cell_;             /**< 1D cell index of each particle */
+    StdLargeVec<std::atomic<size_t>> cell_cursors_; /**< particle count and then scatter position of each cell */
+    StdLargeVec<size_t> cell_offsets_;              /**< the beginning of each cell in the contiguous lists */
+    StdLargeVec<size_t> contiguous_particle_indexes_;
+    StdLargeVec<ListData> contiguous_list_data_;
+    /** positions in the contiguous cell lists stored by axis for the prefilter of the neighbor search */
+    std::array<StdLargeVec<Real>, Dimensions> contiguous_coordinates_;
+    static const size_t max_prefilter_batch_size_ = 64;
+    size_t prefilter_batch_size_; /**< the number of candidates compared at once, zero for no prefilter */
+
+    void updateContiguousCellLists(BaseParticles &base_particles);
+    void updateContiguousSplitCellLists(ContiguousSplitCellLists &split_cell_lists);
+    /**
+     * Compare the squared distances of a batch in the contiguous cell lists to the squared cut-off radius.
+     * Returns the number of the accepted entries, whose positions in the lists are written to accepted.
+     */
+    inline size_t prefilterContiguousListData(const Vecd &position, size_t first, size_t last,
+                                              Real cut_off_radius_sqr, size_t *accepted);
 
     void allocateMeshDataMatrix(); /**< allocate memories for addresses of data packages. */
     void deleteMeshDataMatrix();   /**< delete memories for addresses of data packages. */
     virtual void updateSplitCellLists(SplitCellLists &split_cell_lists) override;
+    /** for derived classes which store the cell lists without the dense mesh data matrices */
+    CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing, RealBody &real_body,
+                   SPHAdaptation &sph_adaptation, bool allocate_mesh_data_matrix);
+    /** list data of a cell when the dense mesh data matrices are not allocated */
+    virtual ListDataVector &CellDataListWithoutMatrix(const Arrayi &cell_index);
+    /** particle index list of a cell for tagging, the cell is allocated if necessary */
+    virtual ConcurrentIndexVector &ParticleIndexesInCell(const Arrayi &cell_index);
+    /** list data of a cell for tagging, the cell is allocated if necessary */
+    virtual ListDataVector &ListDataInCell(const Arrayi &cell_index);
 
   public:
     CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing, RealBody &real_body, SPHAdaptation &sph_adaptation);
     virtual ~CellLinkedList() { deleteMeshDataMatrix(); };
 
-    void clearCellLists();
-    void UpdateCellListData(BaseParticles &base_particles);
+    virtual void clearCellLists();
+    virtual void UpdateCellListData(BaseParticles &base_particles);
+    /** list data of a cell, used by the neighbor search */
+    inline ListDataVector &CellDataList(const Arrayi &cell_index);
+    /** list data of a cell in the contiguous cell lists, empty if they are not built */
+    inline ListDataRange ContiguousListData(const Arrayi &cell_index);
+    virtual void useContiguousCellLists() override;
+    /**
+     * Set the number of candidates in the contiguous cell lists, at most 64, whose squared distances
+     * are computed together by the prefilter of the neighbor search. Zero switches the prefilter off.
+     */
+    void setPrefilterBatchSize(size_t batch_size);
     virtual void UpdateCellLists(BaseParticles &base_particles) override;
     void insertParticleIndex(size_t particle_index, const Vecd &particle_position) override;
     void InsertListDataEntry(size_t particle_index, const Vecd &particle_position, Real volumetric) override;
@@ -121,6 +191,71 @@ class CellLinkedList : public BaseCellLinkedList, public Mesh
     template <class DynamicsRange, typename GetSearchDepth, typename GetNeighborRelation>
     void searchNeighborsByParticles(DynamicsRange &dynamics_range, ParticleConfiguration &particle_configuration,
                                     GetSearchDepth &get_search_depth, GetNeighborRelation &get_neighbor_relation);
+    /**
+     * The particle search with the candidates in the contiguous cell lists prefiltered by their squared distances,
+     * so that only those within the cut-off radius are given to the neighbor relation.
+     * The cut-off radius should not be smaller than that used by the neighbor relation.
+     */
+    template <class DynamicsRange, typename GetSearchDepth, typename GetNeighborRelation>
+    void searchNeighborsByParticles(DynamicsRange &dynamics_range, ParticleConfiguration &particle_configuration,
+                                    GetSearchDepth &get_search_depth, GetNeighborRelation &get_neighbor_relation,
+                                    Real cut_off_radius_sqr);
+    /** apply the function to the list data in the cells around a position within the search depth */
+    template <typename FunctionOnListData>
+    void searchListDataNearPosition(const Vecd &position, int search_depth, const FunctionOnListData &function);
+};
+
+/**
+ * @class SparseCellLinkedList
+ * @brief Cell linked list storing only the cells which have been occupied by particles.
+ * 		  The cells are found from their 1D index by a concurrent hash table,
+ * 		  so that the memory and the cost of updating the lists scale with
+ * 		  the occupied cells, instead of the whole domain as for CellLinkedList.
+ * 		  Cells left empty are recycled at the next update, so that the memory follows
+ * 		  the cells presently occupied instead of all cells ever visited.
+ * 		  Cells referred by body parts and domain bounding conditions are kept.
+ * 		  Tagging body parts by cells still checks all cells once at construction
+ * 		  but only allocates the tagged ones.
+ */
+class SparseCellLinkedList : public CellLinkedList
+{
+  protected:
+    struct OccupiedCell
+    {
+        size_t cell_index_1d_ = 0;
+        bool is_in_use_ = false;
+        std::atomic<bool> is_referred_{false}; /**< referred by body parts or bounding conditions */
+        ConcurrentIndexVector particle_indexes_;
+        ListDataVector list_data_;
+    };
+    /** map from the 1D cell index to the occupied cell, which is MaxSize_t while the cell is being created */
+    tbb::concurrent_unordered_map<size_t, std::atomic<size_t>> occupied_cell_number_;
+    ConcurrentVec<OccupiedCell> occupied_cells_;
+    StdVec<size_t> free_cells_;               /**< recycled cells to be used again */
+    std::atomic<size_t> number_of_taken_free_cells_{0};
+    ListDataVector empty_list_data_;
+
+    /** the same as transferMeshIndexTo1D for all cells but without integer overflow for large domains */
+    size_t CellIndexTo1D(const Arrayi &cell_index);
+    /** find the occupied cell or create it if not found, thread safe */
+    OccupiedCell &findOrCreateOccupiedCell(const Arrayi &cell_index, bool is_referred = false);
+    /** release the cells which are empty and not referred, not thread safe */
+    void recycleEmptyCells();
+    virtual ListDataVector &CellDataListWithoutMatrix(const Arrayi &cell_index) override;
+    virtual ConcurrentIndexVector &ParticleIndexesInCell(const Arrayi &cell_index) override;
+    virtual ListDataVector &ListDataInCell(const Arrayi &cell_index) override;
+    virtual void updateSplitCellLists(SplitCellLists &split_cell_lists) override;
+
+  public:
+    SparseCellLinkedList(BoundingBox tentative_bounds, Real grid_spacing, RealBody &real_body, SPHAdaptation &sph_adaptation);
+    virtual ~SparseCellLinkedList(){};
+
+    size_t NumberOfOccupiedCells() { return occupied_cell_number_.size(); };
+    virtual void clearCellLists() override;
+    virtual void UpdateCellListData(BaseParticles &base_particles) override;
+    virtual void insertParticleIndex(size_t particle_index, const Vecd &particle_position) override;
+    virtual void InsertListDataEntry(size_t particle_index, const Vecd &particle_position, Real volumetric) override;
+    virtual void writeMeshFieldToPlt(std::ofstream &output_file) override;
 };
 
 /**
@@ -152,6 +152,17 @@ class GridDataPackage : public BaseDataPackage, public BaseMesh
     /** probe by applying bi and tri-linear interpolation within the package. */
     template <typename DataType>
     DataType probeDataPackage(PackageDataAddress<DataType> &pkg_data_addrs, const Vecd &position);
+    /** lower grid index and weights of the interpolation at a position,
+     *  which can be shared by the interpolation of several variables. */
+    void interpolationStencil(const Vecd &position, Arrayi &grid_index, Vecd &alpha)
+    {
+        grid_index = CellIndexFromPosition(position);
+        alpha = (position - GridPositionFromIndex(grid_index)) / grid_spacing_;
+    };
+    /** bi and tri-linear interpolation with a given stencil. */
+    template <typename DataType>
+    DataType interpolateDataPackage(PackageDataAddress<DataType> &pkg_data_addrs,
+                                    const Arrayi &grid_index, const Vecd &alpha);
     /** assign value to data package according to the position of data */
     template <typename DataType, typename FunctionByPosition>
     void assignByPosition(const MeshVariable<DataType> &mesh_variable,
@@ -46,11 +46,13 @@ class Inner; /**< Inner interaction: interaction within a body*/
 template <typename... ContactParameters>
 class Contact; /**< Contact interaction: interaction between a body with one or several another bodies */
 
-class Boundary;        /**< Interaction with boundary */
-class Wall;            /**< Interaction with wall boundary */
-class Extended;        /**< An extened method of an interaction type */
-class SpatialTemporal; /**< A interaction considering spatial temporal correlations */
-class Dynamic;         /**< A dynamic interaction */
+class Boundary;          /**< Interaction with boundary */
+class Wall;              /**< Interaction with wall boundary */
+class Extended;          /**< An extened method of an interaction type */
+class SpatialTemporal;   /**< A interaction considering spatial temporal correlations */
+class Dynamic;           /**< A dynamic interaction */
+class Symmetric;         /**< A interaction evaluating each particle pair once for both particles */
+class LocalTimeStepping; /**< A interaction with particles advanced by their own time step sizes */
 
 /**
  * @class BaseLocalDynamics
@@ -65,7 +67,8 @@ class BaseLocalDynamics
     virtual ~BaseLocalDynamics(){};
     SPHBody &getSPHBody() { return sph_body_; };
     DynamicsIdentifier &getDynamicsIdentifier() { return identifier_; };
-    virtual void setupDynamics(Real dt = 0.0){}; // setup global parameters
+    virtual void setupDynamics(Real dt = 0.0){};  // setup global parameters
+    virtual void finishDynamics(Real dt = 0.0){}; // global operations after the sweep of SimpleDynamics
   protected:
     DynamicsIdentifier &identifier_;
     SPHBody &sph_body_ = identifier_.getSPHBody();
@@ -34,6 +34,7 @@
 #include "all_body_relations.h"
 #include "base_body.h"
 #include "base_data_package.h"
+#include "dynamics_profiler.h"
 #include "neighborhood.h"
 #include "sph_data_containers.h"
 
@@ -85,8 +86,24 @@ class BaseDynamics : public GlobalStaticVariables
   private:
     SPHBody &sph_body_;
     bool is_newly_updated_;
+
+#if SPHINXSYS_USE_PROFILING
+    ProfileRecordHandle profile_record_;
+
+  protected:
+    /** the record named by the body and the dynamics type */
+    ProfileRecord &profileRecord()
+    {
+        return profile_record_.get([&]()
+                                   { return sph_body_.getName() + ": " + profileTypeName(typeid(*this)); });
+    };
+    size_t particleBytes() { return particleDataBytes(sph_body_.getBaseParticles().getAllParticleData()); };
+#endif
 };
 
+#define SPHINXSYS_PROFILE_DYNAMICS(particles) \
+    SPHINXSYS_PROFILE_SCOPE(this->profileRecord(), particles, (particles) * this->particleBytes())
+
 /**
  * @class DataDelegateBase
  * @brief empty base class for mixin template.
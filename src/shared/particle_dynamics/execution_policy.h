@@ -30,6 +30,20 @@
 #ifndef EXECUTION_POLICY_H
 #define EXECUTION_POLICY_H
 
+/**
+ * Marks a loop for SIMD vectorization in the unsequenced policies.
+ * It is effective when built with the option SPHINXSYS_USE_SIMD.
+ */
+#if SPHINXSYS_USE_SIMD
+#if defined(_MSC_VER)
+#define SPHINXSYS_SIMD_LOOP __pragma(loop(ivdep))
+#else
+#define SPHINXSYS_SIMD_LOOP _Pragma("omp simd")
+#endif
+#else
+#define SPHINXSYS_SIMD_LOOP
+#endif
+
 namespace SPH
 {
 namespace execution
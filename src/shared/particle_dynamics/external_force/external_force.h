@@ -50,6 +50,8 @@ class ExternalForce
 /**
  * @class Gravity
  * @brief The gravity force, derived class of External force.
+ * The gravity is uniform in space, i.e. a derived class changing the acceleration at runtime
+ * may only depend on time, as GravityForce evaluates it once for all particles.
  */
 class Gravity : public ExternalForce
 {
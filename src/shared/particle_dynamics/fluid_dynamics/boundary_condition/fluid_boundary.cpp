@@ -63,39 +63,68 @@ EmitterInflowInjection::
     buffer_.checkParticlesReserved();
 }
 //=================================================================================================//
+void EmitterInflowInjection::setupDynamics(Real dt)
+{
+    number_of_injected_ = 0;
+    injected_particles_.resize(identifier_.SizeOfLoopRange());
+}
+//=================================================================================================//
 void EmitterInflowInjection::update(size_t unsorted_index_i, Real dt)
 {
     size_t sorted_index_i = sorted_id_[unsorted_index_i];
     if (aligned_box_.checkUpperBound(axis_, pos_[sorted_index_i]))
     {
-        mutex_switch_to_real_.lock();
-        buffer_.checkEnoughBuffer(*particles_);
-        /** Buffer Particle state copied from real particle. */
-        particles_->copyFromAnotherParticle(particles_->total_real_particles_, sorted_index_i);
-        /** Realize the buffer particle by increasing the number of real particle in the body.  */
-        particles_->total_real_particles_ += 1;
-        mutex_switch_to_real_.unlock();
-
-        /** Periodic bounding. */
-        pos_[sorted_index_i] = aligned_box_.getUpperPeriodic(axis_, pos_[sorted_index_i]);
-        rho_[sorted_index_i] = fluid_.ReferenceDensity();
-        p_[sorted_index_i] = fluid_.getPressure(rho_[sorted_index_i]);
+        injected_particles_[number_of_injected_++] = sorted_index_i;
     }
 }
 //=================================================================================================//
+void EmitterInflowInjection::finishDynamics(Real dt)
+{
+    size_t number_of_injected = number_of_injected_;
+    buffer_.checkEnoughBuffer(*particles_, number_of_injected);
+    /** Sorted for the new particles to be independent of the thread scheduling. */
+    std::sort(injected_particles_.begin(), injected_particles_.begin() + number_of_injected);
+    /** Buffer particle states copied from real particles. */
+    particles_->createRealParticlesFrom(injected_particles_, number_of_injected);
+
+    parallel_for(
+        IndexRange(0, number_of_injected),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                /** Periodic bounding. */
+                size_t sorted_index_i = injected_particles_[n];
+                pos_[sorted_index_i] = aligned_box_.getUpperPeriodic(axis_, pos_[sorted_index_i]);
+                rho_[sorted_index_i] = fluid_.ReferenceDensity();
+                p_[sorted_index_i] = fluid_.getPressure(rho_[sorted_index_i]);
+            }
+        },
+        ap);
+}
+//=================================================================================================//
 DisposerOutflowDeletion::
     DisposerOutflowDeletion(BodyAlignedBoxByCell &aligned_box_part, int axis)
     : BaseLocalDynamics<BodyPartByCell>(aligned_box_part), FluidDataSimple(sph_body_),
       pos_(particles_->pos_), axis_(axis), aligned_box_(aligned_box_part.aligned_box_) {}
 //=================================================================================================//
+void DisposerOutflowDeletion::setupDynamics(Real dt)
+{
+    number_of_deleted_ = 0;
+    deleted_particles_.resize(particles_->total_real_particles_);
+}
+//=================================================================================================//
 void DisposerOutflowDeletion::update(size_t index_i, Real dt)
 {
-    mutex_switch_to_buffer_.lock();
-    while (aligned_box_.checkUpperBound(axis_, pos_[index_i]) && index_i < particles_->total_real_particles_)
+    if (aligned_box_.checkUpperBound(axis_, pos_[index_i]) && index_i < particles_->total_real_particles_)
     {
-        particles_->switchToBufferParticle(index_i);
+        deleted_particles_[number_of_deleted_++] = index_i;
     }
-    mutex_switch_to_buffer_.unlock();
+}
+//=================================================================================================//
+void DisposerOutflowDeletion::finishDynamics(Real dt)
+{
+    particles_->switchToBufferParticles(deleted_particles_, number_of_deleted_);
 }
 } // namespace fluid_dynamics
 } // namespace SPH
@@ -31,7 +31,7 @@
 #define FLUID_BOUNDARY_H
 
 #include "base_fluid_dynamics.h"
-#include <mutex>
+#include <atomic>
 
 namespace SPH
 {
@@ -208,6 +208,9 @@ class EmitterInflowCondition : public BaseLocalDynamics<BodyPartByParticle>, pub
  * @brief Inject particles into the computational domain.
  * Note that the axis is at the local coordinate and upper bound direction is
  * the local positive direction.
+ * The particles passing the upper bound are only marked during the particle sweep,
+ * and the injection is carried out for all marked particles after the sweep.
+ * It is executed by SimpleDynamics, which calls finishDynamics after the sweep.
  */
 class EmitterInflowInjection : public BaseLocalDynamics<BodyPartByParticle>, public FluidDataSimple
 {
@@ -215,10 +218,13 @@ class EmitterInflowInjection : public BaseLocalDynamics<BodyPartByParticle>, pub
     EmitterInflowInjection(BodyAlignedBoxByParticle &aligned_box_part, ParticleBuffer<Base> &buffer, int axis);
     virtual ~EmitterInflowInjection(){};
 
+    virtual void setupDynamics(Real dt = 0.0) override;
     void update(size_t unsorted_index_i, Real dt = 0.0);
+    virtual void finishDynamics(Real dt = 0.0) override;
 
   protected:
-    std::mutex mutex_switch_to_real_; /**< mutex exclusion for memory conflict */
+    std::atomic<size_t> number_of_injected_;  /**< number of particles marked for injection */
+    StdLargeVec<size_t> injected_particles_; /**< indices of the particles marked for injection */
     Fluid &fluid_;
     StdLargeVec<Vecd> &pos_;
     StdLargeVec<Real> &rho_, &p_;
@@ -230,6 +236,9 @@ class EmitterInflowInjection : public BaseLocalDynamics<BodyPartByParticle>, pub
 /**
  * @class DisposerOutflowDeletion
  * @brief Delete particles who ruing out the computational domain.
+ * The particles are only marked during the particle sweep,
+ * and all marked particles are switched to buffer particles after the sweep.
+ * It is executed by SimpleDynamics, which calls finishDynamics after the sweep.
  */
 class DisposerOutflowDeletion : public BaseLocalDynamics<BodyPartByCell>, public FluidDataSimple
 {
@@ -237,10 +246,13 @@ class DisposerOutflowDeletion : public BaseLocalDynamics<BodyPartByCell>, public
     DisposerOutflowDeletion(BodyAlignedBoxByCell &aligned_box_part, int axis);
     virtual ~DisposerOutflowDeletion(){};
 
+    virtual void setupDynamics(Real dt = 0.0) override;
     void update(size_t index_i, Real dt = 0.0);
+    virtual void finishDynamics(Real dt = 0.0) override;
 
   protected:
-    std::mutex mutex_switch_to_buffer_; /**< mutex exclusion for memory conflict */
+    std::atomic<size_t> number_of_deleted_; /**< number of particles marked for deletion */
+    StdLargeVec<size_t> deleted_particles_; /**< indices of the particles marked for deletion */
     StdLargeVec<Vecd> &pos_;
     const int axis_; /**< the axis direction for bounding*/
     AlignedBoxShape &aligned_box_;
@@ -87,6 +87,59 @@ using Integration1stHalfInnerNoRiemann = Integration1stHalf<Inner<>, NoRiemannSo
 using Integration1stHalfInnerRiemann = Integration1stHalf<Inner<>, AcousticRiemannSolver, NoKernelCorrection>;
 using Integration1stHalfCorrectionInnerRiemann = Integration1stHalf<Inner<>, AcousticRiemannSolver, LinearGradientCorrection>;
 
+/**
+ * @class Integration1stHalf<Inner<Symmetric>, RiemannSolverType, KernelCorrectionType>
+ * @brief The pressure relaxation evaluating each particle pair once from a SymmetricInnerRelation.
+ * It is used with InteractionSymmetric instead of Dynamics1Level.
+ */
+template <class RiemannSolverType, class KernelCorrectionType>
+class Integration1stHalf<Inner<Symmetric>, RiemannSolverType, KernelCorrectionType>
+    : public Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>
+{
+  public:
+    explicit Integration1stHalf(SymmetricInnerRelation &inner_relation);
+    virtual ~Integration1stHalf(){};
+    void initialization(size_t index_i, Real dt = 0.0);
+    void interaction(size_t index_i, Real dt = 0.0);
+
+  protected:
+    StdLargeVec<Real> &Vol_at_search_;
+};
+using Integration1stHalfSymmetricInnerRiemann = Integration1stHalf<Inner<Symmetric>, AcousticRiemannSolver, NoKernelCorrection>;
+
+/**
+ * @class Integration1stHalf<Inner<LocalTimeStepping>, RiemannSolverType, KernelCorrectionType>
+ * @brief The pressure relaxation with the time step levels of TimeStepLevels.
+ * It is used with Dynamics1LevelLocalTimeStepping instead of Dynamics1Level.
+ * The momentum of a particle pair is exchanged with the time step size of the finer particle,
+ * including the Riemann dissipation which is not computed in the second half,
+ * and an inactive particle receives the momentum from its active neighbors at the interface.
+ * As the pair is weighted by the present volumes of both particles,
+ * the momentum is conserved across the levels.
+ */
+template <class RiemannSolverType, class KernelCorrectionType>
+class Integration1stHalf<Inner<LocalTimeStepping>, RiemannSolverType, KernelCorrectionType>
+    : public Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>
+{
+  public:
+    explicit Integration1stHalf(BaseInnerRelation &inner_relation);
+    virtual ~Integration1stHalf(){};
+    void interaction(size_t index_i, Real dt = 0.0);
+    void interfaceInteraction(size_t index_i, Real dt = 0.0);
+    void interfaceUpdate(size_t index_i, Real dt = 0.0);
+
+  protected:
+    StdLargeVec<Real> &Vol_at_search_;
+    StdLargeVec<int> &time_step_level_;
+    int &active_level_;
+    Real &coarse_time_step_size_;
+    StdLargeVec<Vecd> &interface_impulse_;
+
+    Vecd pairImpulse(size_t index_i, size_t index_j, Real dW_ijV_j, const Vecd &e_ij);
+};
+using Integration1stHalfLocalTimeSteppingInnerRiemann =
+    Integration1stHalf<Inner<LocalTimeStepping>, AcousticRiemannSolver, NoKernelCorrection>;
+
 // The following is used to avoid the C3200 error triggered in Visual Studio.
 // Please refer: https://developercommunity.visualstudio.com/t/c-invalid-template-argument-for-template-parameter/831128
 using BaseIntegrationWithWall = InteractionWithWall<BaseIntegration>;
@@ -128,6 +181,9 @@ using Integration1stHalfWithWallNoRiemann = Integration1stHalfWithWall<NoRiemann
 using Integration1stHalfWithWallRiemann = Integration1stHalfWithWall<AcousticRiemannSolver, NoKernelCorrection>;
 using Integration1stHalfCorrectionWithWallRiemann = Integration1stHalfWithWall<AcousticRiemannSolver, LinearGradientCorrection>;
 
+using Integration1stHalfLocalTimeSteppingWithWallRiemann =
+    ComplexInteraction<Integration1stHalf<Inner<LocalTimeStepping>, Contact<Wall>>, AcousticRiemannSolver, NoKernelCorrection>;
+
 using MultiPhaseIntegration1stHalfWithWallRiemann =
     ComplexInteraction<Integration1stHalf<Inner<>, Contact<>, Contact<Wall>>, AcousticRiemannSolver, NoKernelCorrection>;
 
@@ -155,6 +211,46 @@ using Integration2ndHalfInnerRiemann = Integration2ndHalf<Inner<>, AcousticRiema
 using Integration2ndHalfInnerNoRiemann = Integration2ndHalf<Inner<>, NoRiemannSolver>;
 using Integration2ndHalfInnerDissipativeRiemann = Integration2ndHalf<Inner<>, DissipativeRiemannSolver>;
 
+/**
+ * @class Integration2ndHalf<Inner<Symmetric>, RiemannSolverType>
+ * @brief The density relaxation evaluating each particle pair once from a SymmetricInnerRelation.
+ * It is used with InteractionSymmetric instead of Dynamics1Level.
+ */
+template <class RiemannSolverType>
+class Integration2ndHalf<Inner<Symmetric>, RiemannSolverType>
+    : public Integration2ndHalf<Inner<>, RiemannSolverType>
+{
+  public:
+    explicit Integration2ndHalf(SymmetricInnerRelation &inner_relation)
+        : Integration2ndHalf<Inner<>, RiemannSolverType>(inner_relation),
+          Vol_at_search_(inner_relation.Vol_at_search_){};
+    virtual ~Integration2ndHalf(){};
+    void initialization(size_t index_i, Real dt = 0.0);
+    void interaction(size_t index_i, Real dt = 0.0);
+
+  protected:
+    StdLargeVec<Real> &Vol_at_search_;
+};
+using Integration2ndHalfSymmetricInnerRiemann = Integration2ndHalf<Inner<Symmetric>, AcousticRiemannSolver>;
+
+/**
+ * @class Integration2ndHalf<Inner<LocalTimeStepping>, RiemannSolverType>
+ * @brief The density relaxation with the time step levels of TimeStepLevels.
+ * The Riemann dissipation of the momentum is left to the first half,
+ * where it is exchanged conservatively across the levels.
+ */
+template <class RiemannSolverType>
+class Integration2ndHalf<Inner<LocalTimeStepping>, RiemannSolverType>
+    : public Integration2ndHalf<Inner<>, RiemannSolverType>
+{
+  public:
+    explicit Integration2ndHalf(BaseInnerRelation &inner_relation)
+        : Integration2ndHalf<Inner<>, RiemannSolverType>(inner_relation){};
+    virtual ~Integration2ndHalf(){};
+    void interaction(size_t index_i, Real dt = 0.0);
+};
+using Integration2ndHalfLocalTimeSteppingInnerRiemann = Integration2ndHalf<Inner<LocalTimeStepping>, AcousticRiemannSolver>;
+
 template <class RiemannSolverType>
 class Integration2ndHalf<Contact<Wall>, RiemannSolverType>
     : public BaseIntegrationWithWall
@@ -189,6 +285,9 @@ using Integration2ndHalfWithWall = ComplexInteraction<Integration2ndHalf<Inner<>
 using Integration2ndHalfWithWallNoRiemann = Integration2ndHalfWithWall<NoRiemannSolver>;
 using Integration2ndHalfWithWallRiemann = Integration2ndHalfWithWall<AcousticRiemannSolver>;
 
+using Integration2ndHalfLocalTimeSteppingWithWallRiemann =
+    ComplexInteraction<Integration2ndHalf<Inner<LocalTimeStepping>, Contact<Wall>>, AcousticRiemannSolver>;
+
 using MultiPhaseIntegration2ndHalfWithWallRiemann =
     ComplexInteraction<Integration2ndHalf<Inner<>, Contact<>, Contact<Wall>>, AcousticRiemannSolver>;
 } // namespace fluid_dynamics
@@ -79,6 +79,112 @@ void Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>::inter
 }
 //=================================================================================================//
 template <class RiemannSolverType, class KernelCorrectionType>
+Integration1stHalf<Inner<Symmetric>, RiemannSolverType, KernelCorrectionType>::
+    Integration1stHalf(SymmetricInnerRelation &inner_relation)
+    : Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>(inner_relation),
+      Vol_at_search_(inner_relation.Vol_at_search_) {}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType>
+void Integration1stHalf<Inner<Symmetric>, RiemannSolverType, KernelCorrectionType>::
+    initialization(size_t index_i, Real dt)
+{
+    Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>::initialization(index_i, dt);
+    this->drho_dt_[index_i] = 0.0;
+}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType>
+void Integration1stHalf<Inner<Symmetric>, RiemannSolverType, KernelCorrectionType>::
+    interaction(size_t index_i, Real dt)
+{
+    Vecd force = Vecd::Zero();
+    Real rho_dissipation(0);
+    const Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        Real dW_ijV_j = inner_neighborhood.dW_ijV_j_[n];
+        Real dW_ijV_i = dW_ijV_j * Vol_at_search_[index_i] / Vol_at_search_[index_j];
+        const Vecd &e_ij = inner_neighborhood.e_ij_[n];
+
+        Vecd pair_force = (this->p_[index_i] * this->correction_(index_i) +
+                           this->p_[index_j] * this->correction_(index_j)) *
+                          e_ij;
+        Real u_dissipation = this->riemann_solver_.DissipativeUJump(this->p_[index_i] - this->p_[index_j]);
+
+        force -= pair_force * dW_ijV_j;
+        rho_dissipation += u_dissipation * dW_ijV_j;
+        this->force_[index_j] += this->mass_[index_j] * pair_force * dW_ijV_i / this->rho_[index_j];
+        this->drho_dt_[index_j] -= u_dissipation * dW_ijV_i * this->rho_[index_j];
+    }
+    this->force_[index_i] += this->mass_[index_i] * force / this->rho_[index_i];
+    this->drho_dt_[index_i] += rho_dissipation * this->rho_[index_i];
+}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType>
+Integration1stHalf<Inner<LocalTimeStepping>, RiemannSolverType, KernelCorrectionType>::
+    Integration1stHalf(BaseInnerRelation &inner_relation)
+    : Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>(inner_relation),
+      Vol_at_search_(*this->particles_->template registerSharedVariable<Real>("VolumeAtNeighborSearch")),
+      time_step_level_(*this->particles_->template registerSharedVariable<int>("TimeStepLevel")),
+      active_level_(*this->particles_->template registerSingleVariable<int>("ActiveTimeStepLevel")),
+      coarse_time_step_size_(*this->particles_->template registerSingleVariable<Real>("CoarseTimeStepSize")),
+      interface_impulse_(*this->particles_->template registerSharedVariable<Vecd>("InterfaceImpulse")) {}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType>
+Vecd Integration1stHalf<Inner<LocalTimeStepping>, RiemannSolverType, KernelCorrectionType>::
+    pairImpulse(size_t index_i, size_t index_j, Real dW_ijV_j, const Vecd &e_ij)
+{
+    Real dt_ij = std::ldexp(coarse_time_step_size_, -SMAX(time_step_level_[index_i], time_step_level_[index_j]));
+    Real pair_volume = this->mass_[index_i] / this->rho_[index_i] * this->mass_[index_j] / this->rho_[index_j];
+    Real u_jump = (this->vel_[index_i] - this->vel_[index_j]).dot(e_ij);
+    return (this->riemann_solver_.DissipativePJump(u_jump) -
+            (this->p_[index_i] * this->correction_(index_i) + this->p_[index_j] * this->correction_(index_j))) *
+           pair_volume * dW_ijV_j / Vol_at_search_[index_j] * e_ij * dt_ij;
+}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType>
+void Integration1stHalf<Inner<LocalTimeStepping>, RiemannSolverType, KernelCorrectionType>::
+    interaction(size_t index_i, Real dt)
+{
+    Vecd impulse = Vecd::Zero();
+    Real rho_dissipation(0);
+    const Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        Real dW_ijV_j = inner_neighborhood.dW_ijV_j_[n];
+        const Vecd &e_ij = inner_neighborhood.e_ij_[n];
+
+        impulse += pairImpulse(index_i, index_j, dW_ijV_j, e_ij);
+        rho_dissipation += this->riemann_solver_.DissipativeUJump(this->p_[index_i] - this->p_[index_j]) * dW_ijV_j;
+    }
+    this->force_[index_i] += impulse / dt;
+    this->drho_dt_[index_i] = rho_dissipation * this->rho_[index_i];
+}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType>
+void Integration1stHalf<Inner<LocalTimeStepping>, RiemannSolverType, KernelCorrectionType>::
+    interfaceInteraction(size_t index_i, Real dt)
+{
+    Vecd impulse = Vecd::Zero();
+    const Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        if (time_step_level_[index_j] >= active_level_)
+            impulse += pairImpulse(index_i, index_j, inner_neighborhood.dW_ijV_j_[n], inner_neighborhood.e_ij_[n]);
+    }
+    interface_impulse_[index_i] = impulse;
+}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType>
+void Integration1stHalf<Inner<LocalTimeStepping>, RiemannSolverType, KernelCorrectionType>::
+    interfaceUpdate(size_t index_i, Real dt)
+{
+    this->vel_[index_i] += interface_impulse_[index_i] / this->mass_[index_i];
+}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType>
 Integration1stHalf<Contact<Wall>, RiemannSolverType, KernelCorrectionType>::
     Integration1stHalf(BaseContactRelation &wall_contact_relation)
     : BaseIntegrationWithWall(wall_contact_relation),
@@ -193,6 +299,53 @@ void Integration2ndHalf<Inner<>, RiemannSolverType>::interaction(size_t index_i,
 };
 //=================================================================================================//
 template <class RiemannSolverType>
+void Integration2ndHalf<Inner<Symmetric>, RiemannSolverType>::initialization(size_t index_i, Real dt)
+{
+    Integration2ndHalf<Inner<>, RiemannSolverType>::initialization(index_i, dt);
+    this->force_[index_i] = Vecd::Zero();
+}
+//=================================================================================================//
+template <class RiemannSolverType>
+void Integration2ndHalf<Inner<Symmetric>, RiemannSolverType>::interaction(size_t index_i, Real dt)
+{
+    Real density_change_rate(0);
+    Vecd p_dissipation = Vecd::Zero();
+    const Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        const Vecd &e_ij = inner_neighborhood.e_ij_[n];
+        Real dW_ijV_j = inner_neighborhood.dW_ijV_j_[n];
+        Real dW_ijV_i = dW_ijV_j * Vol_at_search_[index_i] / Vol_at_search_[index_j];
+
+        Real u_jump = (this->vel_[index_i] - this->vel_[index_j]).dot(e_ij);
+        Vecd pair_dissipation = this->riemann_solver_.DissipativePJump(u_jump) * e_ij;
+
+        density_change_rate += u_jump * dW_ijV_j;
+        p_dissipation += pair_dissipation * dW_ijV_j;
+        this->drho_dt_[index_j] += u_jump * dW_ijV_i * this->rho_[index_j];
+        this->force_[index_j] -= this->mass_[index_j] * pair_dissipation * dW_ijV_i / this->rho_[index_j];
+    }
+    this->drho_dt_[index_i] += density_change_rate * this->rho_[index_i];
+    this->force_[index_i] += this->mass_[index_i] * p_dissipation / this->rho_[index_i];
+};
+//=================================================================================================//
+template <class RiemannSolverType>
+void Integration2ndHalf<Inner<LocalTimeStepping>, RiemannSolverType>::interaction(size_t index_i, Real dt)
+{
+    Real density_change_rate(0);
+    const Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        density_change_rate += (this->vel_[index_i] - this->vel_[index_j]).dot(inner_neighborhood.e_ij_[n]) *
+                               inner_neighborhood.dW_ijV_j_[n];
+    }
+    this->drho_dt_[index_i] += density_change_rate * this->rho_[index_i];
+    this->force_[index_i] = Vecd::Zero();
+}
+//=================================================================================================//
+template <class RiemannSolverType>
 Integration2ndHalf<Contact<Wall>, RiemannSolverType>::
     Integration2ndHalf(BaseContactRelation &wall_contact_relation)
     : BaseIntegrationWithWall(wall_contact_relation),
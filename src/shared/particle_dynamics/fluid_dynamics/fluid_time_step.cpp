@@ -29,6 +29,27 @@ Real AcousticTimeStepSize::outputResult(Real reduced_value)
     return acousticCFL_ * smoothing_length_min_ / (reduced_value + TinyReal);
 }
 //=================================================================================================//
+LocalAcousticTimeStepSize::LocalAcousticTimeStepSize(SPHBody &sph_body, Real acousticCFL)
+    : LocalDynamicsReduce<ReduceMin>(sph_body),
+      FluidDataSimple(sph_body), fluid_(DynamicCast<Fluid>(this, particles_->getBaseMaterial())),
+      sph_adaptation_(*sph_body.sph_adaptation_),
+      rho_(particles_->rho_), p_(*particles_->getVariableByName<Real>("Pressure")),
+      mass_(particles_->mass_), vel_(particles_->vel_),
+      force_(particles_->force_), force_prior_(particles_->force_prior_),
+      local_time_step_size_(*particles_->registerSharedVariable<Real>("LocalTimeStepSize")),
+      smoothing_length_ref_(sph_body.sph_adaptation_->ReferenceSmoothingLength()),
+      acousticCFL_(acousticCFL) {}
+//=================================================================================================//
+Real LocalAcousticTimeStepSize::reduce(size_t index_i, Real dt)
+{
+    Real smoothing_length = smoothing_length_ref_ / sph_adaptation_.SmoothingLengthRatio(index_i);
+    Real acceleration_scale = 4.0 * smoothing_length *
+                              (force_[index_i] + force_prior_[index_i]).norm() / mass_[index_i];
+    Real signal_speed = SMAX(fluid_.getSoundSpeed(p_[index_i], rho_[index_i]) + vel_[index_i].norm(), acceleration_scale);
+    local_time_step_size_[index_i] = acousticCFL_ * smoothing_length / (signal_speed + TinyReal);
+    return local_time_step_size_[index_i];
+}
+//=================================================================================================//
 AdvectionTimeStepSizeForImplicitViscosity::
     AdvectionTimeStepSizeForImplicitViscosity(SPHBody &sph_body, Real U_ref, Real advectionCFL)
     : LocalDynamicsReduce<ReduceMax>(sph_body),
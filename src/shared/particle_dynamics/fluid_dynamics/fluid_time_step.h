@@ -58,6 +58,28 @@ class AcousticTimeStepSize : public LocalDynamicsReduce<ReduceMax>, public Fluid
     Real acousticCFL_;
 };
 
+/**
+ * @class LocalAcousticTimeStepSize
+ * @brief Computing the acoustic time step size of each particle with its own smoothing length,
+ * which is stored for assigning the time step levels, and the minimum over the body.
+ */
+class LocalAcousticTimeStepSize : public LocalDynamicsReduce<ReduceMin>, public FluidDataSimple
+{
+  public:
+    explicit LocalAcousticTimeStepSize(SPHBody &sph_body, Real acousticCFL = 0.6);
+    virtual ~LocalAcousticTimeStepSize(){};
+    Real reduce(size_t index_i, Real dt = 0.0);
+
+  protected:
+    Fluid &fluid_;
+    SPHAdaptation &sph_adaptation_;
+    StdLargeVec<Real> &rho_, &p_, &mass_;
+    StdLargeVec<Vecd> &vel_, &force_, &force_prior_;
+    StdLargeVec<Real> &local_time_step_size_;
+    Real smoothing_length_ref_;
+    Real acousticCFL_;
+};
+
 /**
  * @class AdvectionTimeStepSizeForImplicitViscosity
  * @brief Computing the advection time step size when viscosity is handled implicitly
@@ -94,6 +94,30 @@ class ViscousForce<Inner<>, ViscosityType>
 };
 using ViscousForceInner = ViscousForce<Inner<>, FixedViscosity>;
 
+/**
+ * @class ViscousForce<Inner<Symmetric>, ViscosityType>
+ * @brief The viscous force evaluating each particle pair once from a SymmetricInnerRelation.
+ * It is used with InteractionSymmetric instead of InteractionWithUpdate.
+ */
+template <typename ViscosityType>
+class ViscousForce<Inner<Symmetric>, ViscosityType>
+    : public ViscousForce<FluidDataInner>, public ForcePrior
+{
+  public:
+    explicit ViscousForce(SymmetricInnerRelation &inner_relation)
+        : ViscousForce<FluidDataInner>(inner_relation),
+          ForcePrior(&base_particles_, "ViscousForce"),
+          mu_(&base_particles_), Vol_at_search_(inner_relation.Vol_at_search_){};
+    virtual ~ViscousForce(){};
+    void initialization(size_t index_i, Real dt = 0.0);
+    void interaction(size_t index_i, Real dt = 0.0);
+
+  protected:
+    ViscosityType mu_;
+    StdLargeVec<Real> &Vol_at_search_;
+};
+using ViscousForceSymmetricInner = ViscousForce<Inner<Symmetric>, FixedViscosity>;
+
 template <typename ViscosityType>
 class ViscousForce<Inner<AngularConservative>, ViscosityType>
     : public ViscousForce<FluidDataInner>, public ForcePrior
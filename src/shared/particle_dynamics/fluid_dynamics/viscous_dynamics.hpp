@@ -43,6 +43,33 @@ void ViscousForce<Inner<>, ViscosityType>::interaction(size_t index_i, Real dt)
 }
 //=================================================================================================//
 template <typename ViscosityType>
+void ViscousForce<Inner<Symmetric>, ViscosityType>::initialization(size_t index_i, Real dt)
+{
+    viscous_force_[index_i] = Vecd::Zero();
+}
+//=================================================================================================//
+template <typename ViscosityType>
+void ViscousForce<Inner<Symmetric>, ViscosityType>::interaction(size_t index_i, Real dt)
+{
+    Vecd force = Vecd::Zero();
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        Real dW_ijV_j = inner_neighborhood.dW_ijV_j_[n];
+        Real dW_ijV_i = dW_ijV_j * Vol_at_search_[index_i] / Vol_at_search_[index_j];
+
+        // viscous force
+        Vecd vel_derivative = (vel_[index_i] - vel_[index_j]) / (inner_neighborhood.r_ij_[n] + 0.01 * smoothing_length_);
+        Vecd pair_force = 2.0 * mu_(index_i, index_j) * vel_derivative;
+        force += pair_force * dW_ijV_j;
+        viscous_force_[index_j] -= mass_[index_j] * pair_force * dW_ijV_i / rho_[index_j];
+    }
+
+    viscous_force_[index_i] += mass_[index_i] * force / rho_[index_i];
+}
+//=================================================================================================//
+template <typename ViscosityType>
 void ViscousForce<Inner<AngularConservative>, ViscosityType>::interaction(size_t index_i, Real dt)
 {
     Vecd force = Vecd::Zero();
@@ -40,4 +40,5 @@
 #include "general_reduce.h"
 #include "general_refinement.h"
 #include "kernel_correction.hpp"
+#include "local_time_stepping.h"
 #include "particle_smoothing.hpp"
\ No newline at end of file
@@ -16,54 +16,60 @@ PeriodicConditionUsingCellLinkedList::PeriodicCellLinkedList::
       cell_linked_list_(real_body.getCellLinkedList()) {}
 //=================================================================================================//
 void PeriodicConditionUsingCellLinkedList::
-    PeriodicCellLinkedList::checkUpperBound(ListDataVector &cell_list_data, Real dt)
+    PeriodicCellLinkedList::insertGhostEntries(DataListsInCells &bound_cells, bool is_lower_bound)
 {
-    for (size_t num = 0; num < cell_list_data.size(); ++num)
+    Vecd translation = is_lower_bound ? periodic_translation_ : Vecd(-periodic_translation_);
+    auto is_ghost_needed = [&](const Vecd &position)
+    { return is_lower_bound ? isWithinLowerGhostLayer(position) : isWithinUpperGhostLayer(position); };
+
+    auto count_ghosts = [&](ListDataVector &cell_list_data)
     {
-        Vecd particle_position = std::get<1>(cell_list_data[num]);
-        if (particle_position[axis_] < bounding_bounds_.second_[axis_] &&
-            particle_position[axis_] > (bounding_bounds_.second_[axis_] - cut_off_radius_max_))
+        size_t count = 0;
+        for (size_t num = 0; num < cell_list_data.size(); ++num)
+            if (is_ghost_needed(std::get<1>(cell_list_data[num])))
+                ++count;
+        return count;
+    };
+    size_t number_of_ghosts = computeCellOffsets(bound_cells, cell_offsets_, count_ghosts);
+
+    ghost_entries_.resize(number_of_ghosts);
+    parallel_for(
+        IndexRange(0, bound_cells.size()),
+        [&](const IndexRange &r)
         {
-            Vecd translated_position = particle_position - periodic_translation_;
-            /** insert ghost particle to cell linked list */
-            mutex_cell_list_entry_.lock();
-            cell_linked_list_.InsertListDataEntry(std::get<0>(cell_list_data[num]),
-                                                  translated_position, std::get<2>(cell_list_data[num]));
-            mutex_cell_list_entry_.unlock();
-        }
-    }
-}
-//=================================================================================================//
-void PeriodicConditionUsingCellLinkedList::
-    PeriodicCellLinkedList::checkLowerBound(ListDataVector &cell_list_data, Real dt)
-{
-    for (size_t num = 0; num < cell_list_data.size(); ++num)
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                ListDataVector &cell_list_data = *bound_cells[i];
+                size_t entry_index = cell_offsets_[i];
+                for (size_t num = 0; num < cell_list_data.size(); ++num)
+                {
+                    Vecd particle_position = std::get<1>(cell_list_data[num]);
+                    if (is_ghost_needed(particle_position))
+                    {
+                        ghost_entries_[entry_index] = std::make_tuple(std::get<0>(cell_list_data[num]),
+                                                                      particle_position + translation,
+                                                                      std::get<2>(cell_list_data[num]));
+                        ++entry_index;
+                    }
+                }
+            }
+        },
+        ap);
+
+    /** insert ghost particles to cell linked list */
+    for (size_t n = 0; n != number_of_ghosts; ++n)
     {
-        Vecd particle_position = std::get<1>(cell_list_data[num]);
-        if (particle_position[axis_] > bounding_bounds_.first_[axis_] &&
-            particle_position[axis_] < (bounding_bounds_.first_[axis_] + cut_off_radius_max_))
-        {
-            Vecd translated_position = particle_position + periodic_translation_;
-            /** insert ghost particle to cell linked list */
-            mutex_cell_list_entry_.lock();
-            cell_linked_list_.InsertListDataEntry(std::get<0>(cell_list_data[num]),
-                                                  translated_position, std::get<2>(cell_list_data[num]));
-            mutex_cell_list_entry_.unlock();
-        }
+        cell_linked_list_.InsertListDataEntry(std::get<0>(ghost_entries_[n]),
+                                              std::get<1>(ghost_entries_[n]), std::get<2>(ghost_entries_[n]));
     }
 }
 //=================================================================================================//
 void PeriodicConditionUsingCellLinkedList::PeriodicCellLinkedList::exec(Real dt)
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), 0, 0);
     setupDynamics(dt);
-
-    particle_for(execution::ParallelPolicy(), bound_cells_data_[0].second,
-                 [&](ListDataVector *cell_ist)
-                 { checkLowerBound(*cell_ist, dt); });
-
-    particle_for(execution::ParallelPolicy(), bound_cells_data_[1].second,
-                 [&](ListDataVector *cell_ist)
-                 { checkUpperBound(*cell_ist, dt); });
+    insertGhostEntries(bound_cells_data_[0].second, true);
+    insertGhostEntries(bound_cells_data_[1].second, false);
 }
 //=================================================================================================//
 } // namespace SPH
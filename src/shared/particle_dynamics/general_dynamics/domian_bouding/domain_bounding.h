@@ -105,6 +105,43 @@ class BasePeriodicCondition
                 pos_[index_i][axis_] -= periodic_translation_[axis_];
         };
 
+        bool isWithinLowerGhostLayer(const Vecd &position)
+        {
+            return position[axis_] > bounding_bounds_.first_[axis_] &&
+                   position[axis_] < (bounding_bounds_.first_[axis_] + cut_off_radius_max_);
+        };
+
+        bool isWithinUpperGhostLayer(const Vecd &position)
+        {
+            return position[axis_] < bounding_bounds_.second_[axis_] &&
+                   position[axis_] > (bounding_bounds_.second_[axis_] - cut_off_radius_max_);
+        };
+
+        /** Offsets of the first selected entry in each cell given by an exclusive prefix sum
+         *  of the numbers of selected entries in the cells. The selected entries are then
+         *  staged in parallel and in cell order without locking. Return the total number. */
+        template <class CellListsType, typename CountInCell>
+        size_t computeCellOffsets(const CellListsType &cell_lists, StdLargeVec<size_t> &cell_offsets,
+                                  const CountInCell &count_in_cell)
+        {
+            size_t number_of_cells = cell_lists.size();
+            cell_offsets.resize(number_of_cells + 1);
+            cell_offsets[0] = 0;
+            parallel_for(
+                IndexRange(0, number_of_cells),
+                [&](const IndexRange &r)
+                {
+                    for (size_t i = r.begin(); i != r.end(); ++i)
+                    {
+                        cell_offsets[i + 1] = count_in_cell(*cell_lists[i]);
+                    }
+                },
+                ap);
+            for (size_t i = 0; i != number_of_cells; ++i)
+                cell_offsets[i + 1] += cell_offsets[i];
+            return cell_offsets[number_of_cells];
+        };
+
       public:
         PeriodicBounding(StdVec<CellLists> &bound_cells_data,
                          RealBody &real_body, PeriodicAlongAxis &periodic_box)
@@ -118,6 +155,7 @@ class BasePeriodicCondition
 
         virtual void exec(Real dt = 0.0) override
         {
+            SPHINXSYS_PROFILE_SCOPE(profileRecord(), 0, 0);
             setupDynamics(dt);
 
             particle_for(ExecutionPolicy(), bound_cells_data_[0].first,
@@ -145,11 +183,12 @@ class PeriodicConditionUsingCellLinkedList : public BasePeriodicCondition<execut
     class PeriodicCellLinkedList : public PeriodicBounding
     {
       protected:
-        std::mutex mutex_cell_list_entry_; /**< mutex exclusion for memory conflict */
         BaseCellLinkedList &cell_linked_list_;
+        StdLargeVec<size_t> cell_offsets_;
+        ListDataVector ghost_entries_; /**< staged entries to be inserted into the cell linked list */
 
-        virtual void checkLowerBound(ListDataVector &cell_list_data, Real dt = 0.0);
-        virtual void checkUpperBound(ListDataVector &cell_list_data, Real dt = 0.0);
+        /** stage the translated entries near the bound in cell order and then insert them */
+        void insertGhostEntries(DataListsInCells &bound_cells, bool is_lower_bound);
 
       public:
         PeriodicCellLinkedList(StdVec<CellLists> &bound_cells_data,
@@ -53,50 +53,57 @@ void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::setupDyn
 //=================================================================================================//
 void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::exec(Real dt)
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), 0, 0);
     setupDynamics(dt);
-
-    particle_for(execution::ParallelPolicy(), bound_cells_data_[0].first,
-                 [&](size_t i)
-                 { checkLowerBound(i, dt); });
-
-    particle_for(execution::ParallelPolicy(), bound_cells_data_[1].first,
-                 [&](size_t i)
-                 { checkUpperBound(i, dt); });
+    createGhostParticles(bound_cells_data_[0].first, lower_ghost_bound_, true);
+    createGhostParticles(bound_cells_data_[1].first, upper_ghost_bound_, false);
 }
 //=================================================================================================//
-void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::checkLowerBound(size_t index_i, Real dt)
+void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::
+    createGhostParticles(ConcurrentCellLists &bound_cells, ParticlesBound &ghost_bound, bool is_lower_bound)
 {
-    Vecd particle_position = pos_[index_i];
-    if (particle_position[axis_] > bounding_bounds_.first_[axis_] &&
-        particle_position[axis_] < (bounding_bounds_.first_[axis_] + cut_off_radius_max_))
+    Vecd translation = is_lower_bound ? periodic_translation_ : Vecd(-periodic_translation_);
+    auto is_ghost_needed = [&](size_t index_i)
+    { return is_lower_bound ? isWithinLowerGhostLayer(pos_[index_i]) : isWithinUpperGhostLayer(pos_[index_i]); };
+
+    auto count_ghosts = [&](ConcurrentIndexVector &particle_indexes)
     {
-        mutex_create_ghost_particle_.lock();
-        base_particles_.updateGhostParticle(lower_ghost_bound_.second, index_i);
-        pos_[lower_ghost_bound_.second] = particle_position + periodic_translation_;
-        /** insert ghost particle to cell linked list */
-        cell_linked_list_.InsertListDataEntry(lower_ghost_bound_.second,
-                                              pos_[lower_ghost_bound_.second], Vol_[index_i]);
-        lower_ghost_bound_.second++;
-        ghost_boundary_.checkWithinGhostSize(lower_ghost_bound_);
-        mutex_create_ghost_particle_.unlock();
-    }
-}
-//=================================================================================================//
-void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::checkUpperBound(size_t index_i, Real dt)
-{
-    Vecd particle_position = pos_[index_i];
-    if (particle_position[axis_] < bounding_bounds_.second_[axis_] &&
-        particle_position[axis_] > (bounding_bounds_.second_[axis_] - cut_off_radius_max_))
+        size_t count = 0;
+        for (size_t num = 0; num < particle_indexes.size(); ++num)
+            if (is_ghost_needed(particle_indexes[num]))
+                ++count;
+        return count;
+    };
+    size_t number_of_ghosts = computeCellOffsets(bound_cells, cell_offsets_, count_ghosts);
+    ghost_bound.second = ghost_bound.first + number_of_ghosts;
+    ghost_boundary_.checkWithinGhostSize(ghost_bound);
+
+    parallel_for(
+        IndexRange(0, bound_cells.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                ConcurrentIndexVector &particle_indexes = *bound_cells[i];
+                size_t ghost_index = ghost_bound.first + cell_offsets_[i];
+                for (size_t num = 0; num < particle_indexes.size(); ++num)
+                {
+                    size_t index_i = particle_indexes[num];
+                    if (is_ghost_needed(index_i))
+                    {
+                        base_particles_.updateGhostParticle(ghost_index, index_i);
+                        pos_[ghost_index] = pos_[index_i] + translation;
+                        ++ghost_index;
+                    }
+                }
+            }
+        },
+        ap);
+
+    /** insert ghost particles to cell linked list */
+    for (size_t ghost_index = ghost_bound.first; ghost_index != ghost_bound.second; ++ghost_index)
     {
-        mutex_create_ghost_particle_.lock();
-        base_particles_.updateGhostParticle(upper_ghost_bound_.second, index_i);
-        pos_[upper_ghost_bound_.second] = particle_position - periodic_translation_;
-        /** insert ghost particle to cell linked list */
-        cell_linked_list_.InsertListDataEntry(upper_ghost_bound_.second,
-                                              pos_[upper_ghost_bound_.second], Vol_[index_i]);
-        upper_ghost_bound_.second++;
-        ghost_boundary_.checkWithinGhostSize(upper_ghost_bound_);
-        mutex_create_ghost_particle_.unlock();
+        cell_linked_list_.InsertListDataEntry(ghost_index, pos_[ghost_index], Vol_[ghost_index]);
     }
 }
 //=================================================================================================//
@@ -123,6 +130,7 @@ void PeriodicConditionUsingGhostParticles::UpdatePeriodicGhostParticles::checkUp
 //=================================================================================================//
 void PeriodicConditionUsingGhostParticles::UpdatePeriodicGhostParticles::exec(Real dt)
 {
+    SPHINXSYS_PROFILE_SCOPE(profileRecord(), 0, 0);
     setupDynamics(dt);
 
     particle_for(execution::ParallelPolicy(), ghost_boundary_.getGhostParticleRange(lower_ghost_bound_),
@@ -70,15 +70,16 @@ class PeriodicConditionUsingGhostParticles : public BasePeriodicCondition<execut
     class CreatPeriodicGhostParticles : public PeriodicBounding
     {
       protected:
-        std::mutex mutex_create_ghost_particle_; /**< mutex exclusion for memory conflict */
         Ghost<PeriodicAlongAxis> &ghost_boundary_;
         std::pair<size_t, size_t> &lower_ghost_bound_;
         std::pair<size_t, size_t> &upper_ghost_bound_;
         BaseCellLinkedList &cell_linked_list_;
         StdLargeVec<Real> &Vol_;
+        StdLargeVec<size_t> cell_offsets_;
 
-        virtual void checkLowerBound(size_t index_i, Real dt = 0.0) override;
-        virtual void checkUpperBound(size_t index_i, Real dt = 0.0) override;
+        /** create the ghost particles near the bound in parallel, ordered by the cells
+         *  and the particles in cells, and then insert them into the cell linked list */
+        void createGhostParticles(ConcurrentCellLists &bound_cells, ParticlesBound &ghost_bound, bool is_lower_bound);
 
       public:
         CreatPeriodicGhostParticles(StdVec<CellLists> &bound_cells_data, RealBody &real_body,
@@ -12,21 +12,9 @@ ForcePrior::ForcePrior(BaseParticles *base_particles, const std::string &force_n
     base_particles->registerSortableVariable<Vecd>("Previous" + force_name);
 }
 //=================================================================================================//
-void ForcePrior::update(size_t index_i, Real dt)
-{
-    force_prior_[index_i] += current_force_[index_i] - previous_force_[index_i];
-    previous_force_[index_i] = current_force_[index_i];
-}
-//=================================================================================================//
 GravityForce::GravityForce(SPHBody &sph_body, Gravity &gravity)
     : LocalDynamics(sph_body), GeneralDataDelegateSimple(sph_body),
       ForcePrior(&base_particles_, "GravityForce"), gravity_(gravity),
-      pos_(base_particles_.pos_), mass_(base_particles_.mass_) {}
-//=================================================================================================//
-void GravityForce::update(size_t index_i, Real dt)
-{
-    current_force_[index_i] = mass_[index_i] * gravity_.InducedAcceleration(pos_[index_i]);
-    ForcePrior::update(index_i, dt);
-}
+      mass_(base_particles_.mass_), acceleration_(gravity.InducedAcceleration()) {}
 //=================================================================================================//
 } // namespace SPH
@@ -43,9 +43,20 @@ class ForcePrior
   public:
     ForcePrior(BaseParticles *base_particles, const std::string &force_name);
     virtual ~ForcePrior(){};
-    void update(size_t index_i, Real dt = 0.0);
+    void update(size_t index_i, Real dt = 0.0)
+    {
+        force_prior_[index_i] += current_force_[index_i] - previous_force_[index_i];
+        previous_force_[index_i] = current_force_[index_i];
+    };
 };
 
+/**
+ * @class GravityForce
+ * @brief The force prior due to a gravity uniform in space.
+ * The acceleration, which may depend on time, is evaluated once before each sweep,
+ * so that the update has neither branches nor virtual calls and is vectorized
+ * under the unsequenced execution policies.
+ */
 class GravityForce
     : public LocalDynamics,
       public GeneralDataDelegateSimple,
@@ -53,13 +64,18 @@ class GravityForce
 {
   protected:
     Gravity &gravity_;
-    StdLargeVec<Vecd> &pos_;
     StdLargeVec<Real> &mass_;
+    Vecd acceleration_;
 
   public:
     explicit GravityForce(SPHBody &sph_body, Gravity &gravity);
     virtual ~GravityForce(){};
-    void update(size_t index_i, Real dt = 0.0);
+    virtual void setupDynamics(Real dt = 0.0) override { acceleration_ = gravity_.InducedAcceleration(); };
+    void update(size_t index_i, Real dt = 0.0)
+    {
+        current_force_[index_i] = mass_[index_i] * acceleration_;
+        ForcePrior::update(index_i, dt);
+    };
 };
 
 } // namespace SPH
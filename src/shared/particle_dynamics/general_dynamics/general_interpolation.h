@@ -30,6 +30,7 @@
 #define GENERAL_INTERPOLATION_H
 
 #include "base_general_dynamics.h"
+#include "cell_linked_list.hpp"
 
 namespace SPH
 {
@@ -136,6 +137,106 @@ class ObservingAQuantity : public InteractionDynamics<BaseInterpolation<DataType
     };
 };
 
+/**
+ * @class BaseProbing
+ * @brief Interpolate a variable of target bodies at the particles of an observer body
+ * directly from the cell linked lists of the target bodies, without contact configuration.
+ * The interpolation is carried out only when the probing is executed,
+ * with the target particles as they are at the latest update of their cell linked lists.
+ */
+template <typename DataType>
+class BaseProbing : public LocalDynamics, public GeneralDataDelegateSimple
+{
+  public:
+    BaseProbing(SPHBody &observer, RealBodyVector target_bodies, const std::string &variable_name)
+        : LocalDynamics(observer), GeneralDataDelegateSimple(observer),
+          pos_(particles_->pos_), interpolated_quantities_(nullptr)
+    {
+        for (RealBody *target_body : target_bodies)
+        {
+            Kernel *kernel = target_body->sph_adaptation_->getKernel();
+            target_kernels_.push_back(kernel);
+            target_data_.push_back(target_body->getBaseParticles().template getVariableByName<DataType>(variable_name));
+            StdVec<CellLinkedList *> cell_linked_list_levels = target_body->getCellLinkedList().CellLinkedListLevels();
+            target_cell_linked_lists_.push_back(cell_linked_list_levels);
+            StdVec<int> search_depths;
+            for (CellLinkedList *cell_linked_list : cell_linked_list_levels)
+                search_depths.push_back(int(std::ceil(kernel->CutOffRadius() / cell_linked_list->GridSpacing())));
+            target_search_depths_.push_back(search_depths);
+        }
+    };
+    virtual ~BaseProbing(){};
+
+    void update(size_t index_i, Real dt = 0.0)
+    {
+        DataType probed_quantity = ZeroData<DataType>::value;
+        Real ttl_weight(0);
+
+        for (size_t k = 0; k != target_kernels_.size(); ++k)
+        {
+            Kernel &kernel_k = *target_kernels_[k];
+            Real cut_off_radius_sqr = kernel_k.CutOffRadiusSqr();
+            StdLargeVec<DataType> &data_k = *(target_data_[k]);
+            for (size_t l = 0; l != target_cell_linked_lists_[k].size(); ++l)
+            {
+                target_cell_linked_lists_[k][l]->searchListDataNearPosition(
+                    pos_[index_i], target_search_depths_[k][l],
+                    [&](const ListData &list_data)
+                    {
+                        Vecd displacement = pos_[index_i] - std::get<1>(list_data);
+                        Real distance_sqr = displacement.squaredNorm();
+                        if (distance_sqr < cut_off_radius_sqr)
+                        {
+                            Real weight_j = kernel_k.W(sqrt(distance_sqr), displacement) * std::get<2>(list_data);
+                            probed_quantity += weight_j * data_k[std::get<0>(list_data)];
+                            ttl_weight += weight_j;
+                        }
+                    });
+            }
+        }
+        (*interpolated_quantities_)[index_i] = probed_quantity / (ttl_weight + TinyReal);
+    };
+
+  protected:
+    StdLargeVec<Vecd> &pos_;
+    StdLargeVec<DataType> *interpolated_quantities_;
+    StdVec<Kernel *> target_kernels_;
+    StdVec<StdLargeVec<DataType> *> target_data_;
+    StdVec<StdVec<CellLinkedList *>> target_cell_linked_lists_;
+    StdVec<StdVec<int>> target_search_depths_;
+};
+
+/**
+ * @class ProbingAQuantity
+ * @brief Probing a variable of target bodies at the observer particles,
+ * an alternative to ObservingAQuantity which does not require a contact relation
+ * whose configuration has to be updated even when no observation is made.
+ */
+template <typename DataType>
+class ProbingAQuantity : public SimpleDynamics<BaseProbing<DataType>>
+{
+  public:
+    ProbingAQuantity(SPHBody &observer, RealBodyVector target_bodies, const std::string &variable_name)
+        : SimpleDynamics<BaseProbing<DataType>>(observer, target_bodies, variable_name)
+    {
+        BaseParticles *particles = this->particles_;
+        DiscreteVariable<DataType> *variable = findVariableByName<DataType>(particles->AllDiscreteVariables(), variable_name);
+        if (variable == nullptr)
+        {
+            particles->registerVariable(probed_quantities_, variable_name, ZeroData<DataType>::value);
+            this->interpolated_quantities_ = &probed_quantities_;
+        }
+        else
+        {
+            this->interpolated_quantities_ = particles->getVariableByName<DataType>(variable_name);
+        }
+    };
+    virtual ~ProbingAQuantity(){};
+
+  protected:
+    StdLargeVec<DataType> probed_quantities_;
+};
+
 /**
  * @class CorrectInterpolationKernelWeights
  * @brief  correct kernel weights for interpolation between general bodies
@@ -0,0 +1,162 @@
+#include "local_time_stepping.h"
+
+namespace SPH
+{
+//=================================================================================================//
+TimeStepLevels::TimeStepLevels(BaseInnerRelation &inner_relation, int number_of_levels)
+    : base_particles_(inner_relation.base_particles_),
+      inner_configuration_(inner_relation.inner_configuration_),
+      number_of_levels_(number_of_levels), finest_level_(0), Vol_(base_particles_.Vol_),
+      Vol_at_search_(*base_particles_.registerSharedVariable<Real>("VolumeAtNeighborSearch")),
+      local_time_step_size_(*base_particles_.registerSharedVariable<Real>("LocalTimeStepSize")),
+      time_step_level_(*base_particles_.registerSharedVariable<int>("TimeStepLevel")),
+      active_level_(base_particles_.registerSingleVariable<int>("ActiveTimeStepLevel")),
+      coarse_time_step_size_(base_particles_.registerSingleVariable<Real>("CoarseTimeStepSize")),
+      number_of_active_particles_(0), interface_begin_(0), interface_end_(0)
+{
+    if (number_of_levels_ < 1)
+    {
+        std::cout << "\n Error: the number of time step levels " << number_of_levels_ << " is less than one! \n";
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
+Real TimeStepLevels::assignLevels(Real min_time_step_size, Real max_time_step_size)
+{
+    size_t total_real_particles = base_particles_.total_real_particles_;
+    particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles),
+                 [&](size_t i)
+                 { Vol_at_search_[i] = Vol_[i]; });
+
+    Real max_level = Real(number_of_levels_ - 1);
+    Real coarsest_ratio = particle_reduce(execution::ParallelPolicy(), IndexRange(0, total_real_particles), Real(0), ReduceMax(),
+                                          [&](size_t i) -> Real
+                                          { return SMIN(std::floor(std::log2(local_time_step_size_[i] / min_time_step_size)), max_level); });
+    Real coarse_time_step_size = SMIN(std::ldexp(min_time_step_size, int(coarsest_ratio)), max_time_step_size);
+
+    particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles),
+                 [&](size_t i)
+                 {
+                     Real level = std::ceil(std::log2(coarse_time_step_size / local_time_step_size_[i]));
+                     time_step_level_[i] = int(SMIN(SMAX(level, Real(0)), max_level));
+                 });
+    smoothLevels();
+
+    int coarsest_level = int(particle_reduce(execution::ParallelPolicy(), IndexRange(0, total_real_particles), max_level, ReduceMin(),
+                                             [&](size_t i) -> Real
+                                             { return Real(time_step_level_[i]); }));
+    finest_level_ = int(particle_reduce(execution::ParallelPolicy(), IndexRange(0, total_real_particles), Real(0), ReduceMax(),
+                                        [&](size_t i) -> Real
+                                        { return Real(time_step_level_[i]); }));
+    if (coarsest_level != 0)
+    {
+        particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles),
+                     [&](size_t i)
+                     { time_step_level_[i] -= coarsest_level; });
+        coarse_time_step_size = std::ldexp(coarse_time_step_size, -coarsest_level);
+        finest_level_ -= coarsest_level;
+    }
+    *coarse_time_step_size_ = coarse_time_step_size;
+
+    sortParticlesByLevel();
+    setSubStep(0);
+    return coarse_time_step_size;
+}
+//=================================================================================================//
+void TimeStepLevels::smoothLevels()
+{
+    size_t total_real_particles = base_particles_.total_real_particles_;
+    level_temp_.resize(total_real_particles);
+    for (int pass = 1; pass < number_of_levels_; ++pass)
+    {
+        particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles),
+                     [&](size_t i)
+                     {
+                         int level = time_step_level_[i];
+                         const Neighborhood &inner_neighborhood = inner_configuration_[i];
+                         for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                             level = SMAX(level, time_step_level_[inner_neighborhood.j_[n]] - 1);
+                         level_temp_[i] = level;
+                     });
+        particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles),
+                     [&](size_t i)
+                     { time_step_level_[i] = level_temp_[i]; });
+    }
+}
+//=================================================================================================//
+void TimeStepLevels::sortParticlesByLevel()
+{
+    size_t total_real_particles = base_particles_.total_real_particles_;
+    particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles),
+                 [&](size_t i)
+                 {
+                     int is_interface = 0;
+                     const Neighborhood &inner_neighborhood = inner_configuration_[i];
+                     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                         if (time_step_level_[inner_neighborhood.j_[n]] > time_step_level_[i])
+                         {
+                             is_interface = 1;
+                             break;
+                         }
+                     level_temp_[i] = is_interface;
+                 });
+
+    sorting_offsets_.resize(total_real_particles);
+    sorted_particles_.resize(total_real_particles);
+    level_ends_.assign(finest_level_ + 1, 0);
+    size_t number_of_particles = 0;
+    for (int level = finest_level_; level >= 0; --level)
+    {
+        size_t level_begin = number_of_particles;
+        number_of_particles += particle_scan(execution::ParallelPolicy(), IndexRange(0, total_real_particles), sorting_offsets_,
+                                             [&](size_t i) -> size_t
+                                             { return time_step_level_[i] == level ? 1 : 0; });
+        level_ends_[level] = number_of_particles;
+        particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles),
+                     [&](size_t i)
+                     {
+                         if (time_step_level_[i] == level)
+                             sorted_particles_[level_begin + sorting_offsets_[i]] = i;
+                     });
+    }
+
+    interface_particles_.resize(total_real_particles);
+    interface_offsets_.assign(finest_level_ + 2, 0);
+    for (int level = 0; level <= finest_level_; ++level)
+    {
+        size_t level_begin = interface_offsets_[level];
+        interface_offsets_[level + 1] = level_begin +
+                                        particle_scan(execution::ParallelPolicy(), IndexRange(0, total_real_particles), sorting_offsets_,
+                                                      [&](size_t i) -> size_t
+                                                      { return time_step_level_[i] == level ? level_temp_[i] : 0; });
+        particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles),
+                     [&](size_t i)
+                     {
+                         if (time_step_level_[i] == level && level_temp_[i] != 0)
+                             interface_particles_[level_begin + sorting_offsets_[i]] = i;
+                     });
+    }
+    interface_particles_.resize(interface_offsets_[finest_level_ + 1]);
+}
+//=================================================================================================//
+void TimeStepLevels::setSubStep(size_t sub_step)
+{
+    int active_level = 0;
+    if (sub_step != 0)
+    {
+        int trailing_zeros = 0;
+        while ((sub_step & 1) == 0)
+        {
+            sub_step >>= 1;
+            trailing_zeros++;
+        }
+        active_level = finest_level_ - trailing_zeros;
+    }
+    *active_level_ = active_level;
+    number_of_active_particles_ = level_ends_[active_level];
+    interface_begin_ = active_level == 0 ? 0 : interface_offsets_[active_level - 1];
+    interface_end_ = active_level == 0 ? 0 : interface_offsets_[active_level];
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,196 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	local_time_stepping.h
+ * @brief 	Local time stepping, in which particles are advanced with power-of-two fractions of a coarse time step.
+ * @details The particles are grouped into time step levels from their local stable time step sizes,
+ *          given for example by fluid_dynamics::LocalAcousticTimeStepSize. A particle at level l is advanced
+ *          with the time step size dt_c / 2^l, where dt_c is the coarse time step size, so that a coarse
+ *          time step takes 2^L sub-steps for the finest level L. In a sub-step, only the particles of
+ *          the active levels are updated by Dynamics1LevelLocalTimeStepping.
+ *          Therefore, the finest or fastest particles no longer decide the time step size of the whole body.
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+
+#ifndef LOCAL_TIME_STEPPING_H
+#define LOCAL_TIME_STEPPING_H
+
+#include "base_general_dynamics.h"
+
+namespace SPH
+{
+/**
+ * @class TimeStepLevels
+ * @brief Grouping the particles of a body into power-of-two time step levels.
+ * @details The levels are assigned at the beginning of each coarse time step,
+ * after the configuration is updated. The levels of neighboring particles differ at most by one,
+ * so that a particle inactive in a sub-step only interacts with active particles of the next finer level.
+ * The time step level, the active level and the coarse time step size are registered
+ * as particle variables, so that they are available to the local dynamics.
+ */
+class TimeStepLevels
+{
+  public:
+    explicit TimeStepLevels(BaseInnerRelation &inner_relation, int number_of_levels = 4);
+    virtual ~TimeStepLevels(){};
+
+    /** assign the levels from the local time step sizes and the smallest of them,
+     * and return the coarse time step size, which is not larger than the given maximum.
+     * It is called right after the configuration is updated, as the volumes used for
+     * the neighbor search are kept for exchanging the momentum of particle pairs. */
+    Real assignLevels(Real min_time_step_size, Real max_time_step_size);
+    /** activate the levels advanced in the sub-step */
+    void setSubStep(size_t sub_step);
+    size_t NumberOfSubSteps() { return size_t(1) << finest_level_; };
+    int FinestLevel() { return finest_level_; };
+    int ActiveLevel() { return *active_level_; };
+    Real CoarseTimeStepSize() { return *coarse_time_step_size_; };
+    Real TimeStepSize(int level) { return std::ldexp(*coarse_time_step_size_, -level); };
+    int TimeStepLevel(size_t index_i) { return time_step_level_[index_i]; };
+    /** the number of particles at the level or finer */
+    size_t NumberOfParticles(int level) { return level_ends_[level]; };
+
+    /** loop over the particles of the active levels with their time step sizes */
+    template <class ExecutionPolicy, class LocalDynamicsFunction>
+    void forActiveParticles(const ExecutionPolicy &execution_policy, const LocalDynamicsFunction &local_dynamics_function)
+    {
+        particle_for(execution_policy, IndexRange(0, number_of_active_particles_),
+                     [&](size_t k)
+                     {
+                         size_t index_i = sorted_particles_[k];
+                         local_dynamics_function(index_i, TimeStepSize(time_step_level_[index_i]));
+                     });
+    };
+
+    /** loop over the inactive particles with neighbors of the active levels */
+    template <class ExecutionPolicy, class LocalDynamicsFunction>
+    void forInterfaceParticles(const ExecutionPolicy &execution_policy, const LocalDynamicsFunction &local_dynamics_function)
+    {
+        particle_for(execution_policy, IndexRange(interface_begin_, interface_end_),
+                     [&](size_t k)
+                     {
+                         size_t index_i = interface_particles_[k];
+                         local_dynamics_function(index_i, TimeStepSize(time_step_level_[index_i]));
+                     });
+    };
+
+  protected:
+    BaseParticles &base_particles_;
+    ParticleConfiguration &inner_configuration_;
+    int number_of_levels_;
+    int finest_level_;
+    StdLargeVec<Real> &Vol_, &Vol_at_search_;
+    StdLargeVec<Real> &local_time_step_size_;
+    StdLargeVec<int> &time_step_level_;
+    int *active_level_;
+    Real *coarse_time_step_size_;
+    StdLargeVec<int> level_temp_;
+    StdLargeVec<size_t> sorted_particles_;    /**< particles sorted from the finest to the coarsest level */
+    StdVec<size_t> level_ends_;               /**< the number of particles at the level or finer */
+    StdLargeVec<size_t> interface_particles_; /**< particles with a neighbor at the next finer level, sorted by level */
+    StdVec<size_t> interface_offsets_;        /**< the offsets of the interface particles of each level */
+    StdLargeVec<size_t> sorting_offsets_;     /**< the positions of the particles within their level from a prefix sum */
+    size_t number_of_active_particles_, interface_begin_, interface_end_;
+
+    void smoothLevels();
+    void sortParticlesByLevel();
+};
+
+template <class T, class = void>
+struct has_interface_interaction : std::false_type
+{
+};
+
+template <class T>
+struct has_interface_interaction<T, std::void_t<decltype(&T::interfaceInteraction)>> : std::true_type
+{
+};
+
+template <class T, class = void>
+struct has_interface_update : std::false_type
+{
+};
+
+template <class T>
+struct has_interface_update<T, std::void_t<decltype(&T::interfaceUpdate)>> : std::true_type
+{
+};
+
+/**
+ * @class Dynamics1LevelLocalTimeStepping
+ * @brief Dynamics1Level carried out only for the particles of the active time step levels,
+ * each with the time step size of its level. The time step size given to exec is not used.
+ * If the local dynamics has interfaceInteraction and interfaceUpdate, they are carried out
+ * for the inactive particles with active neighbors, e.g. for exchanging momentum conservatively.
+ */
+template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
+class Dynamics1LevelLocalTimeStepping : public InteractionDynamics<LocalDynamicsType, ExecutionPolicy>
+{
+  public:
+    template <typename... Args>
+    Dynamics1LevelLocalTimeStepping(TimeStepLevels &time_step_levels, Args &&...args)
+        : InteractionDynamics<LocalDynamicsType, ExecutionPolicy>(false, std::forward<Args>(args)...),
+          time_step_levels_(time_step_levels){};
+    virtual ~Dynamics1LevelLocalTimeStepping(){};
+
+    virtual void exec(Real dt = 0.0) override
+    {
+        SPHINXSYS_PROFILE_DYNAMICS(time_step_levels_.NumberOfParticles(time_step_levels_.ActiveLevel()));
+        this->setUpdated();
+        this->setupDynamics(dt);
+
+        time_step_levels_.forActiveParticles(ExecutionPolicy(),
+                                             [&](size_t i, Real dt_i)
+                                             { this->initialization(i, dt_i); });
+
+        this->runInteraction(dt);
+
+        time_step_levels_.forActiveParticles(ExecutionPolicy(),
+                                             [&](size_t i, Real dt_i)
+                                             { this->update(i, dt_i); });
+        if constexpr (has_interface_update<LocalDynamicsType>::value)
+        {
+            time_step_levels_.forInterfaceParticles(ExecutionPolicy(),
+                                                    [&](size_t i, Real dt_i)
+                                                    { this->interfaceUpdate(i, dt_i); });
+        }
+    };
+
+    virtual void runMainStep(Real dt) override
+    {
+        time_step_levels_.forActiveParticles(typename InteractionPolicy<ExecutionPolicy>::type(),
+                                             [&](size_t i, Real dt_i)
+                                             { this->interaction(i, dt_i); });
+        if constexpr (has_interface_interaction<LocalDynamicsType>::value)
+        {
+            time_step_levels_.forInterfaceParticles(typename InteractionPolicy<ExecutionPolicy>::type(),
+                                                    [&](size_t i, Real dt_i)
+                                                    { this->interfaceInteraction(i, dt_i); });
+        }
+    };
+
+  protected:
+    TimeStepLevels &time_step_levels_;
+};
+} // namespace SPH
+#endif // LOCAL_TIME_STEPPING_H
@@ -29,8 +29,10 @@
  * 			SimpleDynamics is without particle interaction. Particles just update their states;
  *			InteractionDynamics is with particle interaction with its neighbors;
  *			InteractionSplit is InteractionDynamics but using spliting algorithm;
+ *			InteractionSymmetric is InteractionDynamics evaluating each particle pair only once;
  *			InteractionWithUpdate is with particle interaction with its neighbors and then update their states;
  *			Dynamics1Level is the most complex dynamics, has successive three steps: initialization, interaction and update.
+ *			FusedDynamics and FusedDynamicsReduce carry out several successive dynamics with fused particle sweeps.
  *			In order to avoid misusing of the above algorithms, type traits are used to make sure that the matching between
  *			the algorithm and local dynamics. For example, the LocalDynamics which matches InteractionDynamics must have
  *			the function interaction() but should not have the function update() or initialize().
@@ -68,6 +70,16 @@ struct has_initialize<T, std::void_t<decltype(&T::initialize)>> : std::true_type
 {
 };
 
+template <class T, class = void>
+struct has_initialization : std::false_type
+{
+};
+
+template <class T>
+struct has_initialization<T, std::void_t<decltype(&T::initialization)>> : std::true_type
+{
+};
+
 template <class T, class = void>
 struct has_interaction : std::false_type
 {
@@ -90,9 +102,33 @@ struct has_update<T, std::void_t<decltype(&T::update)>> : std::true_type
 
 using namespace execution;
 
+/**
+ * The interaction with neighbors, with irregular memory access, is not vectorized.
+ * Therefore, the interaction step of a dynamics with unsequenced policy
+ * uses the sequenced counterpart, while its initialization and update steps are vectorized.
+ */
+template <class ExecutionPolicy>
+struct InteractionPolicy
+{
+    using type = ExecutionPolicy;
+};
+
+template <>
+struct InteractionPolicy<UnsequencedPolicy>
+{
+    using type = SequencedPolicy;
+};
+
+template <>
+struct InteractionPolicy<ParallelUnsequencedPolicy>
+{
+    using type = ParallelPolicy;
+};
+
 /**
  * @class SimpleDynamics
  * @brief Simple particle dynamics without considering particle interaction
+ * The finishDynamics of the local dynamics is called after the particle sweep.
  */
 template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
 class SimpleDynamics : public LocalDynamicsType, public BaseDynamics<void>
@@ -111,15 +147,41 @@ class SimpleDynamics : public LocalDynamicsType, public BaseDynamics<void>
 
     virtual void exec(Real dt = 0.0) override
     {
+        SPHINXSYS_PROFILE_DYNAMICS(this->identifier_.SizeOfLoopRange());
         this->setUpdated();
         this->setupDynamics(dt);
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
                      [&](size_t i)
                      { this->update(i, dt); });
+        this->finishDynamics(dt);
     };
 };
 
+/**
+ * Reduce the values of the particles in the loop range by the operation,
+ * in which summations are accumulated by the type given by AccumulationData.
+ */
+template <class ExecutionPolicy, class LoopRange, typename Operation, class LocalDynamicsFunction>
+decltype(Operation::reference_) reduceParticles(const ExecutionPolicy &execution_policy, const LoopRange &loop_range,
+                                                Operation &operation, const LocalDynamicsFunction &local_dynamics_function)
+{
+    return particle_reduce(execution_policy, loop_range, operation.reference_, operation, local_dynamics_function);
+}
+
+template <class ExecutionPolicy, class LoopRange, typename DataType, class LocalDynamicsFunction>
+DataType reduceParticles(const ExecutionPolicy &execution_policy, const LoopRange &loop_range,
+                         ReduceSum<DataType> &operation, const LocalDynamicsFunction &local_dynamics_function)
+{
+    using Accumulation = AccumulationData<DataType>;
+    using AccumulationType = typename Accumulation::type;
+    AccumulationType sum = particle_reduce(execution_policy, loop_range, Accumulation::accumulation(operation.reference_),
+                                           ReduceSum<AccumulationType>(),
+                                           [&](size_t i) -> AccumulationType
+                                           { return Accumulation::accumulation(local_dynamics_function(i)); });
+    return Accumulation::result(sum);
+}
+
 /**
  * @class ReduceDynamics
  * @brief Template class for particle-wise reduce operation, summation, max or min.
@@ -141,9 +203,9 @@ class ReduceDynamics : public LocalDynamicsType,
 
     virtual ReturnType exec(Real dt = 0.0) override
     {
+        SPHINXSYS_PROFILE_DYNAMICS(this->identifier_.SizeOfLoopRange());
         this->setupDynamics(dt);
-        ReturnType temp = particle_reduce(ExecutionPolicy(),
-                                          this->identifier_.LoopRange(), this->Reference(), this->getOperation(),
+        ReturnType temp = reduceParticles(ExecutionPolicy(), this->identifier_.LoopRange(), this->getOperation(),
                                           [&](size_t i) -> ReturnType
                                           { return this->reduce(i, dt); });
         return this->outputResult(temp);
@@ -185,6 +247,7 @@ class BaseInteractionDynamics : public LocalDynamicsType, public BaseDynamics<vo
 
     virtual void exec(Real dt = 0.0) override
     {
+        SPHINXSYS_PROFILE_DYNAMICS(this->identifier_.SizeOfLoopRange());
         this->setUpdated();
         this->setupDynamics(dt);
         runInteraction(dt);
@@ -194,6 +257,7 @@ class BaseInteractionDynamics : public LocalDynamicsType, public BaseDynamics<vo
 /**
  * @class InteractionSplit
  * @brief This is for the splitting algorithm
+ * The split cell lists from the contiguous cell lists are used when they are built.
  */
 template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
 class InteractionSplit : public BaseInteractionDynamics<LocalDynamicsType, ParallelPolicy>
@@ -201,13 +265,15 @@ class InteractionSplit : public BaseInteractionDynamics<LocalDynamicsType, Paral
   protected:
     RealBody &real_body_;
     SplitCellLists &split_cell_lists_;
+    ContiguousSplitCellLists &contiguous_split_cell_lists_;
 
   public:
     template <typename... Args>
     InteractionSplit(Args &&...args)
         : BaseInteractionDynamics<LocalDynamicsType, ParallelPolicy>(std::forward<Args>(args)...),
           real_body_(DynamicCast<RealBody>(this, this->getSPHBody())),
-          split_cell_lists_(real_body_.getSplitCellLists())
+          split_cell_lists_(real_body_.getSplitCellLists()),
+          contiguous_split_cell_lists_(real_body_.getContiguousSplitCellLists())
     {
         real_body_.setUseSplitCellLists();
         static_assert(!has_initialize<LocalDynamicsType>::value &&
@@ -219,13 +285,115 @@ class InteractionSplit : public BaseInteractionDynamics<LocalDynamicsType, Paral
     /** run the main interaction step between particles. */
     virtual void runMainStep(Real dt) override
     {
-        particle_for(ExecutionPolicy(),
-                     split_cell_lists_,
-                     [&](size_t i)
-                     { this->interaction(i, dt * 0.5); });
+        auto split_interaction = [&](size_t i)
+        { this->interaction(i, dt * 0.5); };
+        if (contiguous_split_cell_lists_.is_built_)
+        {
+            particle_for(ExecutionPolicy(), contiguous_split_cell_lists_, split_interaction);
+        }
+        else
+        {
+            particle_for(ExecutionPolicy(), split_cell_lists_, split_interaction);
+        }
     }
 };
 
+/**
+ * @class InteractionSymmetric
+ * @brief This is for the local dynamics with Inner<Symmetric> interaction,
+ * which evaluate each particle pair of a SymmetricInnerRelation only once
+ * and scatter the contributions to both particles.
+ * The particles are visited by the split cell lists. As the cells in the same split list
+ * are separated by at least two cells, their particles have no common neighbors
+ * and are updated concurrently without data race.
+ * As for InteractionSplit, the split cell lists from the contiguous cell lists are used when they are built,
+ * so that requesting the split cell lists keeps the contiguous cell lists of the body in use.
+ * The initialization and update steps are carried out if the local dynamics has them.
+ */
+template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
+class InteractionSymmetric : public BaseInteractionDynamics<LocalDynamicsType, ExecutionPolicy>
+{
+  protected:
+    RealBody &real_body_;
+    SplitCellLists &split_cell_lists_;
+    ContiguousSplitCellLists &contiguous_split_cell_lists_;
+
+  public:
+    template <typename... Args>
+    InteractionSymmetric(Args &&...args)
+        : BaseInteractionDynamics<LocalDynamicsType, ExecutionPolicy>(std::forward<Args>(args)...),
+          real_body_(DynamicCast<RealBody>(this, this->getSPHBody())),
+          split_cell_lists_(real_body_.getSplitCellLists()),
+          contiguous_split_cell_lists_(real_body_.getContiguousSplitCellLists())
+    {
+        real_body_.setUseSplitCellLists();
+    };
+    virtual ~InteractionSymmetric(){};
+
+    /** run the main interaction step between particles. */
+    virtual void runMainStep(Real dt) override
+    {
+        if (contiguous_split_cell_lists_.is_built_)
+        {
+            const size_t *particle_indexes = contiguous_split_cell_lists_.particle_indexes_;
+            for (size_t k = 0; k != contiguous_split_cell_lists_.cell_ranges_.size(); ++k)
+            {
+                const StdLargeVec<ParticlesBound> &cell_ranges = contiguous_split_cell_lists_.cell_ranges_[k];
+                particle_for(typename InteractionPolicy<ExecutionPolicy>::type(),
+                             IndexRange(0, cell_ranges.size()),
+                             [&](size_t l)
+                             {
+                                 for (size_t s = cell_ranges[l].first; s != cell_ranges[l].second; ++s)
+                                 {
+                                     this->interaction(particle_indexes[s], dt);
+                                 }
+                             });
+            }
+            return;
+        }
+
+        for (size_t k = 0; k != split_cell_lists_.size(); ++k)
+        {
+            const ConcurrentCellLists &cell_lists = split_cell_lists_[k];
+            particle_for(typename InteractionPolicy<ExecutionPolicy>::type(),
+                         IndexRange(0, cell_lists.size()),
+                         [&](size_t l)
+                         {
+                             const ConcurrentIndexVector &particle_indexes = *cell_lists[l];
+                             for (size_t i = 0; i != particle_indexes.size(); ++i)
+                             {
+                                 this->interaction(particle_indexes[i], dt);
+                             }
+                         });
+        }
+    }
+
+    virtual void exec(Real dt = 0.0) override
+    {
+        SPHINXSYS_PROFILE_DYNAMICS(this->identifier_.SizeOfLoopRange());
+        this->setUpdated();
+        this->setupDynamics(dt);
+
+        if constexpr (has_initialization<LocalDynamicsType>::value)
+        {
+            particle_for(ExecutionPolicy(),
+                         this->identifier_.LoopRange(),
+                         [&](size_t i)
+                         { this->initialization(i, dt); });
+        }
+
+        this->runInteraction(dt);
+
+        if constexpr (has_update<LocalDynamicsType>::value)
+        {
+            particle_for(ExecutionPolicy(),
+                         this->identifier_.LoopRange(),
+                         [&](size_t i)
+                         { this->update(i, dt); });
+        }
+    };
+};
+
 /**
  * @class InteractionDynamics
  * @brief This is the class with a single step of particle interaction with other particles
@@ -247,7 +415,7 @@ class InteractionDynamics : public BaseInteractionDynamics<LocalDynamicsType, Ex
     /** run the main interaction step between particles. */
     virtual void runMainStep(Real dt) override
     {
-        particle_for(ExecutionPolicy(),
+        particle_for(typename InteractionPolicy<ExecutionPolicy>::type(),
                      this->identifier_.LoopRange(),
                      [&](size_t i)
                      { this->interaction(i, dt); });
@@ -278,6 +446,7 @@ class InteractionWithUpdate : public InteractionDynamics<LocalDynamicsType, Exec
 
     virtual void exec(Real dt = 0.0) override
     {
+        SPHINXSYS_PROFILE_DYNAMICS(this->identifier_.SizeOfLoopRange());
         InteractionDynamics<LocalDynamicsType, ExecutionPolicy>::exec(dt);
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
@@ -305,6 +474,7 @@ class InteractionWithInitialization : public InteractionDynamics<LocalDynamicsTy
 
     virtual void exec(Real dt = 0.0) override
     {
+        SPHINXSYS_PROFILE_DYNAMICS(this->identifier_.SizeOfLoopRange());
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
                      [&](size_t i)
@@ -331,6 +501,7 @@ class Dynamics1Level : public InteractionDynamics<LocalDynamicsType, ExecutionPo
 
     virtual void exec(Real dt = 0.0) override
     {
+        SPHINXSYS_PROFILE_DYNAMICS(this->identifier_.SizeOfLoopRange());
         this->setUpdated();
         this->setupDynamics(dt);
 
@@ -347,5 +518,189 @@ class Dynamics1Level : public InteractionDynamics<LocalDynamicsType, ExecutionPo
                      { this->update(i, dt); });
     };
 };
+
+/**
+ * @struct DynamicsExecutionPolicy
+ * @brief Obtain the execution policy of a particle dynamics.
+ */
+template <class DynamicsType>
+struct DynamicsExecutionPolicy
+{
+    using type = ParallelPolicy;
+};
+
+template <template <class, class> class DynamicsName, class LocalDynamicsType, class ExecutionPolicy>
+struct DynamicsExecutionPolicy<DynamicsName<LocalDynamicsType, ExecutionPolicy>>
+{
+    using type = ExecutionPolicy;
+};
+
+/**
+ * @class BaseFusedDynamics
+ * @brief Successive particle dynamics on the same particles carried out with fused particle sweeps.
+ * The dynamics are either SimpleDynamics or Dynamics1Level.
+ * Since the update and initialization steps do not involve neighbors,
+ * all these steps between two interaction steps are carried out in a single particle sweep.
+ * For example, the successive pressure and density relaxations take three sweeps instead of four,
+ * and the update of the density relaxation is carried out in the last sweep.
+ * Note that the setupDynamics of a dynamics is called before the sweep with the update steps of
+ * the previous dynamics, and that the execution policy of the first dynamics is used for all sweeps.
+ * As in separate execution, the finishDynamics of a SimpleDynamics is called after the sweep with its update step,
+ * i.e. after the initialization steps of the next dynamics with interaction have been carried out.
+ */
+template <class... DynamicsTypes>
+class BaseFusedDynamics
+{
+  public:
+    explicit BaseFusedDynamics(DynamicsTypes &...dynamics)
+        : dynamics_(dynamics...)
+    {
+        static_assert(sizeof...(DynamicsTypes) > 0, "BaseFusedDynamics requires at least one dynamics");
+        checkSameLoopRange(std::get<0>(dynamics_).getDynamicsIdentifier(), dynamics...);
+    };
+    virtual ~BaseFusedDynamics(){};
+    SPHBody &getSPHBody() { return std::get<0>(dynamics_).getSPHBody(); };
+
+  protected:
+    using ExecutionPolicy = typename DynamicsExecutionPolicy<std::tuple_element_t<0, std::tuple<DynamicsTypes...>>>::type;
+    std::tuple<DynamicsTypes &...> dynamics_;
+
+    auto LoopRange() { return std::get<0>(dynamics_).getDynamicsIdentifier().LoopRange(); };
+    size_t SizeOfLoopRange() { return std::get<0>(dynamics_).getDynamicsIdentifier().SizeOfLoopRange(); };
+
+    template <class DynamicsIdentifier, class... OtherDynamicsTypes>
+    void checkSameLoopRange(DynamicsIdentifier &identifier, OtherDynamicsTypes &...other_dynamics)
+    {
+        bool is_same_loop_range =
+            ((static_cast<void *>(&other_dynamics.getDynamicsIdentifier()) == static_cast<void *>(&identifier)) && ...);
+        if (!is_same_loop_range)
+        {
+            std::cout << "\n Error: the fused dynamics are not defined on the same particles!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    };
+
+    /** Run the dynamics from the K-th one and return the update steps left for the last sweep,
+     *  together with the finishDynamics to be called after that sweep. */
+    template <size_t K, class PointwiseFunction, class FinishFunction>
+    auto runFusedSweeps(Real dt, const PointwiseFunction &pending_steps, const FinishFunction &pending_finish)
+    {
+        if constexpr (K == sizeof...(DynamicsTypes))
+        {
+            return std::make_pair(pending_steps, pending_finish);
+        }
+        else
+        {
+            using DynamicsType = std::tuple_element_t<K, std::tuple<DynamicsTypes...>>;
+            DynamicsType &dynamics = std::get<K>(dynamics_);
+            dynamics.setUpdated();
+            dynamics.setupDynamics(dt);
+            if constexpr (has_interaction<DynamicsType>::value)
+            {
+                static_assert(has_initialization<DynamicsType>::value && has_update<DynamicsType>::value,
+                              "DynamicsType does not fulfill FusedDynamics requirements");
+                particle_for(ExecutionPolicy(),
+                             LoopRange(),
+                             [&](size_t i)
+                             {
+                                 pending_steps(i);
+                                 dynamics.initialization(i, dt);
+                             });
+                pending_finish();
+
+                dynamics.runInteraction(dt);
+
+                return runFusedSweeps<K + 1>(
+                    dt, [&dynamics, dt](size_t i)
+                    { dynamics.update(i, dt); },
+                    []() {});
+            }
+            else
+            {
+                static_assert(has_update<DynamicsType>::value,
+                              "DynamicsType does not fulfill FusedDynamics requirements");
+                return runFusedSweeps<K + 1>(
+                    dt, [&dynamics, dt, pending_steps](size_t i)
+                    {
+                        pending_steps(i);
+                        dynamics.update(i, dt); },
+                    [&dynamics, dt, pending_finish]()
+                    {
+                        pending_finish();
+                        dynamics.finishDynamics(dt); });
+            }
+        }
+    };
+};
+
+/**
+ * @class FusedDynamics
+ * @brief Successive SimpleDynamics or Dynamics1Level carried out with fused particle sweeps.
+ */
+template <class... DynamicsTypes>
+class FusedDynamics : public BaseFusedDynamics<DynamicsTypes...>, public BaseDynamics<void>
+{
+  public:
+    explicit FusedDynamics(DynamicsTypes &...dynamics)
+        : BaseFusedDynamics<DynamicsTypes...>(dynamics...),
+          BaseDynamics<void>(this->getSPHBody()){};
+    virtual ~FusedDynamics(){};
+
+    virtual void exec(Real dt = 0.0) override
+    {
+        SPHINXSYS_PROFILE_DYNAMICS(this->SizeOfLoopRange());
+        this->setUpdated();
+        auto last_steps_and_finish = this->template runFusedSweeps<0>(dt, [](size_t i) {}, []() {});
+        particle_for(typename BaseFusedDynamics<DynamicsTypes...>::ExecutionPolicy(),
+                     this->LoopRange(), last_steps_and_finish.first);
+        last_steps_and_finish.second();
+    };
+};
+
+/**
+ * @class FusedDynamicsReduce
+ * @brief Successive SimpleDynamics or Dynamics1Level carried out with fused particle sweeps,
+ * followed by a ReduceDynamics which is fused into the last sweep.
+ * The reduce operation, such as computing the time step size, is carried out just after
+ * the last update step of each particle. The dynamics are given with the reduce dynamics first.
+ */
+template <class ReduceDynamicsType, class... DynamicsTypes>
+class FusedDynamicsReduce : public BaseFusedDynamics<DynamicsTypes...>,
+                            public BaseDynamics<typename ReduceDynamicsType::ReturnType>
+{
+  public:
+    using ReturnType = typename ReduceDynamicsType::ReturnType;
+
+    explicit FusedDynamicsReduce(ReduceDynamicsType &reduce_dynamics, DynamicsTypes &...dynamics)
+        : BaseFusedDynamics<DynamicsTypes...>(dynamics...),
+          BaseDynamics<ReturnType>(this->getSPHBody()),
+          reduce_dynamics_(reduce_dynamics)
+    {
+        this->checkSameLoopRange(reduce_dynamics_.getDynamicsIdentifier(), dynamics...);
+    };
+    virtual ~FusedDynamicsReduce(){};
+
+    virtual ReturnType exec(Real dt = 0.0) override
+    {
+        SPHINXSYS_PROFILE_DYNAMICS(this->SizeOfLoopRange());
+        this->setUpdated();
+        auto last_steps_and_finish = this->template runFusedSweeps<0>(dt, [](size_t i) {}, []() {});
+        auto &last_steps = last_steps_and_finish.first;
+        reduce_dynamics_.setupDynamics(dt);
+        ReturnType temp = reduceParticles(typename BaseFusedDynamics<DynamicsTypes...>::ExecutionPolicy(),
+                                          this->LoopRange(), reduce_dynamics_.getOperation(),
+                                          [&](size_t i) -> ReturnType
+                                          {
+                                              last_steps(i);
+                                              return reduce_dynamics_.reduce(i, dt);
+                                          });
+        last_steps_and_finish.second();
+        return reduce_dynamics_.outputResult(temp);
+    };
+
+  protected:
+    ReduceDynamicsType &reduce_dynamics_;
+};
 } // namespace SPH
 #endif // PARTICLE_DYNAMICS_ALGORITHMS_H
@@ -257,6 +257,40 @@ class AdaptiveResolution
 //----------------------------------------------------------------------
 // Particle reduce functors
 //----------------------------------------------------------------------
+/**
+ * @struct AccumulationData
+ * @brief The type in which a summation is accumulated.
+ * When the library is built with SPHINXSYS_USE_FLOAT, Real quantities are summed in double,
+ * so that the accuracy of the summation does not depend on the storage precision.
+ * Otherwise, Real is already double and the summation is carried out in the data type itself.
+ */
+template <typename DataType>
+struct AccumulationData
+{
+    using type = DataType;
+    static type accumulation(const DataType &value) { return value; };
+    static DataType result(const type &sum) { return sum; };
+};
+
+#if SPHINXSYS_USE_FLOAT
+template <>
+struct AccumulationData<float>
+{
+    using type = double;
+    static type accumulation(const float &value) { return value; };
+    static float result(const type &sum) { return float(sum); };
+};
+
+template <int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+struct AccumulationData<Eigen::Matrix<float, Rows, Cols, Options, MaxRows, MaxCols>>
+{
+    using DataType = Eigen::Matrix<float, Rows, Cols, Options, MaxRows, MaxCols>;
+    using type = Eigen::Matrix<double, Rows, Cols, Options, MaxRows, MaxCols>;
+    static type accumulation(const DataType &value) { return value.template cast<double>(); };
+    static DataType result(const type &sum) { return sum.template cast<float>(); };
+};
+#endif
+
 template <class ReturnType>
 struct ReduceSum
 {
@@ -33,6 +33,8 @@
 #include "execution_policy.h"
 #include "sph_data_containers.h"
 
+#include <array>
+
 namespace SPH
 {
 using namespace execution;
@@ -73,6 +75,40 @@ inline void particle_for(const ParallelPolicy &par, const IndexRange &particles_
         },
         ap);
 };
+/**
+ * Range-wise iterators (for unsequenced and parallel unsequenced computing).
+ * The particles are processed in contiguous blocks by loops marked for SIMD vectorization,
+ * which is effective when the local dynamics function is inlined and free of virtual calls.
+ */
+template <class LocalDynamicsFunction>
+inline void particle_for(const UnsequencedPolicy &unseq, const IndexRange &particles_range,
+                         const LocalDynamicsFunction &local_dynamics_function)
+{
+    const size_t begin = particles_range.begin();
+    const size_t end = particles_range.end();
+    SPHINXSYS_SIMD_LOOP
+    for (size_t i = begin; i < end; ++i)
+        local_dynamics_function(i);
+};
+
+template <class LocalDynamicsFunction>
+inline void particle_for(const ParallelUnsequencedPolicy &par_unseq, const IndexRange &particles_range,
+                         const LocalDynamicsFunction &local_dynamics_function)
+{
+    parallel_for(
+        particles_range,
+        [&](const IndexRange &r)
+        {
+            const size_t begin = r.begin();
+            const size_t end = r.end();
+            SPHINXSYS_SIMD_LOOP
+            for (size_t i = begin; i < end; ++i)
+            {
+                local_dynamics_function(i);
+            }
+        },
+        ap);
+};
 /**
  * Bodypart By Particle-wise iterators (for sequential and parallel computing).
  */
@@ -99,6 +135,37 @@ inline void particle_for(const ParallelPolicy &par, const IndexVector &body_part
         },
         ap);
 };
+/**
+ * Bodypart By Particle-wise iterators (for unsequenced and parallel unsequenced computing).
+ */
+template <class LocalDynamicsFunction>
+inline void particle_for(const UnsequencedPolicy &unseq, const IndexVector &body_part_particles,
+                         const LocalDynamicsFunction &local_dynamics_function)
+{
+    const size_t size = body_part_particles.size();
+    SPHINXSYS_SIMD_LOOP
+    for (size_t i = 0; i < size; ++i)
+        local_dynamics_function(body_part_particles[i]);
+};
+
+template <class LocalDynamicsFunction>
+inline void particle_for(const ParallelUnsequencedPolicy &par_unseq, const IndexVector &body_part_particles,
+                         const LocalDynamicsFunction &local_dynamics_function)
+{
+    parallel_for(
+        IndexRange(0, body_part_particles.size()),
+        [&](const IndexRange &r)
+        {
+            const size_t begin = r.begin();
+            const size_t end = r.end();
+            SPHINXSYS_SIMD_LOOP
+            for (size_t i = begin; i < end; ++i)
+            {
+                local_dynamics_function(body_part_particles[i]);
+            }
+        },
+        ap);
+};
 /**
  * Bodypart By Cell-wise iterators (for sequential and parallel computing).
  */
@@ -161,6 +228,37 @@ inline void particle_for(const ParallelPolicy &par, const DataListsInCells &body
         },
         ap);
 };
+/**
+ * BodypartByCell-wise iterators (for unsequenced and parallel unsequenced computing).
+ * As the particles in cells are not contiguous, the sequenced counterparts are used.
+ */
+template <class LocalDynamicsFunction>
+inline void particle_for(const UnsequencedPolicy &unseq, const ConcurrentCellLists &body_part_cells,
+                         const LocalDynamicsFunction &local_dynamics_function)
+{
+    particle_for(seq, body_part_cells, local_dynamics_function);
+};
+
+template <class LocalDynamicsFunction>
+inline void particle_for(const ParallelUnsequencedPolicy &par_unseq, const ConcurrentCellLists &body_part_cells,
+                         const LocalDynamicsFunction &local_dynamics_function)
+{
+    particle_for(par, body_part_cells, local_dynamics_function);
+};
+
+template <class LocalDynamicsFunction>
+inline void particle_for(const UnsequencedPolicy &unseq, const DataListsInCells &body_part_cells,
+                         const LocalDynamicsFunction &local_dynamics_function)
+{
+    particle_for(seq, body_part_cells, local_dynamics_function);
+};
+
+template <class LocalDynamicsFunction>
+inline void particle_for(const ParallelUnsequencedPolicy &par_unseq, const DataListsInCells &body_part_cells,
+                         const LocalDynamicsFunction &local_dynamics_function)
+{
+    particle_for(par, body_part_cells, local_dynamics_function);
+};
 /**
  * Splitting algorithm (for sequential and parallel computing).
  */
@@ -242,6 +340,123 @@ inline void particle_for(const ParallelPolicy &par, const SplitCellLists &split_
     }
 }
 
+/**
+ * Splitting algorithm with the split cell lists given by the ranges of cells in contiguous cell lists.
+ */
+template <class LocalDynamicsFunction>
+inline void particle_for(const SequencedPolicy &seq, const ContiguousSplitCellLists &split_cell_lists,
+                         const LocalDynamicsFunction &local_dynamics_function)
+{
+    const size_t *particle_indexes = split_cell_lists.particle_indexes_;
+    // forward sweeping
+    for (size_t k = 0; k != split_cell_lists.cell_ranges_.size(); ++k)
+    {
+        const StdLargeVec<ParticlesBound> &cell_ranges = split_cell_lists.cell_ranges_[k];
+        for (size_t l = 0; l != cell_ranges.size(); ++l)
+        {
+            for (size_t s = cell_ranges[l].first; s != cell_ranges[l].second; ++s)
+            {
+                local_dynamics_function(particle_indexes[s]);
+            }
+        }
+    }
+
+    // backward sweeping
+    for (size_t k = split_cell_lists.cell_ranges_.size(); k != 0; --k)
+    {
+        const StdLargeVec<ParticlesBound> &cell_ranges = split_cell_lists.cell_ranges_[k - 1];
+        for (size_t l = 0; l != cell_ranges.size(); ++l)
+        {
+            for (size_t s = cell_ranges[l].second; s != cell_ranges[l].first; --s)
+            {
+                local_dynamics_function(particle_indexes[s - 1]);
+            }
+        }
+    }
+}
+
+template <class LocalDynamicsFunction>
+inline void particle_for(const ParallelPolicy &par, const ContiguousSplitCellLists &split_cell_lists,
+                         const LocalDynamicsFunction &local_dynamics_function)
+{
+    const size_t *particle_indexes = split_cell_lists.particle_indexes_;
+    // forward sweeping
+    for (size_t k = 0; k != split_cell_lists.cell_ranges_.size(); ++k)
+    {
+        const StdLargeVec<ParticlesBound> &cell_ranges = split_cell_lists.cell_ranges_[k];
+        parallel_for(
+            IndexRange(0, cell_ranges.size()),
+            [&](const IndexRange &r)
+            {
+                for (size_t l = r.begin(); l < r.end(); ++l)
+                {
+                    for (size_t s = cell_ranges[l].first; s != cell_ranges[l].second; ++s)
+                    {
+                        local_dynamics_function(particle_indexes[s]);
+                    }
+                }
+            },
+            ap);
+    }
+
+    // backward sweeping
+    for (size_t k = split_cell_lists.cell_ranges_.size(); k != 0; --k)
+    {
+        const StdLargeVec<ParticlesBound> &cell_ranges = split_cell_lists.cell_ranges_[k - 1];
+        parallel_for(
+            IndexRange(0, cell_ranges.size()),
+            [&](const IndexRange &r)
+            {
+                for (size_t l = r.begin(); l < r.end(); ++l)
+                {
+                    for (size_t s = cell_ranges[l].second; s != cell_ranges[l].first; --s)
+                    {
+                        local_dynamics_function(particle_indexes[s - 1]);
+                    }
+                }
+            },
+            ap);
+    }
+}
+
+/**
+ * Exclusive prefix sum (for sequential and parallel computing).
+ * The offset of each index in the range, i.e. the sum of the counts before it, is written to offsets
+ * and the total count is returned. The count function may be called more than once for an index.
+ */
+template <class OffsetsType, class CountFunction>
+inline size_t particle_scan(const SequencedPolicy &seq, const IndexRange &particles_range,
+                            OffsetsType &offsets, const CountFunction &count_function)
+{
+    size_t sum = 0;
+    for (size_t i = particles_range.begin(); i < particles_range.end(); ++i)
+    {
+        offsets[i] = sum;
+        sum += count_function(i);
+    }
+    return sum;
+};
+
+template <class OffsetsType, class CountFunction>
+inline size_t particle_scan(const ParallelPolicy &par, const IndexRange &particles_range,
+                            OffsetsType &offsets, const CountFunction &count_function)
+{
+    return tbb::parallel_scan(
+        particles_range, size_t(0),
+        [&](const IndexRange &r, size_t sum, bool is_final_scan) -> size_t
+        {
+            for (size_t i = r.begin(); i < r.end(); ++i)
+            {
+                if (is_final_scan)
+                    offsets[i] = sum;
+                sum += count_function(i);
+            }
+            return sum;
+        },
+        [](size_t left_sum, size_t right_sum)
+        { return left_sum + right_sum; });
+};
+
 template <class ExecutionPolicy, typename DynamicsRange, class ReturnType,
           typename Operation, class LocalDynamicsFunction>
 void particle_reduce(const ExecutionPolicy &execution_policy, const DynamicsRange &dynamics_range,
@@ -286,6 +501,68 @@ inline ReturnType particle_reduce(const ParallelPolicy &par, const IndexRange &p
             return operation(x, y);
         });
 };
+/**
+ * Block-wise reduce for the unsequenced policies. The values of a block of particles
+ * are computed by a loop marked for SIMD vectorization and then reduced in sequence.
+ */
+constexpr size_t SimdReduceBlockSize = 64;
+
+template <class ReturnType, typename Operation, class ParticleIndex, class LocalDynamicsFunction>
+inline ReturnType simd_block_reduce(size_t begin, size_t end, ReturnType temp, Operation &operation,
+                                    const ParticleIndex &particle_index,
+                                    const LocalDynamicsFunction &local_dynamics_function)
+{
+    std::array<ReturnType, SimdReduceBlockSize> block_values;
+    for (size_t block_begin = begin; block_begin < end; block_begin += SimdReduceBlockSize)
+    {
+        const size_t block_size = SMIN(SimdReduceBlockSize, end - block_begin);
+        SPHINXSYS_SIMD_LOOP
+        for (size_t n = 0; n < block_size; ++n)
+        {
+            block_values[n] = local_dynamics_function(particle_index(block_begin + n));
+        }
+
+        for (size_t n = 0; n != block_size; ++n)
+        {
+            temp = operation(temp, block_values[n]);
+        }
+    }
+    return temp;
+}
+
+template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+inline ReturnType particle_reduce(const UnsequencedPolicy &unseq, const IndexRange &particles_range,
+                                  ReturnType temp, Operation &&operation,
+                                  const LocalDynamicsFunction &local_dynamics_function)
+{
+    return simd_block_reduce(
+        particles_range.begin(), particles_range.end(), temp, operation,
+        [](size_t i) -> size_t
+        { return i; },
+        local_dynamics_function);
+}
+
+template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+inline ReturnType particle_reduce(const ParallelUnsequencedPolicy &par_unseq, const IndexRange &particles_range,
+                                  ReturnType temp, Operation &&operation,
+                                  const LocalDynamicsFunction &local_dynamics_function)
+{
+    return parallel_reduce(
+        particles_range,
+        temp,
+        [&](const IndexRange &r, ReturnType temp0) -> ReturnType
+        {
+            return simd_block_reduce(
+                r.begin(), r.end(), temp0, operation,
+                [](size_t i) -> size_t
+                { return i; },
+                local_dynamics_function);
+        },
+        [&](const ReturnType &x, const ReturnType &y) -> ReturnType
+        {
+            return operation(x, y);
+        });
+};
 /**
  * BodypartByParticle-wise reduce iterators (for sequential and parallel computing).
  */
@@ -322,6 +599,42 @@ inline ReturnType particle_reduce(const ParallelPolicy &par, const IndexVector &
             return operation(x, y);
         });
 };
+/**
+ * BodypartByParticle-wise reduce iterators (for unsequenced and parallel unsequenced computing).
+ */
+template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+inline ReturnType particle_reduce(const UnsequencedPolicy &unseq, const IndexVector &body_part_particles,
+                                  ReturnType temp, Operation &&operation,
+                                  const LocalDynamicsFunction &local_dynamics_function)
+{
+    return simd_block_reduce(
+        0, body_part_particles.size(), temp, operation,
+        [&](size_t n) -> size_t
+        { return body_part_particles[n]; },
+        local_dynamics_function);
+}
+
+template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+inline ReturnType particle_reduce(const ParallelUnsequencedPolicy &par_unseq, const IndexVector &body_part_particles,
+                                  ReturnType temp, Operation &&operation,
+                                  const LocalDynamicsFunction &local_dynamics_function)
+{
+    return parallel_reduce(
+        IndexRange(0, body_part_particles.size()),
+        temp,
+        [&](const IndexRange &r, ReturnType temp0) -> ReturnType
+        {
+            return simd_block_reduce(
+                r.begin(), r.end(), temp0, operation,
+                [&](size_t n) -> size_t
+                { return body_part_particles[n]; },
+                local_dynamics_function);
+        },
+        [&](const ReturnType &x, const ReturnType &y) -> ReturnType
+        {
+            return operation(x, y);
+        });
+};
 /**
  * BodypartByCell-wise reduce iterators (for sequential and parallel computing).
  */
@@ -365,5 +678,21 @@ inline ReturnType particle_reduce(const ParallelPolicy &par, const ConcurrentCel
         [&](const ReturnType &x, const ReturnType &y) -> ReturnType
         { return operation(x, y); });
 }
+
+template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+inline ReturnType particle_reduce(const UnsequencedPolicy &unseq, const ConcurrentCellLists &body_part_cells,
+                                  ReturnType temp, Operation &&operation,
+                                  const LocalDynamicsFunction &local_dynamics_function)
+{
+    return particle_reduce(seq, body_part_cells, temp, operation, local_dynamics_function);
+}
+
+template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+inline ReturnType particle_reduce(const ParallelUnsequencedPolicy &par_unseq, const ConcurrentCellLists &body_part_cells,
+                                  ReturnType temp, Operation &&operation,
+                                  const LocalDynamicsFunction &local_dynamics_function)
+{
+    return particle_reduce(par, body_part_cells, temp, operation, local_dynamics_function);
+}
 } // namespace SPH
 #endif // PARTICLE_ITERATORS_H
@@ -26,11 +26,19 @@ void RelaxationResidue<Inner<>>::interaction(size_t index_i, Real dt)
     residue_[index_i] = residue;
 };
 //=================================================================================================//
+void RelaxationResidue<Inner<LevelSetCorrection>>::setupDynamics(Real dt)
+{
+    size_t total_real_particles = particles_->total_real_particles_;
+    level_set_probes_.resize(total_real_particles);
+    Real *h_ratios = particle_refinement_ == nullptr ? nullptr : particle_refinement_->h_ratio_.data();
+    level_set_shape_.probeLevelSet(pos_.data(), h_ratios, total_real_particles,
+                                   level_set_probes_.data(), ProbeKernelGradientIntegral);
+}
+//=================================================================================================//
 void RelaxationResidue<Inner<LevelSetCorrection>>::interaction(size_t index_i, Real dt)
 {
     RelaxationResidue<Inner<>>::interaction(index_i, dt);
-    residue_[index_i] -= 2.0 * level_set_shape_.computeKernelGradientIntegral(
-                                   pos_[index_i], sph_adaptation_->SmoothingLengthRatio(index_i));
+    residue_[index_i] -= 2.0 * level_set_probes_[index_i].kernel_gradient_;
 }
 //=================================================================================================//
 void RelaxationResidue<Contact<>>::interaction(size_t index_i, Real dt)
@@ -82,11 +82,15 @@ class RelaxationResidue<Inner<LevelSetCorrection>> : public RelaxationResidue<In
     explicit RelaxationResidue(ConstructorArgs<BodyRelationType, FirstArg> parameters)
         : RelaxationResidue(parameters.body_relation_, std::get<0>(parameters.others_)){};
     virtual ~RelaxationResidue(){};
+    /** probe the kernel gradient integrals of all particles in a batch */
+    virtual void setupDynamics(Real dt = 0.0) override;
     void interaction(size_t index_i, Real dt = 0.0);
 
   protected:
     StdLargeVec<Vecd> &pos_;
     LevelSetShape &level_set_shape_;
+    ParticleWithLocalRefinement *particle_refinement_; /**< nullptr if no local refinement */
+    StdLargeVec<LevelSetProbe> level_set_probes_;
 };
 
 template <>
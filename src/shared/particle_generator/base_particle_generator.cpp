@@ -52,6 +52,32 @@ void ParticleGenerator<Observer>::initializeGeometricVariables()
     }
 }
 //=================================================================================================//
+StdVec<Vecd> observationPositionsOnLine(const Vecd &start, const Vecd &end, size_t number_of_positions)
+{
+    StdVec<Vecd> positions;
+    Real segments = Real(SMAX(number_of_positions, size_t(2)) - 1);
+    for (size_t i = 0; i != number_of_positions; ++i)
+    {
+        positions.push_back(start + Real(i) / segments * (end - start));
+    }
+    return positions;
+}
+//=================================================================================================//
+StdVec<Vecd> observationPositionsOnPlane(const Vecd &corner, const Vecd &first_edge, const Vecd &second_edge,
+                                         size_t first_number_of_positions, size_t second_number_of_positions)
+{
+    StdVec<Vecd> positions;
+    Real second_segments = Real(SMAX(second_number_of_positions, size_t(2)) - 1);
+    for (size_t j = 0; j != second_number_of_positions; ++j)
+    {
+        StdVec<Vecd> line_positions = observationPositionsOnLine(
+            corner + Real(j) / second_segments * second_edge,
+            corner + Real(j) / second_segments * second_edge + first_edge, first_number_of_positions);
+        positions.insert(positions.end(), line_positions.begin(), line_positions.end());
+    }
+    return positions;
+}
+//=================================================================================================//
 ParticleGenerator<Reload>::ParticleGenerator(SPHBody &sph_body, const std::string &reload_body_name)
     : ParticleGenerator<Base>(sph_body), base_material_(sph_body.getBaseMaterial())
 {
@@ -69,7 +95,15 @@ ParticleGenerator<Reload>::ParticleGenerator(SPHBody &sph_body, const std::strin
 void ParticleGenerator<Reload>::initializeGeometricVariables()
 {
     base_material_.registerReloadLocalParameters(&base_particles_);
-    base_particles_.readFromXmlForReloadParticle(file_path_);
+    std::string binary_file_path = fs::path(file_path_).replace_extension(".bin").string();
+    if (selectBinaryOrXmlFile(binary_file_path, file_path_) == binary_file_path)
+    {
+        base_particles_.readFromBinaryForReloadParticle(binary_file_path);
+    }
+    else
+    {
+        base_particles_.readFromXmlForReloadParticle(file_path_);
+    }
 }
 //=================================================================================================//
 } // namespace SPH
@@ -105,6 +105,12 @@ class ParticleGenerator<Observer> : public ParticleGenerator<Base>
     StdVec<Vecd> positions_;
 };
 
+/** evenly distributed observation positions on a line segment, including the end points */
+StdVec<Vecd> observationPositionsOnLine(const Vecd &start, const Vecd &end, size_t number_of_positions);
+/** observation positions on a lattice spanned by two edges from a corner, including the boundaries */
+StdVec<Vecd> observationPositionsOnPlane(const Vecd &corner, const Vecd &first_edge, const Vecd &second_edge,
+                                         size_t first_number_of_positions, size_t second_number_of_positions);
+
 template <> // generate particles by reloading dynamically relaxed particles
 class ParticleGenerator<Reload> : public ParticleGenerator<Base>
 {
@@ -3,7 +3,7 @@
  * @author	Xiangyu Hu and Chi Zhang
  */
 
-#include "neighborhood.h"
+#include "neighborhood.hpp"
 
 #include "all_complex_bodies.h"
 #include "base_particle_dynamics.h"
@@ -12,6 +12,11 @@
 namespace SPH
 {
 //=================================================================================================//
+template class NeighborBuilderInner<Kernel>;
+template class NeighborBuilderInnerAdaptive<Kernel>;
+template class NeighborBuilderContact<Kernel>;
+template class NeighborBuilderContactAdaptive<Kernel>;
+//=================================================================================================//
 void Neighborhood::removeANeighbor(size_t neighbor_n)
 {
     current_size_--;
@@ -20,55 +25,106 @@ void Neighborhood::removeANeighbor(size_t neighbor_n)
     dW_ijV_j_[neighbor_n] = dW_ijV_j_[current_size_];
     r_ij_[neighbor_n] = r_ij_[current_size_];
     e_ij_[neighbor_n] = e_ij_[current_size_];
+    if (skin_size_ != 0) // keep the skin neighbors contiguous after the current ones
+        j_[current_size_] = j_[current_size_ + skin_size_];
 }
 //=================================================================================================//
-void NeighborBuilder::createNeighbor(Neighborhood &neighborhood, const Real &distance,
-                                     const Vecd &displacement, size_t index_j, const Real &Vol_j)
+bool PackedNeighborStorage::checkCapacity(ParticleConfiguration &particle_configuration, size_t total_particles)
 {
-    neighborhood.j_.push_back(index_j);
-    neighborhood.W_ij_.push_back(kernel_->W(distance, displacement));
-    neighborhood.dW_ijV_j_.push_back(kernel_->dW(distance, displacement) * Vol_j);
-    neighborhood.r_ij_.push_back(distance);
-    neighborhood.e_ij_.push_back(kernel_->e(distance, displacement));
-    neighborhood.allocated_size_++;
+    return parallel_reduce(
+        IndexRange(0, total_particles), true,
+        [&](const IndexRange &r, bool is_fitted) -> bool
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                const Neighborhood &neighborhood = particle_configuration[i];
+                is_fitted = is_fitted && neighborhood.current_size_ <= neighborhood.allocated_size_;
+            }
+            return is_fitted;
+        },
+        [](bool x, bool y) -> bool
+        { return x && y; });
 }
 //=================================================================================================//
-void NeighborBuilder::initializeNeighbor(Neighborhood &neighborhood, const Real &distance,
-                                         const Vecd &displacement, size_t index_j, const Real &Vol_j)
+void PackedNeighborStorage::reallocate(ParticleConfiguration &particle_configuration, size_t total_particles)
 {
-    size_t current_size = neighborhood.current_size_;
-    neighborhood.j_[current_size] = index_j;
-    neighborhood.W_ij_[current_size] = kernel_->W(distance, displacement);
-    neighborhood.dW_ijV_j_[current_size] = kernel_->dW(distance, displacement) * Vol_j;
-    neighborhood.r_ij_[current_size] = distance;
-    neighborhood.e_ij_[current_size] = kernel_->e(distance, displacement);
+    size_t configuration_size = particle_configuration.size();
+    offsets_.resize(configuration_size + 1);
+    offsets_[0] = 0;
+    for (size_t i = 0; i != configuration_size; ++i)
+    {
+        size_t required_size = i < total_particles ? particle_configuration[i].current_size_ : 0;
+        size_t capacity = required_size + (size_t)ceil(reserve_ratio_ * Real(required_size));
+        offsets_[i + 1] = offsets_[i] + capacity;
+    }
+
+    size_t total_capacity = offsets_.back();
+    j_.resize(total_capacity);
+    W_ij_.resize(total_capacity);
+    dW_ijV_j_.resize(total_capacity);
+    r_ij_.resize(total_capacity);
+    e_ij_.resize(total_capacity);
+
+    attachConfiguration(particle_configuration);
 }
 //=================================================================================================//
-void NeighborBuilder::createNeighbor(Neighborhood &neighborhood, const Real &distance,
-                                     const Vecd &displacement, size_t index_j, const Real &Vol_j,
-                                     Real i_h_ratio, Real h_ratio_min)
+void PackedNeighborStorage::attachConfiguration(ParticleConfiguration &particle_configuration)
 {
+    parallel_for(
+        IndexRange(0, particle_configuration.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                Neighborhood &neighborhood = particle_configuration[i];
+                size_t offset = offsets_[i];
+                neighborhood.j_.attach(j_.data() + offset);
+                neighborhood.W_ij_.attach(W_ij_.data() + offset);
+                neighborhood.dW_ijV_j_.attach(dW_ijV_j_.data() + offset);
+                neighborhood.r_ij_.attach(r_ij_.data() + offset);
+                neighborhood.e_ij_.attach(e_ij_.data() + offset);
+                neighborhood.allocated_size_ = offsets_[i + 1] - offset;
+                neighborhood.current_size_ = 0;
+                neighborhood.skin_size_ = 0;
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void NeighborBuilder::createNeighborWithinSkin(Neighborhood &neighborhood, size_t index_j)
+{
+    if (neighborhood.isPacked())
+        return; // the overflow is handled by PackedNeighborStorage
     neighborhood.j_.push_back(index_j);
-    Real weight = distance < kernel_->CutOffRadius(i_h_ratio) ? kernel_->W(i_h_ratio, distance, displacement) : 0.0;
-    neighborhood.W_ij_.push_back(weight);
-    neighborhood.dW_ijV_j_.push_back(kernel_->dW(h_ratio_min, distance, displacement) * Vol_j);
-    neighborhood.r_ij_.push_back(distance);
-    neighborhood.e_ij_.push_back(displacement / (distance + TinyReal));
+    neighborhood.W_ij_.push_back(0.0);
+    neighborhood.dW_ijV_j_.push_back(0.0);
+    neighborhood.r_ij_.push_back(0.0);
+    neighborhood.e_ij_.push_back(Vecd::Zero());
     neighborhood.allocated_size_++;
 }
 //=================================================================================================//
-void NeighborBuilder::initializeNeighbor(Neighborhood &neighborhood, const Real &distance,
-                                         const Vecd &displacement, size_t index_j, const Real &Vol_j,
-                                         Real i_h_ratio, Real h_ratio_min)
+void NeighborBuilder::initializeNeighborWithinSkin(Neighborhood &neighborhood, size_t index_j)
 {
-    size_t current_size = neighborhood.current_size_;
-    neighborhood.j_[current_size] = index_j;
-    neighborhood.W_ij_[current_size] = distance < kernel_->CutOffRadius(i_h_ratio)
-                                           ? kernel_->W(i_h_ratio, distance, displacement)
-                                           : 0.0;
-    neighborhood.dW_ijV_j_[current_size] = kernel_->dW(h_ratio_min, distance, displacement) * Vol_j;
-    neighborhood.r_ij_[current_size] = distance;
-    neighborhood.e_ij_[current_size] = displacement / (distance + TinyReal);
+    neighborhood.j_[neighborhood.current_size_] = index_j;
+}
+//=================================================================================================//
+void NeighborBuilder::updateNeighborsWithinSkin(Neighborhood &neighborhood, const Vecd &pos_i,
+                                                StdLargeVec<Vecd> &pos_j, StdLargeVec<Real> &Vol_j)
+{
+    size_t total_size = neighborhood.current_size_ + neighborhood.skin_size_;
+    neighborhood.current_size_ = 0;
+    for (size_t n = 0; n != total_size; ++n)
+    {
+        size_t index_j = neighborhood.j_[n];
+        Vecd displacement = pos_i - pos_j[index_j];
+        if (kernel_->checkIfWithinCutOffRadius(displacement))
+        {
+            neighborhood.j_[n] = neighborhood.j_[neighborhood.current_size_];
+            initializeNeighbor(neighborhood, displacement.norm(), displacement, index_j, Vol_j[index_j]);
+            neighborhood.current_size_++;
+        }
+    }
+    neighborhood.skin_size_ = total_size - neighborhood.current_size_;
 }
 //=================================================================================================//
 Kernel *NeighborBuilder::chooseKernel(SPHBody &body, SPHBody &target_body)
@@ -78,16 +134,19 @@ Kernel *NeighborBuilder::chooseKernel(SPHBody &body, SPHBody &target_body)
     return kernel->SmoothingLength() > target_kernel->SmoothingLength() ? kernel : target_kernel;
 }
 //=================================================================================================//
-NeighborBuilderInner::NeighborBuilderInner(SPHBody &body)
+NeighborBuilderInnerSymmetric::NeighborBuilderInnerSymmetric(SPHBody &body)
     : NeighborBuilder(body.sph_adaptation_->getKernel()) {}
 //=================================================================================================//
-void NeighborBuilderInner::operator()(Neighborhood &neighborhood,
-                                      const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+void NeighborBuilderInnerSymmetric::operator()(Neighborhood &neighborhood,
+                                               const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
 {
     size_t index_j = std::get<0>(list_data_j);
+    if (index_j <= index_i)
+        return;
+
     Vecd displacement = pos_i - std::get<1>(list_data_j);
     Real distance_metric = displacement.squaredNorm();
-    if (kernel_->checkIfWithinCutOffRadius(displacement) && index_i != index_j)
+    if (kernel_->checkIfWithinCutOffRadius(displacement))
     {
         neighborhood.current_size_ >= neighborhood.allocated_size_
             ? createNeighbor(neighborhood, std::sqrt(distance_metric), displacement, index_j, std::get<2>(list_data_j))
@@ -96,25 +155,21 @@ void NeighborBuilderInner::operator()(Neighborhood &neighborhood,
     }
 };
 //=================================================================================================//
-NeighborBuilderInnerAdaptive::
-    NeighborBuilderInnerAdaptive(SPHBody &body)
+NeighborBuilderInnerWithSkin::NeighborBuilderInnerWithSkin(SPHBody &body, Real skin_distance)
     : NeighborBuilder(body.sph_adaptation_->getKernel()),
-      h_ratio_(*body.getBaseParticles().getVariableByName<Real>("SmoothingLengthRatio")) {}
+      search_radius_sqr_(pow(kernel_->CutOffRadius() + skin_distance, 2)) {}
 //=================================================================================================//
-void NeighborBuilderInnerAdaptive::
-operator()(Neighborhood &neighborhood, const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+void NeighborBuilderInnerWithSkin::operator()(Neighborhood &neighborhood,
+                                              const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
 {
     size_t index_j = std::get<0>(list_data_j);
     Vecd displacement = pos_i - std::get<1>(list_data_j);
-    Real distance = displacement.norm();
-    Real i_h_ratio = h_ratio_[index_i];
-    Real h_ratio_min = SMIN(i_h_ratio, h_ratio_[index_j]);
-    Real cutoff_radius = kernel_->CutOffRadius(h_ratio_min);
-    if (distance < cutoff_radius && index_i != index_j)
+    Real distance_metric = displacement.squaredNorm();
+    if (distance_metric < search_radius_sqr_ && index_i != index_j)
     {
         neighborhood.current_size_ >= neighborhood.allocated_size_
-            ? createNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j), i_h_ratio, h_ratio_min)
-            : initializeNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j), i_h_ratio, h_ratio_min);
+            ? createNeighborWithinSkin(neighborhood, index_j)
+            : initializeNeighborWithinSkin(neighborhood, index_j);
         neighborhood.current_size_++;
     }
 };
@@ -129,10 +184,11 @@ void NeighborBuilderSelfContact::operator()(Neighborhood &neighborhood,
 {
     size_t index_j = std::get<0>(list_data_j);
     Vecd displacement = pos_i - std::get<1>(list_data_j);
-    Real distance = displacement.norm();
-    Real distance0 = (pos0_[index_i] - pos0_[index_j]).norm();
-    if (distance < kernel_->CutOffRadius() && distance0 > kernel_->CutOffRadius())
+    Real distance_metric = displacement.squaredNorm();
+    Real distance0_metric = (pos0_[index_i] - pos0_[index_j]).squaredNorm();
+    if (distance_metric < kernel_->CutOffRadiusSqr() && distance0_metric > kernel_->CutOffRadiusSqr())
     {
+        Real distance = std::sqrt(distance_metric);
         neighborhood.current_size_ >= neighborhood.allocated_size_
             ? createNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j))
             : initializeNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j));
@@ -140,26 +196,27 @@ void NeighborBuilderSelfContact::operator()(Neighborhood &neighborhood,
     }
 };
 //=================================================================================================//
-NeighborBuilderContact::NeighborBuilderContact(SPHBody &body, SPHBody &contact_body)
-    : NeighborBuilder(NeighborBuilder::chooseKernel(body, contact_body)) {}
+NeighborBuilderContactWithSkin::NeighborBuilderContactWithSkin(SPHBody &body, SPHBody &contact_body, Real skin_distance)
+    : NeighborBuilder(NeighborBuilder::chooseKernel(body, contact_body)),
+      search_radius_(kernel_->CutOffRadius() + skin_distance) {}
 //=================================================================================================//
-void NeighborBuilderContact::operator()(Neighborhood &neighborhood,
-                                        const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+void NeighborBuilderContactWithSkin::operator()(Neighborhood &neighborhood,
+                                                const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
 {
     size_t index_j = std::get<0>(list_data_j);
     Vecd displacement = pos_i - std::get<1>(list_data_j);
-    Real distance = displacement.norm();
-    if (distance < kernel_->CutOffRadius())
+    Real distance_metric = displacement.squaredNorm();
+    if (distance_metric < search_radius_ * search_radius_)
     {
         neighborhood.current_size_ >= neighborhood.allocated_size_
-            ? createNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j))
-            : initializeNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j));
+            ? createNeighborWithinSkin(neighborhood, index_j)
+            : initializeNeighborWithinSkin(neighborhood, index_j);
         neighborhood.current_size_++;
     }
 };
 //=================================================================================================//
 NeighborBuilderSurfaceContact::NeighborBuilderSurfaceContact(SPHBody &body, SPHBody &contact_body)
-    : NeighborBuilderContact(body, contact_body)
+    : NeighborBuilderContact<>(body, contact_body)
 {
     Real source_smoothing_length = body.sph_adaptation_->ReferenceSmoothingLength();
     Real target_smoothing_length = contact_body.sph_adaptation_->ReferenceSmoothingLength();
@@ -184,9 +241,10 @@ void NeighborBuilderContactBodyPart::operator()(Neighborhood &neighborhood,
 {
     size_t index_j = std::get<0>(list_data_j);
     Vecd displacement = pos_i - std::get<1>(list_data_j);
-    Real distance = displacement.norm();
-    if (distance < kernel_->CutOffRadius() && part_indicator_[index_j] == 1)
+    Real distance_metric = displacement.squaredNorm();
+    if (distance_metric < kernel_->CutOffRadiusSqr() && part_indicator_[index_j] == 1)
     {
+        Real distance = std::sqrt(distance_metric);
         neighborhood.current_size_ >= neighborhood.allocated_size_
             ? createNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j))
             : initializeNeighbor(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j));
@@ -194,31 +252,6 @@ void NeighborBuilderContactBodyPart::operator()(Neighborhood &neighborhood,
     }
 }
 //=================================================================================================//
-NeighborBuilderContactAdaptive::NeighborBuilderContactAdaptive(SPHBody &body, SPHBody &contact_body)
-    : NeighborBuilder(body.sph_adaptation_->getKernel()), adaptation_(*body.sph_adaptation_),
-      contact_adaptation_(*contact_body.sph_adaptation_),
-      relative_h_ref_(adaptation_.ReferenceSmoothingLength() /
-                      contact_adaptation_.ReferenceSmoothingLength()) {}
-//=================================================================================================//
-void NeighborBuilderContactAdaptive::operator()(Neighborhood &neighborhood,
-                                                const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
-{
-    size_t index_j = std::get<0>(list_data_j);
-    Vecd displacement = pos_i - std::get<1>(list_data_j);
-    Real distance_metric = displacement.squaredNorm();
-    Real i_h_ratio = adaptation_.SmoothingLengthRatio(index_i);
-    Real h_ratio_min = SMIN(i_h_ratio, relative_h_ref_ * contact_adaptation_.SmoothingLengthRatio(index_j));
-    if (distance_metric < kernel_->CutOffRadiusSqr(h_ratio_min))
-    {
-        neighborhood.current_size_ >= neighborhood.allocated_size_
-            ? createNeighbor(neighborhood, std::sqrt(distance_metric),
-                             displacement, index_j, std::get<2>(list_data_j), i_h_ratio, h_ratio_min)
-            : initializeNeighbor(neighborhood, std::sqrt(distance_metric),
-                                 displacement, index_j, std::get<2>(list_data_j), i_h_ratio, h_ratio_min);
-        neighborhood.current_size_++;
-    }
-}
-//=================================================================================================//
 BaseNeighborBuilderContactShell::BaseNeighborBuilderContactShell(SPHBody &shell_body)
     : NeighborBuilder(shell_body.sph_adaptation_->getKernel()),
       n_(*shell_body.getBaseParticles().getVariableByName<Vecd>("NormalDirection")),
@@ -230,6 +263,8 @@ BaseNeighborBuilderContactShell::BaseNeighborBuilderContactShell(SPHBody &shell_
 void BaseNeighborBuilderContactShell::createNeighbor(Neighborhood &neighborhood, const Real &distance,
                                                      size_t index_j, const Real &W_ij, const Real &dW_ijV_j, const Vecd &e_ij)
 {
+    if (neighborhood.isPacked())
+        return; // the overflow is handled by PackedNeighborStorage
     neighborhood.j_.push_back(index_j);
     neighborhood.W_ij_.push_back(W_ij);
     neighborhood.dW_ijV_j_.push_back(dW_ijV_j);
@@ -394,7 +429,7 @@ void NeighborBuilderContactFromShell::operator()(Neighborhood &neighborhood,
     }
 };
 //=================================================================================================//
-ShellNeighborBuilderInnerWithContactKernel::ShellNeighborBuilderInnerWithContactKernel(SPHBody &body, SPHBody &contact_body) : NeighborBuilderInner(body)
+ShellNeighborBuilderInnerWithContactKernel::ShellNeighborBuilderInnerWithContactKernel(SPHBody &body, SPHBody &contact_body) : NeighborBuilderInner<>(body)
 {
     // create a reduced kernel with refined smoothing length for shell
     Real smoothing_length = contact_body.sph_adaptation_->ReferenceSmoothingLength();
@@ -35,6 +35,12 @@
 #include "base_data_package.h"
 #include "sph_data_containers.h"
 
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+
 namespace SPH
 {
 
@@ -42,6 +48,114 @@ class SPHBody;
 class BodyPart;
 class SPHAdaptation;
 
+/**
+ * @class NeighborArray
+ * @brief The array of a neighbor quantity of particle i.
+ * It either owns its data, which grows by push_back,
+ * or refers to a segment of the contiguous block of a PackedNeighborStorage.
+ * The owned data are managed directly with the allocator of StdLargeVec,
+ * so that the array takes no more memory than a bare StdLargeVec.
+ */
+template <typename DataType>
+class NeighborArray
+{
+    static_assert(std::is_trivially_destructible<DataType>::value,
+                  "NeighborArray does not destroy its entries.");
+    using Allocator = typename StdLargeVec<DataType>::allocator_type;
+
+    DataType *data_;
+    uint32_t size_;     /**< the number of owned entries */
+    uint32_t capacity_; /**< the capacity of the owned data, zero for a view */
+    bool is_view_;
+
+    void release()
+    {
+        if (!is_view_ && data_ != nullptr)
+            Allocator().deallocate(data_, capacity_);
+        data_ = nullptr;
+        size_ = capacity_ = 0;
+        is_view_ = false;
+    };
+
+    /** the only place where data_ is taken from another array */
+    void assign(const NeighborArray &other)
+    {
+        size_ = capacity_ = other.is_view_ ? 0 : other.size_;
+        is_view_ = other.is_view_;
+        data_ = is_view_ ? other.data_ : (size_ == 0 ? nullptr : Allocator().allocate(size_));
+        if (!is_view_)
+            std::uninitialized_copy_n(other.data_, size_, data_);
+    };
+
+    /** take over the data of the other array, which is left empty */
+    void steal(NeighborArray &other) noexcept
+    {
+        data_ = other.data_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        is_view_ = other.is_view_;
+        other.data_ = nullptr;
+        other.size_ = other.capacity_ = 0;
+        other.is_view_ = false;
+    };
+
+  public:
+    NeighborArray() : data_(nullptr), size_(0), capacity_(0), is_view_(false){};
+    NeighborArray(const NeighborArray &other) { assign(other); };
+    NeighborArray(NeighborArray &&other) noexcept { steal(other); };
+    NeighborArray &operator=(const NeighborArray &other)
+    {
+        if (this != &other)
+        {
+            release();
+            assign(other);
+        }
+        return *this;
+    };
+    NeighborArray &operator=(NeighborArray &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            steal(other);
+        }
+        return *this;
+    };
+    ~NeighborArray() { release(); };
+
+    DataType &operator[](size_t n) { return data_[n]; };
+    const DataType &operator[](size_t n) const { return data_[n]; };
+    DataType *data() { return data_; };
+    bool isView() const { return is_view_; };
+
+    /** append to the owned data, which grow geometrically, a view starts owning anew */
+    void push_back(const DataType &value)
+    {
+        if (is_view_)
+            release();
+        if (size_ == capacity_)
+        {
+            uint32_t new_capacity = capacity_ == 0 ? 4 : 2 * capacity_;
+            DataType *new_data = Allocator().allocate(new_capacity);
+            std::uninitialized_copy_n(data_, size_, new_data);
+            if (data_ != nullptr)
+                Allocator().deallocate(data_, capacity_);
+            data_ = new_data;
+            capacity_ = new_capacity;
+        }
+        new (data_ + size_) DataType(value);
+        ++size_;
+    };
+
+    /** release the owned data and refer to an external memory segment */
+    void attach(DataType *external_data)
+    {
+        release();
+        data_ = external_data;
+        is_view_ = true;
+    };
+};
+
 /**
  * @class Neighborhood
  * @brief A neighborhood around particle i.
@@ -50,24 +164,188 @@ class Neighborhood
 {
   public:
     size_t current_size_;   /**< the current number of neighbors */
+    size_t skin_size_;      /**< the number of neighbors within a Verlet skin, stored after the current ones */
     size_t allocated_size_; /**< the limit of neighbors does not require memory allocation  */
 
-    StdLargeVec<size_t> j_;      /**< index of the neighbor particle. */
-    StdLargeVec<Real> W_ij_;     /**< kernel value or particle volume contribution */
-    StdLargeVec<Real> dW_ijV_j_; /**< derivative of kernel function or inter-particle surface contribution */
-    StdLargeVec<Real> r_ij_;     /**< distance between j and i. */
-    StdLargeVec<Vecd> e_ij_;     /**< unit vector pointing from j to i or inter-particle surface direction */
+    NeighborArray<size_t> j_;      /**< index of the neighbor particle. */
+    NeighborArray<NeighborReal> W_ij_;     /**< kernel value or particle volume contribution */
+    NeighborArray<NeighborReal> dW_ijV_j_; /**< derivative of kernel function or inter-particle surface contribution */
+    NeighborArray<NeighborReal> r_ij_;     /**< distance between j and i. */
+    NeighborArray<Vecd> e_ij_;     /**< unit vector pointing from j to i or inter-particle surface direction */
 
-    Neighborhood() : current_size_(0), allocated_size_(0){};
-    ~Neighborhood(){};
+    Neighborhood() : current_size_(0), skin_size_(0), allocated_size_(0){};
 
     void removeANeighbor(size_t neighbor_n);
+    /** whether the neighbor data are stored in the contiguous block of a PackedNeighborStorage */
+    bool isPacked() const { return j_.isView(); };
 };
 using ParticleConfiguration = StdLargeVec<Neighborhood>;
 
+/**
+ * @class PackedNeighborStorage
+ * @brief Contiguous (CSR-like) storage for all the neighborhoods of a particle configuration.
+ * Each particle owns a segment [offsets_[i], offsets_[i + 1]) of the flat neighbor arrays,
+ * so that the configuration is built without per-particle memory allocation
+ * and the neighbor data of successive particles are adjacent in memory.
+ * The segments are laid out again, with some reserve, only when a particle has more neighbors
+ * than its segment capacity, which is detected after a search by checkCapacity.
+ */
+class PackedNeighborStorage
+{
+  protected:
+    Real reserve_ratio_;          /**< extra capacity relative to the current number of neighbors */
+    StdLargeVec<size_t> offsets_; /**< starting position of the neighbors of each particle */
+    StdLargeVec<size_t> j_;
+    StdLargeVec<NeighborReal> W_ij_;
+    StdLargeVec<NeighborReal> dW_ijV_j_;
+    StdLargeVec<NeighborReal> r_ij_;
+    StdLargeVec<Vecd> e_ij_;
+
+    /** let all neighborhoods of the configuration refer to their segments */
+    void attachConfiguration(ParticleConfiguration &particle_configuration);
+
+  public:
+    explicit PackedNeighborStorage(Real reserve_ratio = 0.2) : reserve_ratio_(reserve_ratio){};
+    virtual ~PackedNeighborStorage(){};
+
+    /** check whether the neighbors found in the last search fitted into the segments */
+    bool checkCapacity(ParticleConfiguration &particle_configuration, size_t total_particles);
+    /** lay out the segments again according to the neighbor numbers of the last search */
+    void reallocate(ParticleConfiguration &particle_configuration, size_t total_particles);
+    /** total number of neighbor entries allocated */
+    size_t TotalCapacity() { return offsets_.empty() ? 0 : offsets_.back(); };
+};
+
+/**
+ * @class KernelFunctions
+ * @brief The kernel functions used for building the neighbors called through a concrete kernel type,
+ * whose kernel functions are final and inline, instead of the virtual interface of Kernel,
+ * so that the computation from the distance to the kernel values is inlined.
+ * The kernel should be exactly of KernelType, not a derived type such as an anisotropic kernel.
+ * For KernelType = Kernel, see the specialization below, the virtual interface is called.
+ */
+template <class KernelType>
+class KernelFunctions
+{
+    const KernelType &kernel_;
+
+  public:
+    explicit KernelFunctions(Kernel *kernel) : kernel_(*static_cast<KernelType *>(kernel)){};
+    Real CutOffRadiusSqr() const { return kernel_.CutOffRadiusSqr(); };
+    Real CutOffRadius(Real h_ratio) const { return kernel_.CutOffRadius(h_ratio); };
+    Real CutOffRadiusSqr(Real h_ratio) const { return kernel_.CutOffRadiusSqr(h_ratio); };
+    bool checkIfWithinCutOffRadius(const Vecd &displacement) const
+    {
+        return displacement.squaredNorm() < kernel_.CutOffRadiusSqr();
+    };
+    Vecd e(const Real &distance, const Vecd &displacement) const { return displacement / (distance + TinyReal); };
+
+    Real W(const Real &distance, const Vec2d &displacement) const
+    {
+        return kernel_.FactorW2D() * kernel_.KernelType::W_2D(distance * kernel_.InverseSmoothingLength());
+    };
+    Real W(const Real &distance, const Vec3d &displacement) const
+    {
+        return kernel_.FactorW3D() * kernel_.KernelType::W_3D(distance * kernel_.InverseSmoothingLength());
+    };
+    Real dW(const Real &distance, const Vec2d &displacement) const
+    {
+        return kernel_.FactordW2D() * kernel_.KernelType::dW_2D(distance * kernel_.InverseSmoothingLength());
+    };
+    Real dW(const Real &distance, const Vec3d &displacement) const
+    {
+        return kernel_.FactordW3D() * kernel_.KernelType::dW_3D(distance * kernel_.InverseSmoothingLength());
+    };
+    //----------------------------------------------------------------------
+    //	Below are for variable smoothing length.
+    //----------------------------------------------------------------------
+    Real W(const Real &h_ratio, const Real &distance, const Vec2d &displacement) const
+    {
+        Real q = distance * kernel_.InverseSmoothingLength() * h_ratio;
+        return kernel_.FactorW2D(h_ratio) * kernel_.KernelType::W_2D(q);
+    };
+    Real W(const Real &h_ratio, const Real &distance, const Vec3d &displacement) const
+    {
+        Real q = distance * kernel_.InverseSmoothingLength() * h_ratio;
+        return kernel_.FactorW3D(h_ratio) * kernel_.KernelType::W_3D(q);
+    };
+    Real dW(const Real &h_ratio, const Real &distance, const Vec2d &displacement) const
+    {
+        Real q = distance * kernel_.InverseSmoothingLength() * h_ratio;
+        return kernel_.FactordW2D(h_ratio) * kernel_.KernelType::dW_2D(q);
+    };
+    Real dW(const Real &h_ratio, const Real &distance, const Vec3d &displacement) const
+    {
+        Real q = distance * kernel_.InverseSmoothingLength() * h_ratio;
+        return kernel_.FactordW3D(h_ratio) * kernel_.KernelType::dW_3D(q);
+    };
+};
+
+/**
+ * @class KernelFunctions<Kernel>
+ * @brief The kernel functions called through the virtual interface of Kernel,
+ * used for the kernels without specialized neighbor search.
+ */
+template <>
+class KernelFunctions<Kernel>
+{
+    Kernel &kernel_;
+
+  public:
+    explicit KernelFunctions(Kernel *kernel) : kernel_(*kernel){};
+    Real CutOffRadiusSqr() const { return kernel_.CutOffRadiusSqr(); };
+    Real CutOffRadius(Real h_ratio) const { return kernel_.CutOffRadius(h_ratio); };
+    Real CutOffRadiusSqr(Real h_ratio) const { return kernel_.CutOffRadiusSqr(h_ratio); };
+    bool checkIfWithinCutOffRadius(const Vecd &displacement) const
+    {
+        return kernel_.checkIfWithinCutOffRadius(displacement);
+    };
+    Vecd e(const Real &distance, const Vecd &displacement) const { return kernel_.e(distance, displacement); };
+    Real W(const Real &distance, const Vecd &displacement) const { return kernel_.W(distance, displacement); };
+    Real dW(const Real &distance, const Vecd &displacement) const { return kernel_.dW(distance, displacement); };
+    Real W(const Real &h_ratio, const Real &distance, const Vecd &displacement) const
+    {
+        return kernel_.W(h_ratio, distance, displacement);
+    };
+    Real dW(const Real &h_ratio, const Real &distance, const Vecd &displacement) const
+    {
+        return kernel_.dW(h_ratio, distance, displacement);
+    };
+};
+
+/** a tag to pass a kernel type to a generic lambda */
+template <class KernelType>
+struct KernelTypeTag
+{
+    using type = KernelType;
+};
+
+/**
+ * @brief Call the function with a KernelTypeTag of the concrete type of the kernel,
+ * if the neighbor builders are specialized for it, or with that of Kernel otherwise.
+ * The kernel types with specialized neighbor builders are
+ * KernelWendlandC2, KernelCubicBSpline and their tabulated versions.
+ */
+template <typename FunctionType>
+void dispatchKernelType(Kernel *kernel, bool is_specialized, const FunctionType &function)
+{
+    const std::type_info &kernel_type = typeid(*kernel);
+    if (is_specialized && kernel_type == typeid(KernelWendlandC2))
+        return function(KernelTypeTag<KernelWendlandC2>());
+    if (is_specialized && kernel_type == typeid(KernelCubicBSpline))
+        return function(KernelTypeTag<KernelCubicBSpline>());
+    if (is_specialized && kernel_type == typeid(KernelTabulated<KernelWendlandC2>))
+        return function(KernelTypeTag<KernelTabulated<KernelWendlandC2>>());
+    if (is_specialized && kernel_type == typeid(KernelTabulated<KernelCubicBSpline>))
+        return function(KernelTypeTag<KernelTabulated<KernelCubicBSpline>>());
+    function(KernelTypeTag<Kernel>());
+}
+
 /**
  * @class NeighborBuilder
  * @brief Base class for building a neighbor particle j around particles i.
+ * @details The kernel values are computed with KernelFunctions<KernelType>,
+ * which calls the virtual interface of the kernel by default.
  */
 class NeighborBuilder
 {
@@ -76,28 +354,91 @@ class NeighborBuilder
     //----------------------------------------------------------------------
     //	Below are for constant smoothing length.
     //----------------------------------------------------------------------
+    template <class KernelType = Kernel>
     void createNeighbor(Neighborhood &neighborhood, const Real &distance,
-                        const Vecd &displacement, size_t j_index, const Real &Vol_j);
+                        const Vecd &displacement, size_t j_index, const Real &Vol_j)
+    {
+        if (neighborhood.isPacked())
+            return; // the overflow is handled by PackedNeighborStorage
+        KernelFunctions<KernelType> kernel(kernel_);
+        neighborhood.j_.push_back(j_index);
+        neighborhood.W_ij_.push_back(kernel.W(distance, displacement));
+        neighborhood.dW_ijV_j_.push_back(kernel.dW(distance, displacement) * Vol_j);
+        neighborhood.r_ij_.push_back(distance);
+        neighborhood.e_ij_.push_back(kernel.e(distance, displacement));
+        neighborhood.allocated_size_++;
+    };
+    template <class KernelType = Kernel>
     void initializeNeighbor(Neighborhood &neighborhood, const Real &distance,
-                            const Vecd &displacement, size_t j_index, const Real &Vol_j);
+                            const Vecd &displacement, size_t j_index, const Real &Vol_j)
+    {
+        KernelFunctions<KernelType> kernel(kernel_);
+        size_t current_size = neighborhood.current_size_;
+        neighborhood.j_[current_size] = j_index;
+        neighborhood.W_ij_[current_size] = kernel.W(distance, displacement);
+        neighborhood.dW_ijV_j_[current_size] = kernel.dW(distance, displacement) * Vol_j;
+        neighborhood.r_ij_[current_size] = distance;
+        neighborhood.e_ij_[current_size] = kernel.e(distance, displacement);
+    };
     //----------------------------------------------------------------------
     //	Below are for variable smoothing length.
     //----------------------------------------------------------------------
+    template <class KernelType = Kernel>
     void createNeighbor(Neighborhood &neighborhood, const Real &distance,
-                        const Vecd &displacement, size_t j_index, const Real &Vol_j, Real i_h_ratio, Real h_ratio_min);
+                        const Vecd &displacement, size_t j_index, const Real &Vol_j, Real i_h_ratio, Real h_ratio_min)
+    {
+        if (neighborhood.isPacked())
+            return; // the overflow is handled by PackedNeighborStorage
+        KernelFunctions<KernelType> kernel(kernel_);
+        neighborhood.j_.push_back(j_index);
+        Real weight = distance < kernel.CutOffRadius(i_h_ratio) ? kernel.W(i_h_ratio, distance, displacement) : 0.0;
+        neighborhood.W_ij_.push_back(weight);
+        neighborhood.dW_ijV_j_.push_back(kernel.dW(h_ratio_min, distance, displacement) * Vol_j);
+        neighborhood.r_ij_.push_back(distance);
+        neighborhood.e_ij_.push_back(displacement / (distance + TinyReal));
+        neighborhood.allocated_size_++;
+    };
+    template <class KernelType = Kernel>
     void initializeNeighbor(Neighborhood &neighborhood, const Real &distance,
-                            const Vecd &displacement, size_t j_index, const Real &Vol_j, Real i_h_ratio, Real h_ratio_min);
-    static Kernel *chooseKernel(SPHBody &body, SPHBody &target_body);
+                            const Vecd &displacement, size_t j_index, const Real &Vol_j, Real i_h_ratio, Real h_ratio_min)
+    {
+        KernelFunctions<KernelType> kernel(kernel_);
+        size_t current_size = neighborhood.current_size_;
+        neighborhood.j_[current_size] = j_index;
+        neighborhood.W_ij_[current_size] = distance < kernel.CutOffRadius(i_h_ratio)
+                                               ? kernel.W(i_h_ratio, distance, displacement)
+                                               : 0.0;
+        neighborhood.dW_ijV_j_[current_size] = kernel.dW(h_ratio_min, distance, displacement) * Vol_j;
+        neighborhood.r_ij_[current_size] = distance;
+        neighborhood.e_ij_[current_size] = displacement / (distance + TinyReal);
+    };
+    //----------------------------------------------------------------------
+    //	Below are for neighbors searched within a skin beyond the cut-off radius.
+    //----------------------------------------------------------------------
+    void createNeighborWithinSkin(Neighborhood &neighborhood, size_t j_index);
+    void initializeNeighborWithinSkin(Neighborhood &neighborhood, size_t j_index);
 
   public:
     NeighborBuilder(Kernel *kernel) : kernel_(kernel){};
     virtual ~NeighborBuilder(){};
+    /** the kernel with the larger smoothing length, used for the contact between two bodies */
+    static Kernel *chooseKernel(SPHBody &body, SPHBody &target_body);
+    Real CutOffRadiusSqr() { return kernel_->CutOffRadiusSqr(); };
+    /**
+     * Compute the neighbors within the cut-off radius for the present positions from all
+     * the neighbors searched within the skin. These are promoted to the front and counted by current_size_,
+     * the others are kept after them and counted by skin_size_.
+     */
+    void updateNeighborsWithinSkin(Neighborhood &neighborhood, const Vecd &pos_i,
+                                   StdLargeVec<Vecd> &pos_j, StdLargeVec<Real> &Vol_j);
 };
 
 /**
  * @class NeighborBuilderInner
  * @brief A inner neighbor builder functor.
+ * The kernel functions are called through KernelType, see KernelFunctions.
  */
+template <class KernelType = Kernel>
 class NeighborBuilderInner : public NeighborBuilder
 {
   public:
@@ -106,10 +447,45 @@ class NeighborBuilderInner : public NeighborBuilder
                     const Vecd &pos_i, size_t index_i, const ListData &list_data_j);
 };
 
+/**
+ * @class NeighborBuilderInnerSymmetric
+ * @brief A inner neighbor builder functor only taking the neighbors with larger particle index,
+ * so that each particle pair is included only once in the configuration.
+ */
+class NeighborBuilderInnerSymmetric : public NeighborBuilder
+{
+  public:
+    explicit NeighborBuilderInnerSymmetric(SPHBody &body);
+    void operator()(Neighborhood &neighborhood,
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j);
+};
+
+/**
+ * @class NeighborBuilderInnerWithSkin
+ * @brief A inner neighbor builder functor searching within the cut-off radius plus a skin distance.
+ * @details Only the indexes of the neighbors are stored at the search.
+ * The kernel values are computed by updateNeighborsWithinSkin,
+ * so that the configuration can be reused until a particle moves further than half the skin.
+ */
+class NeighborBuilderInnerWithSkin : public NeighborBuilder
+{
+  protected:
+    Real search_radius_sqr_;
+
+  public:
+    NeighborBuilderInnerWithSkin(SPHBody &body, Real skin_distance);
+    void operator()(Neighborhood &neighborhood,
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j);
+    Real SearchRadius() { return std::sqrt(search_radius_sqr_); };
+    Real SearchRadiusSqr() { return search_radius_sqr_; };
+};
+
 /**
  * @class NeighborBuilderInnerAdaptive
  * @brief A inner neighbor builder functor when the particles have different smoothing lengths.
+ * The kernel functions are called through KernelType, see KernelFunctions.
  */
+template <class KernelType = Kernel>
 class NeighborBuilderInnerAdaptive : public NeighborBuilder
 {
   public:
@@ -140,7 +516,9 @@ class NeighborBuilderSelfContact : public NeighborBuilder
 /**
  * @class NeighborBuilderContact
  * @brief A contact neighbor builder functor for contact relation.
+ * The kernel functions are called through KernelType, see KernelFunctions.
  */
+template <class KernelType = Kernel>
 class NeighborBuilderContact : public NeighborBuilder
 {
   public:
@@ -150,11 +528,28 @@ class NeighborBuilderContact : public NeighborBuilder
                             const Vecd &pos_i, size_t index_i, const ListData &list_data_j);
 };
 
+/**
+ * @class NeighborBuilderContactWithSkin
+ * @brief A contact neighbor builder functor searching within the cut-off radius plus a skin distance.
+ * @details As NeighborBuilderInnerWithSkin, only the indexes of the neighbors are stored at the search.
+ */
+class NeighborBuilderContactWithSkin : public NeighborBuilder
+{
+  protected:
+    Real search_radius_;
+
+  public:
+    NeighborBuilderContactWithSkin(SPHBody &body, SPHBody &contact_body, Real skin_distance);
+    void operator()(Neighborhood &neighborhood,
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j);
+    Real SearchRadius() { return search_radius_; };
+};
+
 /**
  * @class NeighborBuilderSurfaceContact
  * @brief A solid contact neighbor builder functor when bodies having surface contact.
  */
-class NeighborBuilderSurfaceContact : public NeighborBuilderContact
+class NeighborBuilderSurfaceContact : public NeighborBuilderContact<>
 {
   private:
     UniquePtrKeeper<Kernel> kernel_keeper_;
@@ -183,7 +578,9 @@ class NeighborBuilderContactBodyPart : public NeighborBuilder
 /**
  * @class NeighborBuilderContactAdaptive
  * @brief A contact neighbor builder functor when the particles have different smoothing lengths.
+ * The kernel functions are called through KernelType, see KernelFunctions.
  */
+template <class KernelType = Kernel>
 class NeighborBuilderContactAdaptive : public NeighborBuilder
 {
   public:
@@ -264,7 +661,7 @@ class NeighborBuilderContactFromShell : public BaseNeighborBuilderContactShell
  * @brief A inner neighbor builder functor with reduced kernel.
  * The smoothing length is equal to that of the contact body
  */
-class ShellNeighborBuilderInnerWithContactKernel : public NeighborBuilderInner
+class ShellNeighborBuilderInnerWithContactKernel : public NeighborBuilderInner<>
 {
   public:
     explicit ShellNeighborBuilderInnerWithContactKernel(SPHBody &body, SPHBody &contact_body);
@@ -0,0 +1,111 @@
+/**
+ * @file 	neighborhood.hpp
+ * @brief 	The neighbor builders templated on the kernel type.
+ * @details They are instantiated for Kernel in neighborhood.cpp.
+ * 			The body relations include this file to instantiate them
+ * 			for the kernel types with specialized neighbor search.
+ * @author	Xiangyu Hu and Chi Zhang
+ */
+
+#pragma once
+
+#include "base_body.h"
+#include "base_particles.hpp"
+#include "neighborhood.h"
+
+namespace SPH
+{
+//=================================================================================================//
+template <class KernelType>
+NeighborBuilderInner<KernelType>::NeighborBuilderInner(SPHBody &body)
+    : NeighborBuilder(body.sph_adaptation_->getKernel()) {}
+//=================================================================================================//
+template <class KernelType>
+void NeighborBuilderInner<KernelType>::operator()(Neighborhood &neighborhood,
+                                                  const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+{
+    size_t index_j = std::get<0>(list_data_j);
+    Vecd displacement = pos_i - std::get<1>(list_data_j);
+    Real distance_metric = displacement.squaredNorm();
+    if (KernelFunctions<KernelType>(kernel_).checkIfWithinCutOffRadius(displacement) && index_i != index_j)
+    {
+        neighborhood.current_size_ >= neighborhood.allocated_size_
+            ? createNeighbor<KernelType>(neighborhood, std::sqrt(distance_metric), displacement, index_j, std::get<2>(list_data_j))
+            : initializeNeighbor<KernelType>(neighborhood, std::sqrt(distance_metric), displacement, index_j, std::get<2>(list_data_j));
+        neighborhood.current_size_++;
+    }
+};
+//=================================================================================================//
+template <class KernelType>
+NeighborBuilderInnerAdaptive<KernelType>::NeighborBuilderInnerAdaptive(SPHBody &body)
+    : NeighborBuilder(body.sph_adaptation_->getKernel()),
+      h_ratio_(*body.getBaseParticles().getVariableByName<Real>("SmoothingLengthRatio")) {}
+//=================================================================================================//
+template <class KernelType>
+void NeighborBuilderInnerAdaptive<KernelType>::
+operator()(Neighborhood &neighborhood, const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+{
+    size_t index_j = std::get<0>(list_data_j);
+    Vecd displacement = pos_i - std::get<1>(list_data_j);
+    Real distance = displacement.norm();
+    Real i_h_ratio = h_ratio_[index_i];
+    Real h_ratio_min = SMIN(i_h_ratio, h_ratio_[index_j]);
+    Real cutoff_radius = KernelFunctions<KernelType>(kernel_).CutOffRadius(h_ratio_min);
+    if (distance < cutoff_radius && index_i != index_j)
+    {
+        neighborhood.current_size_ >= neighborhood.allocated_size_
+            ? createNeighbor<KernelType>(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j), i_h_ratio, h_ratio_min)
+            : initializeNeighbor<KernelType>(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j), i_h_ratio, h_ratio_min);
+        neighborhood.current_size_++;
+    }
+};
+//=================================================================================================//
+template <class KernelType>
+NeighborBuilderContact<KernelType>::NeighborBuilderContact(SPHBody &body, SPHBody &contact_body)
+    : NeighborBuilder(NeighborBuilder::chooseKernel(body, contact_body)) {}
+//=================================================================================================//
+template <class KernelType>
+void NeighborBuilderContact<KernelType>::operator()(Neighborhood &neighborhood,
+                                                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+{
+    size_t index_j = std::get<0>(list_data_j);
+    Vecd displacement = pos_i - std::get<1>(list_data_j);
+    Real distance_metric = displacement.squaredNorm();
+    if (distance_metric < KernelFunctions<KernelType>(kernel_).CutOffRadiusSqr())
+    {
+        Real distance = std::sqrt(distance_metric);
+        neighborhood.current_size_ >= neighborhood.allocated_size_
+            ? createNeighbor<KernelType>(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j))
+            : initializeNeighbor<KernelType>(neighborhood, distance, displacement, index_j, std::get<2>(list_data_j));
+        neighborhood.current_size_++;
+    }
+};
+//=================================================================================================//
+template <class KernelType>
+NeighborBuilderContactAdaptive<KernelType>::NeighborBuilderContactAdaptive(SPHBody &body, SPHBody &contact_body)
+    : NeighborBuilder(body.sph_adaptation_->getKernel()), adaptation_(*body.sph_adaptation_),
+      contact_adaptation_(*contact_body.sph_adaptation_),
+      relative_h_ref_(adaptation_.ReferenceSmoothingLength() /
+                      contact_adaptation_.ReferenceSmoothingLength()) {}
+//=================================================================================================//
+template <class KernelType>
+void NeighborBuilderContactAdaptive<KernelType>::operator()(Neighborhood &neighborhood,
+                                                            const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+{
+    size_t index_j = std::get<0>(list_data_j);
+    Vecd displacement = pos_i - std::get<1>(list_data_j);
+    Real distance_metric = displacement.squaredNorm();
+    Real i_h_ratio = adaptation_.SmoothingLengthRatio(index_i);
+    Real h_ratio_min = SMIN(i_h_ratio, relative_h_ref_ * contact_adaptation_.SmoothingLengthRatio(index_j));
+    if (distance_metric < KernelFunctions<KernelType>(kernel_).CutOffRadiusSqr(h_ratio_min))
+    {
+        neighborhood.current_size_ >= neighborhood.allocated_size_
+            ? createNeighbor<KernelType>(neighborhood, std::sqrt(distance_metric),
+                                         displacement, index_j, std::get<2>(list_data_j), i_h_ratio, h_ratio_min)
+            : initializeNeighbor<KernelType>(neighborhood, std::sqrt(distance_metric),
+                                             displacement, index_j, std::get<2>(list_data_j), i_h_ratio, h_ratio_min);
+        neighborhood.current_size_++;
+    }
+}
+//=================================================================================================//
+} // namespace SPH
@@ -4,6 +4,7 @@
 #include "base_body_part.h"
 #include "base_material.h"
 #include "base_particle_generator.h"
+#include "memory_mapped_file.h"
 #include "xml_parser.h"
 
 //=====================================================================================================//
@@ -103,6 +104,65 @@ void BaseParticles::switchToBufferParticle(size_t index)
     total_real_particles_ -= 1;
 }
 //=================================================================================================//
+void BaseParticles::createRealParticlesFrom(const StdLargeVec<size_t> &source_indices, size_t size)
+{
+    size_t first_new_particle_index = total_real_particles_;
+    parallel_for(
+        IndexRange(0, size),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                size_t new_particle_index = first_new_particle_index + n;
+                copyFromAnotherParticle(new_particle_index, source_indices[n]);
+                sorted_id_[unsorted_id_[new_particle_index]] = new_particle_index;
+            }
+        },
+        ap);
+    total_real_particles_ += size;
+}
+//=================================================================================================//
+void BaseParticles::switchToBufferParticles(StdLargeVec<size_t> &indices, size_t size)
+{
+    if (size == 0)
+        return;
+
+    std::sort(indices.begin(), indices.begin() + size);
+    size_t new_total_real_particles = total_real_particles_ - size;
+    // vacated positions are the switched particles below the new total, and the same number of
+    // particles, which are not switched, are left in the range from the new total to the old one
+    size_t number_of_vacated = std::lower_bound(indices.begin(), indices.begin() + size,
+                                                new_total_real_particles) -
+                               indices.begin();
+    StdVec<size_t> remaining_particles;
+    remaining_particles.reserve(number_of_vacated);
+    size_t k = number_of_vacated;
+    for (size_t i = new_total_real_particles; i != total_real_particles_; ++i)
+    {
+        if (k != size && indices[k] == i)
+            ++k;
+        else
+            remaining_particles.push_back(i);
+    }
+
+    parallel_for(
+        IndexRange(0, number_of_vacated),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                size_t vacated_index = indices[n];
+                size_t remaining_index = remaining_particles[n];
+                copyFromAnotherParticle(vacated_index, remaining_index);
+                std::swap(unsorted_id_[vacated_index], unsorted_id_[remaining_index]);
+                sorted_id_[unsorted_id_[vacated_index]] = vacated_index;
+                sorted_id_[unsorted_id_[remaining_index]] = remaining_index;
+            }
+        },
+        ap);
+    total_real_particles_ = new_total_real_particles;
+}
+//=================================================================================================//
 void BaseParticles::writePltFileHeader(std::ofstream &output_file)
 {
     output_file << " VARIABLES = \"x\",\"y\",\"z\",\"ID\"";
@@ -321,6 +381,140 @@ void BaseParticles::readParticleFromXmlForRestart(std::string &filefullpath)
     loop_variable_namelist(all_particle_data_, variables_to_restart_, read_variable_from_xml);
 }
 //=================================================================================================//
+void BaseParticles::writeParticlesToBinaryForRestart(std::string &filefullpath)
+{
+    std::ofstream output_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+    output_file.write("SPHXRST", 8);
+    uint64_t version = BinaryRestartVersion;
+    uint64_t total_real_particles = total_real_particles_;
+    output_file.write(reinterpret_cast<const char *>(&version), sizeof(uint64_t));
+    output_file.write(reinterpret_cast<const char *>(&total_real_particles), sizeof(uint64_t));
+
+    WriteAParticleVariableToBinary write_variable_to_binary(output_file, total_real_particles_);
+    DataAssembleOperation<loopParticleVariables> loop_variable_namelist;
+    loop_variable_namelist(all_particle_data_, variables_to_restart_, write_variable_to_binary);
+    output_file.close();
+    if (!output_file)
+    {
+        std::cout << "\n Error: failed to write the binary restart file: " << filefullpath << "!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
+void BaseParticles::readParticleFromBinaryForRestart(std::string &filefullpath)
+{
+    std::ifstream input_file(filefullpath.c_str(), std::ios::binary);
+    char format_name[8] = {};
+    uint64_t version = 0, total_real_particles = 0;
+    input_file.read(format_name, 8);
+    input_file.read(reinterpret_cast<char *>(&version), sizeof(uint64_t));
+    input_file.read(reinterpret_cast<char *>(&total_real_particles), sizeof(uint64_t));
+    if (!input_file || std::string(format_name, 7) != "SPHXRST" || version != BinaryRestartVersion)
+    {
+        std::cout << "\n Error: the file: " << filefullpath << " is not a binary restart file of version "
+                  << BinaryRestartVersion << "!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    if (total_real_particles > real_particles_bound_)
+    {
+        std::cout << "\n Error: the number of particles in the file: " << filefullpath
+                  << " exceeds the particle bound of " << body_name_ << "!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    total_real_particles_ = total_real_particles;
+
+    ReadAParticleVariableFromBinary read_variable_from_binary(input_file, filefullpath, total_real_particles_);
+    DataAssembleOperation<loopParticleVariables> loop_variable_namelist;
+    loop_variable_namelist(all_particle_data_, variables_to_restart_, read_variable_from_binary);
+}
+//=================================================================================================//
+void BaseParticles::writeToBinaryForReloadParticle(std::string &filefullpath)
+{
+    std::ofstream output_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+    output_file.write("SPHXRLD", 8);
+    uint64_t version = BinaryRestartVersion;
+    uint64_t total_real_particles = total_real_particles_;
+    output_file.write(reinterpret_cast<const char *>(&version), sizeof(uint64_t));
+    output_file.write(reinterpret_cast<const char *>(&total_real_particles), sizeof(uint64_t));
+
+    WriteAParticleVariableToBinary write_variable_to_binary(output_file, total_real_particles_);
+    DataAssembleOperation<loopParticleVariables> loop_variable_namelist;
+    loop_variable_namelist(all_particle_data_, variables_to_reload_, write_variable_to_binary);
+    output_file.close();
+    if (!output_file)
+    {
+        std::cout << "\n Error: failed to write the binary reload file: " << filefullpath << "!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
+void BaseParticles::readFromBinaryForReloadParticle(std::string &filefullpath)
+{
+    MemoryMappedFile mapped_file(filefullpath);
+    const char *cursor = mapped_file.Data();
+    const char *end = cursor + mapped_file.Size();
+    uint64_t version = 0, total_real_particles = 0;
+    bool is_reload_file = mapped_file.Size() >= 8 + 2 * sizeof(uint64_t) && std::string(cursor, 7) == "SPHXRLD";
+    if (is_reload_file)
+    {
+        std::memcpy(&version, cursor + 8, sizeof(uint64_t));
+        std::memcpy(&total_real_particles, cursor + 8 + sizeof(uint64_t), sizeof(uint64_t));
+    }
+    if (!is_reload_file || version != BinaryRestartVersion)
+    {
+        std::cout << "\n Error: the file: " << filefullpath << " is not a binary reload file of version "
+                  << BinaryRestartVersion << "!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    cursor += 8 + 2 * sizeof(uint64_t);
+
+    total_real_particles_ = total_real_particles;
+    unsorted_id_.resize(total_real_particles_);
+    std::iota(unsorted_id_.begin(), unsorted_id_.end(), 0);
+    resize_particle_data_(total_real_particles_);
+    ReadAParticleVariableFromMappedBinary read_variable_from_binary(cursor, end, filefullpath, total_real_particles_);
+    DataAssembleOperation<loopParticleVariables> loop_variable_namelist;
+    loop_variable_namelist(all_particle_data_, variables_to_reload_, read_variable_from_binary);
+}
+//=================================================================================================//
+uint64_t binaryDataChecksum(const char *data, size_t size)
+{
+    // FNV-1a hashes of sub-blocks computed in parallel and then combined
+    const uint64_t offset_basis = 14695981039346656037ULL;
+    const uint64_t prime = 1099511628211ULL;
+    const size_t block_size = 1 << 20;
+    size_t number_of_blocks = (size + block_size - 1) / block_size;
+    StdVec<uint64_t> block_checksums(number_of_blocks, offset_basis);
+    parallel_for(
+        IndexRange(0, number_of_blocks),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                uint64_t checksum = offset_basis;
+                size_t end = SMIN(size, (n + 1) * block_size);
+                for (size_t i = n * block_size; i != end; ++i)
+                {
+                    checksum = (checksum ^ uint64_t(uint8_t(data[i]))) * prime;
+                }
+                block_checksums[n] = checksum;
+            }
+        },
+        ap);
+
+    uint64_t checksum = offset_basis;
+    for (uint64_t block_checksum : block_checksums)
+    {
+        checksum = (checksum ^ block_checksum) * prime;
+    }
+    return checksum;
+}
+//=================================================================================================//
 void BaseParticles::writeToXmlForReloadParticle(std::string &filefullpath)
 {
     resizeXmlDocForParticles(reload_xml_parser_);
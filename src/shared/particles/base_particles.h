@@ -121,6 +121,12 @@ class BaseParticles
     void copyFromAnotherParticle(size_t index, size_t another_index);
     void updateGhostParticle(size_t ghost_index, size_t index);
     void switchToBufferParticle(size_t index);
+    /** Realize buffer particles as copies of the given real particles in a single parallel pass.
+     *  The sorted ids of the realized particles are updated too. */
+    void createRealParticlesFrom(const StdLargeVec<size_t> &source_indices, size_t size);
+    /** Switch the given real particles, which are unique but in arbitrary order, to buffer particles.
+     *  The remaining real particles beyond the new total are moved once into the vacated positions. */
+    void switchToBufferParticles(StdLargeVec<size_t> &indices, size_t size);
     //----------------------------------------------------------------------
     //		Parameterized management on generalized particle data
     //----------------------------------------------------------------------
@@ -149,6 +155,7 @@ class BaseParticles
     void addVariableToList(ParticleVariables &variable_set, const std::string &variable_name);
     template <typename DataType>
     void addVariableToWrite(const std::string &variable_name);
+    inline const ParticleVariables &getVariablesToWrite() const { return variables_to_write_; }
     template <typename DataType>
     void addVariableToRestart(const std::string &variable_name);
     inline const ParticleVariables &getVariablesToRestart() const { return variables_to_restart_; }
@@ -183,8 +190,12 @@ class BaseParticles
     void resizeXmlDocForParticles(XmlParser &xml_parser);
     void writeParticlesToXmlForRestart(std::string &filefullpath);
     void readParticleFromXmlForRestart(std::string &filefullpath);
+    void writeParticlesToBinaryForRestart(std::string &filefullpath);
+    void readParticleFromBinaryForRestart(std::string &filefullpath);
     void writeToXmlForReloadParticle(std::string &filefullpath);
     void readFromXmlForReloadParticle(std::string &filefullpath);
+    void writeToBinaryForReloadParticle(std::string &filefullpath);
+    void readFromBinaryForReloadParticle(std::string &filefullpath);
     XmlParser *getReloadXmlParser() { return &reload_xml_parser_; };
     virtual BaseParticles *ThisObjectPtr() { return this; };
     //----------------------------------------------------------------------
@@ -274,6 +285,64 @@ struct ReadAParticleVariableFromXml
     void operator()(const std::string &variable_name, StdLargeVec<DataType> &variable) const;
 };
 
+/** Version of the binary restart format, to be increased when the layout is changed. */
+constexpr uint64_t BinaryRestartVersion = 1;
+/** Checksum of a binary data block, computed in parallel by sub-blocks. */
+uint64_t binaryDataChecksum(const char *data, size_t size);
+
+/**
+ * @struct WriteAParticleVariableToBinary
+ * @brief Define a operator for writing particle variable as a typed binary block.
+ * The block has the name, the data type index, the size of a data entry,
+ * the number of entries and the checksum of the data, followed by the raw data.
+ */
+struct WriteAParticleVariableToBinary
+{
+    std::ofstream &output_file_;
+    size_t &total_real_particles_;
+    WriteAParticleVariableToBinary(std::ofstream &output_file, size_t &total_real_particles)
+        : output_file_(output_file), total_real_particles_(total_real_particles){};
+
+    template <typename DataType>
+    void operator()(const std::string &variable_name, StdLargeVec<DataType> &variable) const;
+};
+
+/**
+ * @struct ReadAParticleVariableFromBinary
+ * @brief Define a operator for reading particle variable from a typed binary block.
+ * The data are read directly into the particle variable after the block is checked.
+ */
+struct ReadAParticleVariableFromBinary
+{
+    std::ifstream &input_file_;
+    std::string &filefullpath_;
+    size_t &total_real_particles_;
+    ReadAParticleVariableFromBinary(std::ifstream &input_file, std::string &filefullpath, size_t &total_real_particles)
+        : input_file_(input_file), filefullpath_(filefullpath), total_real_particles_(total_real_particles){};
+
+    template <typename DataType>
+    void operator()(const std::string &variable_name, StdLargeVec<DataType> &variable) const;
+};
+
+/**
+ * @struct ReadAParticleVariableFromMappedBinary
+ * @brief Define a operator for copying particle variable from a typed binary block
+ * in a memory mapped file. The cursor is moved to the next block after copying.
+ */
+struct ReadAParticleVariableFromMappedBinary
+{
+    const char *&cursor_;
+    const char *end_;
+    std::string &filefullpath_;
+    size_t &total_real_particles_;
+    ReadAParticleVariableFromMappedBinary(const char *&cursor, const char *end,
+                                          std::string &filefullpath, size_t &total_real_particles)
+        : cursor_(cursor), end_(end), filefullpath_(filefullpath), total_real_particles_(total_real_particles){};
+
+    template <typename DataType>
+    void operator()(const std::string &variable_name, StdLargeVec<DataType> &variable) const;
+};
+
 /**
  * @class BaseDerivedVariable
  * @brief computing displacement from current and initial particle position
@@ -356,6 +356,109 @@ operator()(const std::string &variable_name, StdLargeVec<DataType> &variable) co
 }
 //=================================================================================================//
 template <typename DataType>
+void WriteAParticleVariableToBinary::
+operator()(const std::string &variable_name, StdLargeVec<DataType> &variable) const
+{
+    uint64_t name_size = variable_name.size();
+    uint64_t type_index = DataTypeIndex<DataType>::value;
+    uint64_t entry_size = sizeof(DataType);
+    uint64_t number_of_entries = total_real_particles_;
+    const char *data = reinterpret_cast<const char *>(variable.data());
+    uint64_t checksum = binaryDataChecksum(data, number_of_entries * entry_size);
+
+    output_file_.write(reinterpret_cast<const char *>(&name_size), sizeof(uint64_t));
+    output_file_.write(variable_name.data(), name_size);
+    output_file_.write(reinterpret_cast<const char *>(&type_index), sizeof(uint64_t));
+    output_file_.write(reinterpret_cast<const char *>(&entry_size), sizeof(uint64_t));
+    output_file_.write(reinterpret_cast<const char *>(&number_of_entries), sizeof(uint64_t));
+    output_file_.write(reinterpret_cast<const char *>(&checksum), sizeof(uint64_t));
+    output_file_.write(data, number_of_entries * entry_size);
+}
+//=================================================================================================//
+template <typename DataType>
+void ReadAParticleVariableFromBinary::
+operator()(const std::string &variable_name, StdLargeVec<DataType> &variable) const
+{
+    uint64_t name_size = 0, type_index = 0, entry_size = 0, number_of_entries = 0, checksum = 0;
+    input_file_.read(reinterpret_cast<char *>(&name_size), sizeof(uint64_t));
+    std::string name(name_size, ' ');
+    input_file_.read(&name[0], name_size);
+    input_file_.read(reinterpret_cast<char *>(&type_index), sizeof(uint64_t));
+    input_file_.read(reinterpret_cast<char *>(&entry_size), sizeof(uint64_t));
+    input_file_.read(reinterpret_cast<char *>(&number_of_entries), sizeof(uint64_t));
+    input_file_.read(reinterpret_cast<char *>(&checksum), sizeof(uint64_t));
+
+    if (!input_file_ || name != variable_name || type_index != DataTypeIndex<DataType>::value ||
+        entry_size != sizeof(DataType) || number_of_entries != total_real_particles_)
+    {
+        std::cout << "\n Error: the restart variable " << variable_name
+                  << " does not match the block in the file: " << filefullpath_ << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    char *data = reinterpret_cast<char *>(variable.data());
+    input_file_.read(data, number_of_entries * entry_size);
+    if (!input_file_ || checksum != binaryDataChecksum(data, number_of_entries * entry_size))
+    {
+        std::cout << "\n Error: the restart variable " << variable_name
+                  << " is corrupted in the file: " << filefullpath_ << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
+template <typename DataType>
+void ReadAParticleVariableFromMappedBinary::
+operator()(const std::string &variable_name, StdLargeVec<DataType> &variable) const
+{
+    uint64_t name_size = 0, type_index = 0, entry_size = 0, number_of_entries = 0, checksum = 0;
+    bool is_matched = cursor_ + sizeof(uint64_t) <= end_;
+    if (is_matched)
+    {
+        std::memcpy(&name_size, cursor_, sizeof(uint64_t));
+        is_matched = cursor_ + 5 * sizeof(uint64_t) + name_size <= end_;
+    }
+    if (is_matched)
+    {
+        const char *block_header = cursor_ + sizeof(uint64_t) + name_size;
+        std::memcpy(&type_index, block_header, sizeof(uint64_t));
+        std::memcpy(&entry_size, block_header + sizeof(uint64_t), sizeof(uint64_t));
+        std::memcpy(&number_of_entries, block_header + 2 * sizeof(uint64_t), sizeof(uint64_t));
+        std::memcpy(&checksum, block_header + 3 * sizeof(uint64_t), sizeof(uint64_t));
+        is_matched = std::string(cursor_ + sizeof(uint64_t), name_size) == variable_name &&
+                     type_index == DataTypeIndex<DataType>::value && entry_size == sizeof(DataType) &&
+                     number_of_entries == total_real_particles_ &&
+                     block_header + 4 * sizeof(uint64_t) + number_of_entries * entry_size <= end_;
+    }
+    if (!is_matched)
+    {
+        std::cout << "\n Error: the reload variable " << variable_name
+                  << " does not match the block in the file: " << filefullpath_ << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    const char *data = cursor_ + 5 * sizeof(uint64_t) + name_size;
+    size_t data_size = number_of_entries * entry_size;
+    if (checksum != binaryDataChecksum(data, data_size))
+    {
+        std::cout << "\n Error: the reload variable " << variable_name
+                  << " is corrupted in the file: " << filefullpath_ << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    char *variable_data = reinterpret_cast<char *>(variable.data());
+    parallel_for(
+        IndexRange(0, data_size),
+        [&](const IndexRange &r)
+        { std::memcpy(variable_data + r.begin(), data + r.begin(), r.size()); },
+        ap);
+    cursor_ = data + data_size;
+}
+//=================================================================================================//
+template <typename DataType>
 BaseDerivedVariable<DataType>::
     BaseDerivedVariable(SPHBody &sph_body, const std::string &variable_name)
     : variable_name_(variable_name)
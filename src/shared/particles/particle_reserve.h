@@ -68,7 +68,7 @@ class ParticleBuffer<Base> : public ParticleReserve
   public:
     ParticleBuffer() : ParticleReserve(){};
     virtual ~ParticleBuffer(){};
-    void checkEnoughBuffer(BaseParticles &base_particles);
+    void checkEnoughBuffer(BaseParticles &base_particles, size_t number_of_new_particles = 1);
     void allocateBufferParticles(BaseParticles &base_particles, size_t buffer_size);
 };
 
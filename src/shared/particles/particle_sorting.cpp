@@ -23,18 +23,142 @@ void SwapSortableParticleData::operator()(size_t *a, size_t *b)
     swap_particle_data_value_(sortable_data_, index_a, index_b);
 }
 //=================================================================================================//
+void RadixSortParticleSequence::sortingByDigit(size_t size, size_t shift)
+{
+    size_t number_of_chunks = (size + chunk_size_ - 1) / chunk_size_;
+    bucket_offsets_.assign(number_of_chunks * radix_, 0);
+
+    parallel_for(
+        IndexRange(0, number_of_chunks),
+        [&](const IndexRange &r)
+        {
+            for (size_t chunk = r.begin(); chunk != r.end(); ++chunk)
+            {
+                size_t *histogram = bucket_offsets_.data() + chunk * radix_;
+                size_t chunk_end = SMIN(size, (chunk + 1) * chunk_size_);
+                for (size_t i = chunk * chunk_size_; i != chunk_end; ++i)
+                {
+                    histogram[(keys_[i] >> shift) & (radix_ - 1)]++;
+                }
+            }
+        },
+        ap);
+
+    // exclusive prefix sum in the order of digit first, so that the sort is stable
+    size_t offset = 0;
+    for (size_t digit = 0; digit != radix_; ++digit)
+    {
+        for (size_t chunk = 0; chunk != number_of_chunks; ++chunk)
+        {
+            size_t &bucket = bucket_offsets_[chunk * radix_ + digit];
+            size_t count = bucket;
+            bucket = offset;
+            offset += count;
+        }
+    }
+
+    parallel_for(
+        IndexRange(0, number_of_chunks),
+        [&](const IndexRange &r)
+        {
+            for (size_t chunk = r.begin(); chunk != r.end(); ++chunk)
+            {
+                size_t *offsets = bucket_offsets_.data() + chunk * radix_;
+                size_t chunk_end = SMIN(size, (chunk + 1) * chunk_size_);
+                for (size_t i = chunk * chunk_size_; i != chunk_end; ++i)
+                {
+                    size_t position = offsets[(keys_[i] >> shift) & (radix_ - 1)]++;
+                    keys_buffer_[position] = keys_[i];
+                    permutation_buffer_[position] = permutation_[i];
+                }
+            }
+        },
+        ap);
+
+    keys_.swap(keys_buffer_);
+    permutation_.swap(permutation_buffer_);
+}
+//=================================================================================================//
+StdLargeVec<size_t> &RadixSortParticleSequence::computingPermutation(size_t *sequence, size_t size)
+{
+    keys_.resize(size);
+    keys_buffer_.resize(size);
+    permutation_.resize(size);
+    permutation_buffer_.resize(size);
+    parallel_for(
+        IndexRange(0, size),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                keys_[i] = sequence[i];
+                permutation_[i] = i;
+            }
+        },
+        ap);
+
+    size_t max_key = parallel_reduce(
+        IndexRange(0, size), size_t(0),
+        [&](const IndexRange &r, size_t local_max) -> size_t
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                local_max = SMAX(local_max, keys_[i]);
+            }
+            return local_max;
+        },
+        [](size_t x, size_t y) -> size_t
+        { return SMAX(x, y); });
+
+    for (size_t shift = 0; shift < 8 * sizeof(size_t) && (max_key >> shift) != 0; shift += radix_bits_)
+    {
+        sortingByDigit(size, shift);
+    }
+
+    parallel_for(
+        IndexRange(0, size),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                sequence[i] = keys_[i];
+            }
+        },
+        ap);
+    return permutation_;
+}
+//=================================================================================================//
 ParticleSorting::ParticleSorting(BaseParticles &base_particles)
     : base_particles_(base_particles),
       swap_sortable_particle_data_(base_particles), compare_(),
       quick_sort_particle_range_(base_particles_.sequence_.data(), 0, compare_, swap_sortable_particle_data_),
-      quick_sort_particle_body_() {}
+      quick_sort_particle_body_(), sorting_method_(ParticleSortingMethod::QuickSort) {}
 //=================================================================================================//
 void ParticleSorting::sortingParticleData(size_t *begin, size_t size)
+{
+    if (sorting_method_ == ParticleSortingMethod::RadixSort)
+    {
+        radixSortingParticleData(begin, size);
+    }
+    else
+    {
+        quickSortingParticleData(begin, size);
+    }
+    updateSortedId();
+}
+//=================================================================================================//
+void ParticleSorting::quickSortingParticleData(size_t *begin, size_t size)
 {
     quick_sort_particle_range_.begin_ = begin;
     quick_sort_particle_range_.size_ = size;
     parallel_for(quick_sort_particle_range_, quick_sort_particle_body_, ap);
-    updateSortedId();
+}
+//=================================================================================================//
+void ParticleSorting::radixSortingParticleData(size_t *begin, size_t size)
+{
+    StdLargeVec<size_t> &permutation = radix_sort_particle_sequence_.computingPermutation(begin, size);
+    gatherByPermutation(base_particles_.unsorted_id_, index_buffer_, permutation, size);
+    gather_particle_data_value_(base_particles_.sortable_data_, permutation, size);
 }
 //=================================================================================================//
 void ParticleSorting::updateSortedId()
@@ -214,6 +214,51 @@ struct swapParticleDataValue
     };
 };
 
+/** gather the values of a variable according to a permutation, i.e. variable[i] = variable[permutation[i]] */
+template <typename VariableType>
+void gatherByPermutation(StdLargeVec<VariableType> &variable, StdLargeVec<VariableType> &buffer,
+                         const StdLargeVec<size_t> &permutation, size_t size)
+{
+    buffer.resize(size);
+    parallel_for(
+        IndexRange(0, size),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                buffer[i] = variable[permutation[i]];
+            }
+        },
+        ap);
+    parallel_for(
+        IndexRange(0, size),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                variable[i] = buffer[i];
+            }
+        },
+        ap);
+}
+
+template <typename VariableType>
+struct gatherParticleDataValue
+{
+    StdLargeVec<VariableType> buffer_;
+
+    void operator()(ParticleData &particle_data, const StdLargeVec<size_t> &permutation, size_t size)
+    {
+        constexpr int type_index = DataTypeIndex<VariableType>::value;
+
+        StdVec<StdLargeVec<VariableType> *> variables = std::get<type_index>(particle_data);
+        for (size_t i = 0; i != variables.size(); ++i)
+        {
+            gatherByPermutation(*variables[i], buffer_, permutation, size);
+        }
+    };
+};
+
 /**
  * @class CompareParticleSequence
  * @brief compare the sequence of two particles
@@ -248,6 +293,41 @@ class SwapSortableParticleData
     void operator()(size_t *a, size_t *b);
 };
 
+/**
+ * @class RadixSortParticleSequence
+ * @brief Stable parallel LSD radix sort of the particle sequence.
+ * As the sequence is given by bounded cell codes, the number of passes is
+ * determined by the largest code. Each pass is a counting sort carried out
+ * by chunk-wise histograms, a prefix sum and a stable scatter.
+ * The result is the permutation from sorted to unsorted positions.
+ */
+class RadixSortParticleSequence
+{
+  protected:
+    static const size_t radix_bits_ = 8;
+    static const size_t radix_ = 1 << radix_bits_;
+    static const size_t chunk_size_ = 1 << 16;
+    StdLargeVec<size_t> keys_, keys_buffer_;
+    StdLargeVec<size_t> permutation_, permutation_buffer_;
+    StdLargeVec<size_t> bucket_offsets_; /**< histogram or offsets of each radix bucket for each chunk */
+
+    void sortingByDigit(size_t size, size_t shift);
+
+  public:
+    RadixSortParticleSequence(){};
+    ~RadixSortParticleSequence(){};
+
+    /** sort the sequence and return the permutation, the sequence is sorted in place */
+    StdLargeVec<size_t> &computingPermutation(size_t *sequence, size_t size);
+};
+
+/** the algorithms for sorting particles */
+enum class ParticleSortingMethod
+{
+    QuickSort, /**< parallel quick sort swapping all sortable data for each swap */
+    RadixSort, /**< radix sort of the sequence followed by gathering each sortable variable once */
+};
+
 /**
  * @class ParticleSorting
  * @brief The class for sorting particle according a given sequence.
@@ -267,12 +347,22 @@ class ParticleSorting
         size_t *, CompareParticleSequence, SwapSortableParticleData>
         quick_sort_particle_body_;
 
+    ParticleSortingMethod sorting_method_;
+    RadixSortParticleSequence radix_sort_particle_sequence_;
+    StdLargeVec<size_t> index_buffer_;
+    DataAssembleOperation<gatherParticleDataValue> gather_particle_data_value_;
+
+    void quickSortingParticleData(size_t *begin, size_t size);
+    void radixSortingParticleData(size_t *begin, size_t size);
+
   public:
     // the construction is before particles
     explicit ParticleSorting(BaseParticles &base_particles);
     virtual ~ParticleSorting(){};
     /** sorting particle data according to the cell location of particles */
     virtual void sortingParticleData(size_t *begin, size_t size);
+    void setSortingMethod(ParticleSortingMethod sorting_method) { sorting_method_ = sorting_method; };
+    ParticleSortingMethod getSortingMethod() { return sorting_method_; };
     /** update the reference of sorted data from unsorted data */
     virtual void updateSortedId();
 };
@@ -0,0 +1,88 @@
+#include "multi_rate_time_stepping.h"
+
+namespace SPH
+{
+//=================================================================================================//
+size_t MultiRateTimeStepping::addIntegrator(const std::string &name, const TimeStepSizeFunction &time_step_size,
+                                            const IntegrationFunction &integration)
+{
+    integrators_.push_back({name, time_step_size, integration, GlobalStaticVariables::physical_time_, 0.0, 0});
+    return integrators_.size() - 1;
+}
+//=================================================================================================//
+size_t MultiRateTimeStepping::addIntegrator(const std::string &name, BaseDynamics<Real> &time_step_size,
+                                            const IntegrationFunction &integration)
+{
+    return addIntegrator(
+        name, [&]() -> Real
+        { return time_step_size.exec(); },
+        integration);
+}
+//=================================================================================================//
+Real MultiRateTimeStepping::advanceCouplingInterval(Real max_coupling_interval)
+{
+    Real coupling_interval = 0.0;
+    for (Integrator &integrator : integrators_)
+    {
+        integrator.time_step_size_ = integrator.get_time_step_size_();
+        coupling_interval = SMAX(coupling_interval, integrator.time_step_size_);
+    }
+    coupling_interval = SMIN(coupling_interval, max_coupling_interval);
+    if (coupling_interval <= 0.0)
+    {
+        std::cout << "\n Error: the coupling interval " << coupling_interval << " is not positive! \n";
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    Real coupling_start_time = GlobalStaticVariables::physical_time_;
+    for (CouplingFunction &coupling : couplings_at_start_)
+        coupling(coupling_interval);
+
+    for (Integrator &integrator : integrators_)
+        subStepping(integrator, coupling_start_time, coupling_interval);
+
+    GlobalStaticVariables::physical_time_ = coupling_start_time + coupling_interval;
+    for (CouplingFunction &coupling : couplings_at_end_)
+        coupling(coupling_interval);
+    return coupling_interval;
+}
+//=================================================================================================//
+size_t MultiRateTimeStepping::advanceTo(Real end_time, Real max_coupling_interval)
+{
+    size_t coupling_intervals = 0;
+    while (GlobalStaticVariables::physical_time_ < end_time)
+    {
+        advanceCouplingInterval(SMIN(max_coupling_interval, end_time - GlobalStaticVariables::physical_time_));
+        coupling_intervals++;
+    }
+    return coupling_intervals;
+}
+//=================================================================================================//
+void MultiRateTimeStepping::subStepping(Integrator &integrator, Real coupling_start_time, Real coupling_interval)
+{
+    integrator.sub_steps_ = 0;
+    Real integration_time = 0.0;
+    Real time_step_size = integrator.time_step_size_;
+    Real tolerance = 10.0 * Eps * coupling_interval;
+    while (coupling_interval - integration_time > tolerance)
+    {
+        if (integrator.sub_steps_ != 0)
+            time_step_size = integrator.get_time_step_size_();
+        if (time_step_size <= 0.0)
+        {
+            std::cout << "\n Error: the time step size of " << integrator.name_ << " is not positive! \n";
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        Real remaining_time = coupling_interval - integration_time;
+        Real dt = remaining_time - time_step_size > tolerance ? time_step_size : remaining_time;
+        GlobalStaticVariables::physical_time_ = coupling_start_time + integration_time;
+        integrator.integrate_(dt);
+        integration_time += dt;
+        integrator.sub_steps_++;
+    }
+    integrator.physical_time_ = coupling_start_time + coupling_interval;
+}
+//=================================================================================================//
+} // namespace SPH
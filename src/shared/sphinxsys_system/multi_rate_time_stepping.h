@@ -0,0 +1,109 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file multi_rate_time_stepping.h
+ * @brief Advancing coupled bodies, each with its own time step size, to common coupling points.
+ * @details The stiffest body no longer decides the time step size for all bodies.
+ * Each integrator, i.e. a body or a group of bodies sharing their time step size,
+ * is advanced with sub-steps at its own stable time step size until the next coupling point.
+ * The quantities exchanged between the bodies, such as the forces from the fluid and
+ * the average velocity and acceleration of a solid in fluid_structure_interaction.h,
+ * are only updated by the coupling functions at the coupling points.
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+
+#ifndef MULTI_RATE_TIME_STEPPING_H
+#define MULTI_RATE_TIME_STEPPING_H
+
+#include "base_particle_dynamics.h"
+
+#include <functional>
+
+namespace SPH
+{
+/**
+ * @class MultiRateTimeStepping
+ * @brief Scheduler of integrators advanced at their own rates between coupling points.
+ * @details A coupling interval is the largest stable time step size of the integrators,
+ * but not larger than the given maximum. Within the interval, the integrators are advanced
+ * one after another, each with its own physical time, which is the global physical time
+ * seen by the dynamics during its sub-steps. The stable time step size evaluated for the coupling
+ * interval is used for the first sub-step and evaluated again for each of the following sub-steps.
+ * The sub-stepping ends when the remaining time is below a small fraction of the coupling interval,
+ * so that round-off in the accumulated time does not lead to an extra tiny sub-step.
+ * Note that the quantities updated by an integrator with several sub-steps and used by
+ * the others are those of its last sub-step.
+ */
+class MultiRateTimeStepping
+{
+  public:
+    typedef std::function<Real()> TimeStepSizeFunction;
+    typedef std::function<void(Real)> IntegrationFunction;
+    /** coupling functions are called with the coupling interval */
+    typedef std::function<void(Real)> CouplingFunction;
+
+    MultiRateTimeStepping(){};
+    virtual ~MultiRateTimeStepping(){};
+
+    /** add an integrator with the function for its stable time step size and that for advancing a step */
+    size_t addIntegrator(const std::string &name, const TimeStepSizeFunction &time_step_size,
+                         const IntegrationFunction &integration);
+    /** add an integrator with the dynamics giving its stable time step size, such as AcousticTimeStepSize */
+    size_t addIntegrator(const std::string &name, BaseDynamics<Real> &time_step_size,
+                         const IntegrationFunction &integration);
+    /** add a coupling function called at the beginning of each coupling interval */
+    void addCouplingAtStart(const CouplingFunction &coupling) { couplings_at_start_.push_back(coupling); };
+    /** add a coupling function called at the end of each coupling interval */
+    void addCouplingAtEnd(const CouplingFunction &coupling) { couplings_at_end_.push_back(coupling); };
+    /** advance all integrators to the next coupling point, and return the coupling interval */
+    Real advanceCouplingInterval(Real max_coupling_interval);
+    /** advance all integrators to the given end time, and return the number of coupling intervals */
+    size_t advanceTo(Real end_time, Real max_coupling_interval);
+
+    size_t NumberOfIntegrators() { return integrators_.size(); };
+    std::string IntegratorName(size_t integrator_index) { return integrators_[integrator_index].name_; };
+    /** the physical time reached by the integrator */
+    Real PhysicalTime(size_t integrator_index) { return integrators_[integrator_index].physical_time_; };
+    /** the number of sub-steps of the integrator in the last coupling interval */
+    size_t SubSteps(size_t integrator_index) { return integrators_[integrator_index].sub_steps_; };
+    /** the stable time step size of the integrator at the beginning of the last coupling interval */
+    Real TimeStepSize(size_t integrator_index) { return integrators_[integrator_index].time_step_size_; };
+
+  protected:
+    struct Integrator
+    {
+        std::string name_;
+        TimeStepSizeFunction get_time_step_size_;
+        IntegrationFunction integrate_;
+        Real physical_time_;
+        Real time_step_size_;
+        size_t sub_steps_;
+    };
+    StdVec<Integrator> integrators_;
+    StdVec<CouplingFunction> couplings_at_start_;
+    StdVec<CouplingFunction> couplings_at_end_;
+
+    void subStepping(Integrator &integrator, Real coupling_start_time, Real coupling_interval);
+};
+} // namespace SPH
+#endif // MULTI_RATE_TIME_STEPPING_H
@@ -2,6 +2,7 @@
 
 #include "all_body_relations.h"
 #include "base_body.h"
+#include "dynamics_profiler.h"
 #include "elastic_dynamics.h"
 
 namespace SPH
@@ -71,6 +72,8 @@ SPHSystem *SPHSystem::handleCommandlineOptions(int ac, char *av[])
         desc.add_options()("regression", po::value<bool>(), "Regression test.");
         desc.add_options()("state_recording", po::value<bool>(), "State recording in output folder.");
         desc.add_options()("restart_step", po::value<int>(), "Run form a restart file.");
+        desc.add_options()("profile_timeline", po::value<std::string>(),
+                           "Chrome trace file of the profiled dynamics (with SPHINXSYS_USE_PROFILING).");
 
         po::variables_map vm;
         po::store(po::parse_command_line(ac, av, desc), vm);
@@ -141,6 +144,13 @@ SPHSystem *SPHSystem::handleCommandlineOptions(int ac, char *av[])
             std::cout << "Restart inactivated, i.e. restart_step ("
                       << restart_step_ << ").\n";
         }
+
+        if (vm.count("profile_timeline"))
+        {
+            DynamicsProfiler::instance().enableTimeline(vm["profile_timeline"].as<std::string>());
+            std::cout << "Profile timeline was set to be written to "
+                      << vm["profile_timeline"].as<std::string>() << ".\n";
+        }
     }
     catch (std::exception &e)
     {
@@ -191,6 +191,31 @@ int main(int ac, char *av[])
     int screen_output_interval = 100;
     Real end_time = 200.0;
     Real output_interval = end_time / 200.0;
+    /** The fluid and the inserted body are advanced at their own rates between the coupling points. */
+    MultiRateTimeStepping fsi_time_stepping;
+    fsi_time_stepping.addIntegrator("WaterBody", get_fluid_time_step_size,
+                                    [&](Real dt)
+                                    {
+                                        pressure_relaxation.exec(dt);
+                                        /** FSI for pressure force. */
+                                        pressure_force_from_fluid.exec();
+                                        density_relaxation.exec(dt);
+                                    });
+    size_t insert_body_integrator = fsi_time_stepping.addIntegrator(
+        "InsertedBody", insert_body_computing_time_step_size,
+        [&](Real dt_s)
+        {
+            insert_body_stress_relaxation_first_half.exec(dt_s);
+            constraint_beam_base.exec();
+            insert_body_stress_relaxation_second_half.exec(dt_s);
+        });
+    fsi_time_stepping.addCouplingAtStart([&](Real dt)
+                                         { average_velocity_and_acceleration.initialize_displacement_.exec(); });
+    fsi_time_stepping.addCouplingAtEnd([&](Real dt)
+                                       {
+                                           average_velocity_and_acceleration.update_averages_.exec(dt);
+                                           parabolic_inflow.exec();
+                                       });
     //----------------------------------------------------------------------
     //	Statistics for CPU time
     //----------------------------------------------------------------------
@@ -220,37 +245,12 @@ int main(int ac, char *av[])
             /** Update normal direction on elastic body.*/
             insert_body_update_normal.exec();
             size_t inner_ite_dt = 0;
-            size_t inner_ite_dt_s = 0;
             Real relaxation_time = 0.0;
             while (relaxation_time < Dt)
             {
-                Real dt = SMIN(get_fluid_time_step_size.exec(), Dt);
-                /** Fluid pressure relaxation */
-                pressure_relaxation.exec(dt);
-                /** FSI for pressure force. */
-                pressure_force_from_fluid.exec();
-                /** Fluid density relaxation */
-                density_relaxation.exec(dt);
-
-                /** Solid dynamics. */
-                inner_ite_dt_s = 0;
-                Real dt_s_sum = 0.0;
-                average_velocity_and_acceleration.initialize_displacement_.exec();
-                while (dt_s_sum < dt)
-                {
-                    Real dt_s = SMIN(insert_body_computing_time_step_size.exec(), dt - dt_s_sum);
-                    insert_body_stress_relaxation_first_half.exec(dt_s);
-                    constraint_beam_base.exec();
-                    insert_body_stress_relaxation_second_half.exec(dt_s);
-                    dt_s_sum += dt_s;
-                    inner_ite_dt_s++;
-                }
-                average_velocity_and_acceleration.update_averages_.exec(dt);
-
+                Real dt = fsi_time_stepping.advanceCouplingInterval(Dt);
                 relaxation_time += dt;
                 integration_time += dt;
-                GlobalStaticVariables::physical_time_ += dt;
-                parabolic_inflow.exec();
                 inner_ite_dt++;
             }
 
@@ -258,7 +258,7 @@ int main(int ac, char *av[])
             {
                 std::cout << std::fixed << std::setprecision(9) << "N=" << number_of_iterations << "	Time = "
                           << GlobalStaticVariables::physical_time_
-                          << "	Dt = " << Dt << "	Dt / dt = " << inner_ite_dt << "	dt / dt_s = " << inner_ite_dt_s << "\n";
+                          << "	Dt = " << Dt << "	Dt / dt = " << inner_ite_dt << "	dt / dt_s = " << fsi_time_stepping.SubSteps(insert_body_integrator) << "\n";
             }
             number_of_iterations++;
 
@@ -100,6 +100,12 @@ int main(int ac, char *av[])
     InnerRelation water_block_inner(water_block);
     ContactRelation water_wall_contact(water_block, {&wall_boundary});
     ContactRelation fluid_observer_contact(fluid_observer, {&water_block});
+    // store the fluid neighbor lists in contiguous blocks for the large 3D case
+    water_block_inner.usePackedNeighborStorage();
+    water_wall_contact.usePackedNeighborStorage();
+    // bin the particles into contiguous cell lists, whose neighbor candidates are prefiltered by distance
+    water_block.getCellLinkedList().useContiguousCellLists();
+    wall_boundary.getCellLinkedList().useContiguousCellLists();
     //----------------------------------------------------------------------
     // Combined relations built from basic relations
     // which is only used for update configuration.
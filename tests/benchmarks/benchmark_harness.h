@@ -0,0 +1,147 @@
+/**
+ * @file 	benchmark_harness.h
+ * @brief 	A small harness for timing the kernels of the library.
+ * @details Each benchmark is run once for warming up and then repeatedly for the given iterations.
+ *          The throughput is given as the number of particle updates per second.
+ *          The results are written as CSV and compared with a baseline CSV written by an earlier run,
+ *          where a benchmark whose throughput drops more than the tolerance is reported as a regression.
+ */
+#ifndef BENCHMARK_HARNESS_H
+#define BENCHMARK_HARNESS_H
+
+#include "sphinxsys.h"
+
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace SPH
+{
+/**
+ * @struct BenchmarkResult
+ * @brief Timing of a benchmark with a particle and thread count.
+ */
+struct BenchmarkResult
+{
+    std::string name_;
+    size_t particles_;
+    size_t threads_;
+    size_t iterations_;
+    Real seconds_per_iteration_;
+    Real particle_updates_per_second_;
+};
+
+/**
+ * @class BenchmarkHarness
+ * @brief Runs benchmarks and collects, writes and checks their results.
+ */
+class BenchmarkHarness
+{
+  public:
+    explicit BenchmarkHarness(size_t iterations)
+        : particles_(0), threads_(0), iterations_(iterations){};
+
+    /** the particle and thread counts of the following benchmarks */
+    void setConfiguration(size_t particles, size_t threads)
+    {
+        particles_ = particles;
+        threads_ = threads;
+    };
+
+    /** the function is run for the iterations, each of which updates the given number of particles */
+    template <class BenchmarkFunction>
+    void run(const std::string &name, size_t particle_updates, const BenchmarkFunction &function,
+             size_t iterations = 0)
+    {
+        size_t number_of_iterations = iterations == 0 ? iterations_ : iterations;
+        function();
+        TickCount t1 = TickCount::now();
+        for (size_t n = 0; n != number_of_iterations; ++n)
+            function();
+        Real seconds_per_iteration = (TickCount::now() - t1).seconds() / Real(number_of_iterations);
+        results_.push_back({name, particles_, threads_, number_of_iterations, seconds_per_iteration,
+                            Real(particle_updates) / SMAX(seconds_per_iteration, Eps)});
+        const BenchmarkResult &result = results_.back();
+        std::cout << std::setw(28) << std::left << result.name_ << std::right
+                  << std::setw(12) << result.particles_ << std::setw(4) << result.threads_
+                  << std::setw(14) << std::scientific << std::setprecision(3) << result.seconds_per_iteration_
+                  << std::setw(14) << result.particle_updates_per_second_ << std::defaultfloat << std::endl;
+    };
+
+    void writeResults(const std::string &filefullpath)
+    {
+        std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+        out_file << "benchmark,particles,threads,iterations,seconds_per_iteration,particle_updates_per_second\n";
+        for (const BenchmarkResult &result : results_)
+        {
+            out_file << result.name_ << "," << result.particles_ << "," << result.threads_ << ","
+                     << result.iterations_ << "," << std::scientific << std::setprecision(6)
+                     << result.seconds_per_iteration_ << "," << result.particle_updates_per_second_ << "\n";
+        }
+    };
+
+    /** returns the number of benchmarks regressed by more than the tolerance against the baseline */
+    size_t checkAgainstBaseline(const std::string &filefullpath, Real tolerance)
+    {
+        std::ifstream in_file(filefullpath.c_str());
+        if (!in_file.is_open())
+        {
+            std::cout << "\n Error: the baseline file " << filefullpath << " is not found." << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+
+        std::map<std::string, Real> baseline;
+        std::string line;
+        std::getline(in_file, line);
+        while (std::getline(in_file, line))
+        {
+            StdVec<std::string> fields = splitLine(line);
+            if (fields.size() == 6)
+                baseline[fields[0] + "," + fields[1] + "," + fields[2]] = std::stod(fields[5]);
+        }
+
+        size_t number_of_regressions = 0;
+        for (const BenchmarkResult &result : results_)
+        {
+            std::string key = result.name_ + "," + std::to_string(result.particles_) + "," + std::to_string(result.threads_);
+            if (baseline.find(key) == baseline.end())
+                continue;
+            Real ratio = result.particle_updates_per_second_ / baseline[key];
+            if (ratio < 1.0 - tolerance)
+            {
+                number_of_regressions++;
+                std::cout << "Regression: " << key << " runs at " << std::fixed << std::setprecision(2)
+                          << 100.0 * ratio << "% of the baseline throughput." << std::defaultfloat << std::endl;
+            }
+        }
+        return number_of_regressions;
+    };
+
+  protected:
+    size_t particles_, threads_, iterations_;
+    StdVec<BenchmarkResult> results_;
+
+    StdVec<std::string> splitLine(const std::string &line)
+    {
+        StdVec<std::string> fields;
+        std::stringstream line_stream(line);
+        std::string field;
+        while (std::getline(line_stream, field, ','))
+            fields.push_back(field);
+        return fields;
+    };
+};
+
+/** parse a comma separated list of counts, such as 10000,100000 */
+inline StdVec<size_t> parseCounts(const std::string &counts)
+{
+    StdVec<size_t> values;
+    std::stringstream counts_stream(counts);
+    std::string value;
+    while (std::getline(counts_stream, value, ','))
+        values.push_back(std::stoul(value));
+    return values;
+}
+} // namespace SPH
+#endif // BENCHMARK_HARNESS_H
@@ -0,0 +1,372 @@
+/**
+ * @file 	sphinxsys_benchmarks.cpp
+ * @brief 	Throughput benchmarks of the main kernels for a block of fluid on a wall.
+ * @details The cell linked list update, the inner and contact neighbor searches, the density summation,
+ *          the two halves of the time integration, the level set construction, the particle sorting
+ *          and the VTP output are timed for each given particle and thread count.
+ *          The alternatives of these kernels are timed alongside, such as the kernel called through
+ *          its virtual interface, the contiguous cell lists and the prefilter of their neighbor candidates
+ *          for several batch sizes, the symmetric interactions, the fused dynamics, the space-filling curves,
+ *          the radix sort and the binary output formats.
+ *          The queries of a triangulated sphere and of a level set are probed at the particle positions.
+ *          All benchmarks are normalized by the number of fluid particles.
+ *          Usage: sphinxsys_benchmarks --particles=10000,100000 --threads=1,8 --iterations=20
+ *                 --output=benchmark_results.csv --baseline=baseline.csv --tolerance=0.1
+ *          With a baseline, the program fails if any benchmark regresses by more than the tolerance.
+ *          The benchmarks are built with the CMake option SPHINXSYS_BUILD_BENCHMARKS=ON.
+ */
+#include "benchmark_harness.h"
+#include "fluid_cube.h"
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+
+class WallPlate : public ComplexShape
+{
+  public:
+    WallPlate(const std::string &shape_name, Real thickness) : ComplexShape(shape_name)
+    {
+        Vecd halfsize(0.5 * DL, 0.5 * thickness, 0.5 * DL);
+        add<TransformShape<GeometricShapeBox>>(Transform(Vecd(0.5 * DL, -0.5 * thickness, 0.5 * DL)), halfsize);
+    }
+};
+
+void runBenchmarks(BenchmarkHarness &harness, size_t particles, size_t threads, size_t iterations)
+{
+    size_t particles_per_edge = SMAX(size_t(std::round(std::cbrt(Real(particles)))), size_t(4));
+    Real resolution_ref = DL / Real(particles_per_edge);
+    Real wall_thickness = 4.0 * resolution_ref;
+    BoundingBox system_domain_bounds(Vecd(0.0, -wall_thickness, 0.0), Vecd(DL, DL, DL));
+    SPHSystem sph_system(system_domain_bounds, resolution_ref, threads);
+    sph_system.setIOEnvironment();
+
+    FluidBody fluid_cube(sph_system, makeShared<FluidCube>("FluidCube", DL));
+    generateFluidParticles(fluid_cube, rho0_f, c_f);
+    SolidBody wall_plate(sph_system, makeShared<WallPlate>("WallPlate", wall_thickness));
+    wall_plate.defineParticlesAndMaterial<SolidParticles, Solid>();
+    wall_plate.generateParticles<Lattice>();
+    FluidBody contiguous_cube(sph_system, makeShared<FluidCube>("ContiguousCube", DL));
+    generateFluidParticles(contiguous_cube, rho0_f, c_f);
+    contiguous_cube.getCellLinkedList().useContiguousCellLists();
+    FluidBody buffer_cube(sph_system, makeShared<FluidCube>("BufferCube", DL));
+    buffer_cube.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(rho0_f, c_f);
+    ParticleBuffer<ReserveSizeFactor> particle_buffer(0.5);
+    buffer_cube.generateParticlesWithReserve<Lattice>(particle_buffer);
+
+    InnerRelation fluid_inner(fluid_cube);
+    InnerRelation fluid_inner_virtual_kernel(fluid_cube);
+    InnerRelation contiguous_inner(contiguous_cube);
+    fluid_inner_virtual_kernel.specializeKernel(false);
+    SymmetricInnerRelation fluid_half_inner(fluid_cube);
+    ContactRelation fluid_wall_contact(fluid_cube, {&wall_plate});
+    ContactRelation fluid_wall_contact_virtual_kernel(fluid_cube, {&wall_plate});
+    fluid_wall_contact_virtual_kernel.specializeKernel(false);
+
+    Gravity gravity(Vecd(0.0, -1.0, 0.0));
+    SimpleDynamics<GravityForce> constant_gravity(fluid_cube, gravity);
+    InteractionWithUpdate<fluid_dynamics::DensitySummationInner> update_density_by_summation(fluid_inner);
+    ReduceDynamics<fluid_dynamics::AcousticTimeStepSize> get_fluid_time_step_size(fluid_cube);
+    Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann> pressure_relaxation(fluid_inner);
+    Dynamics1Level<fluid_dynamics::Integration2ndHalfInnerRiemann> density_relaxation(fluid_inner);
+    InteractionSymmetric<fluid_dynamics::Integration1stHalfSymmetricInnerRiemann> symmetric_pressure_relaxation(fluid_half_inner);
+    InteractionSymmetric<fluid_dynamics::Integration2ndHalfSymmetricInnerRiemann> symmetric_density_relaxation(fluid_half_inner);
+    FusedDynamicsReduce<ReduceDynamics<fluid_dynamics::AcousticTimeStepSize>,
+                        SimpleDynamics<GravityForce>,
+                        Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann>,
+                        Dynamics1Level<fluid_dynamics::Integration2ndHalfInnerRiemann>>
+        fused_integration(get_fluid_time_step_size, constant_gravity, pressure_relaxation, density_relaxation);
+    BodyStatesRecordingToVtp write_fluid_states(fluid_cube);
+    BodyStatesRecordingToVtpBinary write_fluid_states_in_binary(fluid_cube);
+    BodyStatesRecordingToVtpBinary write_fluid_states_in_compressed_binary(fluid_cube, true);
+    RestartIO xml_restart_io({&fluid_cube});
+    RestartIO binary_restart_io({&fluid_cube}, true);
+    ReloadParticleIO xml_reload_io(fluid_cube, "XmlReloadCube");
+    ReloadParticleIO binary_reload_io(fluid_cube, "BinaryReloadCube");
+    binary_reload_io.useBinaryFormat();
+
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    Real dt = 0.1 * get_fluid_time_step_size.exec();
+
+    BaseParticles &fluid_particles = fluid_cube.getBaseParticles();
+    size_t number_of_particles = fluid_particles.total_real_particles_;
+    harness.setConfiguration(number_of_particles, threads);
+
+    harness.run("cell_linked_list", number_of_particles,
+                [&]()
+                { fluid_cube.updateCellLinkedList(); });
+    harness.run("cell_linked_list_contiguous", number_of_particles,
+                [&]()
+                { contiguous_cube.updateCellLinkedList(); });
+    // batch size zero is the search over the contiguous cell lists without prefilter
+    CellLinkedList &contiguous_cell_linked_list =
+        DynamicCast<CellLinkedList>(&harness, contiguous_cube.getCellLinkedList());
+    StdVec<size_t> prefilter_batch_sizes = {0, 16, 32, 64};
+    for (size_t batch_size : prefilter_batch_sizes)
+    {
+        contiguous_cell_linked_list.setPrefilterBatchSize(batch_size);
+        harness.run("inner_neighbor_search_prefilter_" + std::to_string(batch_size), number_of_particles,
+                    [&]()
+                    { contiguous_inner.updateConfiguration(); });
+    }
+    harness.run("inner_neighbor_search", number_of_particles,
+                [&]()
+                { fluid_inner.updateConfiguration(); });
+    harness.run("inner_neighbor_search_virtual_kernel", number_of_particles,
+                [&]()
+                { fluid_inner_virtual_kernel.updateConfiguration(); });
+    harness.run("inner_neighbor_search_half_list", number_of_particles,
+                [&]()
+                { fluid_half_inner.updateConfiguration(); });
+    harness.run("contact_neighbor_search", number_of_particles,
+                [&]()
+                { fluid_wall_contact.updateConfiguration(); });
+    harness.run("contact_neighbor_search_virtual_kernel", number_of_particles,
+                [&]()
+                { fluid_wall_contact_virtual_kernel.updateConfiguration(); });
+    harness.run("density_summation", number_of_particles,
+                [&]()
+                { update_density_by_summation.exec(); });
+    harness.run("integration_1st_half", number_of_particles,
+                [&]()
+                { pressure_relaxation.exec(dt); });
+    harness.run("integration_1st_half_symmetric", number_of_particles,
+                [&]()
+                { symmetric_pressure_relaxation.exec(dt); });
+    harness.run("integration_2nd_half", number_of_particles,
+                [&]()
+                { density_relaxation.exec(dt); });
+    harness.run("integration_2nd_half_symmetric", number_of_particles,
+                [&]()
+                { symmetric_density_relaxation.exec(dt); });
+    harness.run("integration_step_separate", number_of_particles,
+                [&]()
+                {
+                    constant_gravity.exec();
+                    pressure_relaxation.exec(dt);
+                    density_relaxation.exec(dt);
+                    get_fluid_time_step_size.exec();
+                });
+    harness.run("integration_step_fused", number_of_particles,
+                [&]()
+                { fused_integration.exec(dt); });
+    harness.run("particle_sorting", number_of_particles,
+                [&]()
+                { fluid_particles.sortParticles(fluid_cube.getCellLinkedList()); });
+    fluid_cube.setParticleSortingMethod(ParticleSortingMethod::RadixSort);
+    harness.run("particle_sorting_radix", number_of_particles,
+                [&]()
+                { fluid_particles.sortParticles(fluid_cube.getCellLinkedList()); });
+    fluid_cube.setParticleSortingMethod(ParticleSortingMethod::QuickSort);
+
+    StdVec<std::pair<std::string, SpaceFillingCurve>> curves = {
+        {"linear", SpaceFillingCurve::Linear},
+        {"morton", SpaceFillingCurve::Morton},
+        {"hilbert", SpaceFillingCurve::Hilbert}};
+    for (auto &curve : curves)
+    {
+        fluid_cube.setParticleSortingCurve(curve.second);
+        fluid_cube.updateCellLinkedListWithParticleSort(1);
+        harness.run("configuration_" + curve.first + "_sorted", number_of_particles,
+                    [&]()
+                    {
+                        fluid_cube.updateCellLinkedList();
+                        fluid_inner.updateConfiguration();
+                        update_density_by_summation.exec();
+                    });
+    }
+
+    BaseParticles &buffer_particles = buffer_cube.getBaseParticles();
+    StdLargeVec<size_t> switched_particles, source_particles;
+    for (size_t i = buffer_particles.total_real_particles_; i != 0; --i)
+        if (i % 3 == 0)
+            switched_particles.push_back(i - 1);
+    size_t number_of_switched = switched_particles.size();
+    for (size_t n = 0; n != number_of_switched; ++n)
+        source_particles.push_back(n);
+    // the particles are switched from the back, so that the remaining indices are not moved
+    harness.run("buffer_switching_sequential", number_of_particles,
+                [&]()
+                {
+                    for (size_t n = 0; n != number_of_switched; ++n)
+                        buffer_particles.switchToBufferParticle(switched_particles[n]);
+                    buffer_particles.createRealParticlesFrom(source_particles, number_of_switched);
+                });
+    harness.run("buffer_switching_batched", number_of_particles,
+                [&]()
+                {
+                    buffer_particles.switchToBufferParticles(switched_particles, number_of_switched);
+                    buffer_particles.createRealParticlesFrom(source_particles, number_of_switched);
+                });
+
+    size_t io_iterations = SMAX(iterations / 10, size_t(1));
+    harness.run(
+        "level_set_construction", number_of_particles,
+        [&]()
+        {
+            GeometricShapeBall ball_shape(0.5 * DL * Vecd::Ones(), 0.4 * DL, "Ball");
+            LevelSetShape level_set_shape(fluid_cube, ball_shape, 1.0);
+        },
+        io_iterations);
+    harness.run(
+        "level_set_construction_cached", number_of_particles,
+        [&]()
+        {
+            GeometricShapeBall ball_shape(0.5 * DL * Vecd::Ones(), 0.4 * DL, "Ball");
+            LevelSetShape level_set_shape(fluid_cube, ball_shape, 1.0, true);
+        },
+        io_iterations);
+
+    GeometricShapeBall ball_shape(0.5 * DL * Vecd::Ones(), 0.4 * DL, "Ball");
+    LevelSetShape level_set_shape(fluid_cube, ball_shape, 1.0);
+    StdLargeVec<LevelSetProbe> level_set_probes(number_of_particles);
+    harness.run("level_set_probing", number_of_particles,
+                [&]()
+                {
+                    for (size_t i = 0; i != number_of_particles; ++i)
+                    {
+                        Vecd &position = fluid_particles.pos_[i];
+                        level_set_probes[i].phi_ = level_set_shape.findSignedDistance(position);
+                        level_set_probes[i].phi_gradient_ = level_set_shape.findLevelSetGradient(position);
+                        level_set_probes[i].kernel_weight_ = level_set_shape.computeKernelIntegral(position);
+                        level_set_probes[i].kernel_gradient_ = level_set_shape.computeKernelGradientIntegral(position);
+                    }
+                });
+    harness.run("level_set_probing_batched", number_of_particles,
+                [&]()
+                {
+                    level_set_shape.probeLevelSet(fluid_particles.pos_.data(), nullptr, number_of_particles,
+                                                  level_set_probes.data(),
+                                                  ProbeSignedDistance | ProbeLevelSetGradient |
+                                                      ProbeKernelIntegral | ProbeKernelGradientIntegral);
+                });
+
+    TriangleMeshShapeSphere simbody_sphere(0.4 * DL, 6, 0.5 * DL * Vec3d::Ones(), "SimbodySphere");
+    BVHTriangleMeshShape<TriangleMeshShapeSphere> bvh_sphere(0.4 * DL, 6, 0.5 * DL * Vec3d::Ones(), "BVHSphere");
+    StdVec<Vec3d> probe_points(fluid_particles.pos_.begin(), fluid_particles.pos_.begin() + number_of_particles);
+    StdVec<Real> signed_distances(number_of_particles);
+    harness.run(
+        "signed_distance_simbody", number_of_particles,
+        [&]()
+        {
+            for (size_t i = 0; i != number_of_particles; ++i)
+                signed_distances[i] = simbody_sphere.findSignedDistance(probe_points[i]);
+        },
+        io_iterations);
+    harness.run("signed_distance_bvh", number_of_particles,
+                [&]()
+                {
+                    for (size_t i = 0; i != number_of_particles; ++i)
+                        signed_distances[i] = bvh_sphere.findSignedDistance(probe_points[i]);
+                });
+    harness.run("signed_distance_bvh_batched", number_of_particles,
+                [&]()
+                { bvh_sphere.getBVH().findSignedDistances(probe_points, signed_distances); });
+
+    size_t output_step = 0;
+    harness.run(
+        "vtp_output", number_of_particles,
+        [&]()
+        { write_fluid_states.writeToFile(output_step++); },
+        io_iterations);
+    harness.run(
+        "vtp_output_binary", number_of_particles,
+        [&]()
+        { write_fluid_states_in_binary.writeToFile(output_step++); },
+        io_iterations);
+    harness.run(
+        "vtp_output_compressed", number_of_particles,
+        [&]()
+        { write_fluid_states_in_compressed_binary.writeToFile(output_step++); },
+        io_iterations);
+    harness.run(
+        "restart_xml", number_of_particles,
+        [&]()
+        {
+            xml_restart_io.writeToFile(output_step);
+            xml_restart_io.readRestartFiles(output_step++);
+        },
+        io_iterations);
+    harness.run(
+        "restart_binary", number_of_particles,
+        [&]()
+        {
+            binary_restart_io.writeToFile(output_step);
+            binary_restart_io.readRestartFiles(output_step++);
+        },
+        io_iterations);
+    harness.run(
+        "reload_xml", number_of_particles,
+        [&]()
+        {
+            xml_reload_io.writeToFile();
+            xml_reload_io.readFromFile();
+        },
+        io_iterations);
+    harness.run(
+        "reload_binary", number_of_particles,
+        [&]()
+        {
+            binary_reload_io.writeToFile();
+            binary_reload_io.readFromFile();
+        },
+        io_iterations);
+}
+
+int main(int ac, char *av[])
+{
+    StdVec<size_t> particle_counts = {10000, 100000};
+    StdVec<size_t> thread_counts = {std::thread::hardware_concurrency()};
+    size_t iterations = 20;
+    std::string output_file = "benchmark_results.csv";
+    std::string baseline_file;
+    Real tolerance = 0.1;
+
+    for (int i = 1; i != ac; ++i)
+    {
+        std::string argument(av[i]);
+        size_t separator = argument.find('=');
+        std::string key = argument.substr(0, separator);
+        std::string value = separator == std::string::npos ? "" : argument.substr(separator + 1);
+        if (key == "--particles")
+            particle_counts = parseCounts(value);
+        else if (key == "--threads")
+            thread_counts = parseCounts(value);
+        else if (key == "--iterations")
+            iterations = std::stoul(value);
+        else if (key == "--output")
+            output_file = value;
+        else if (key == "--baseline")
+            baseline_file = value;
+        else if (key == "--tolerance")
+            tolerance = std::stod(value);
+        else
+        {
+            std::cout << "\n Error: unknown option " << argument << ". The options are --particles, --threads, "
+                      << "--iterations, --output, --baseline and --tolerance." << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    }
+
+    BenchmarkHarness harness(iterations);
+    std::cout << std::setw(28) << std::left << "benchmark" << std::right << std::setw(12) << "particles"
+              << std::setw(4) << "thr" << std::setw(14) << "s/iteration" << std::setw(14) << "updates/s" << std::endl;
+    for (size_t particles : particle_counts)
+        for (size_t threads : thread_counts)
+            runBenchmarks(harness, particles, threads, iterations);
+
+    harness.writeResults(output_file);
+    std::cout << "The benchmark results are written to " << output_file << "." << std::endl;
+    if (!baseline_file.empty())
+    {
+        size_t number_of_regressions = harness.checkAgainstBaseline(baseline_file, tolerance);
+        std::cout << number_of_regressions << " benchmarks regressed by more than "
+                  << 100.0 * tolerance << "% against " << baseline_file << "." << std::endl;
+        return number_of_regressions == 0 ? 0 : 1;
+    }
+    return 0;
+}
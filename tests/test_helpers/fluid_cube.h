@@ -0,0 +1,33 @@
+/**
+ * @file 	fluid_cube.h
+ * @brief 	The block of fluid shared by the 3D unit tests and the benchmarks.
+ * @details The cube is given by its edge length and lower corner. The fluid particles
+ *          are generated on a lattice with a weakly compressible fluid of unit density.
+ *          The tests needing reserved or reloaded particles define them by themselves.
+ */
+#ifndef FLUID_CUBE_H
+#define FLUID_CUBE_H
+
+#include "sphinxsys.h"
+
+namespace SPH
+{
+class FluidCube : public ComplexShape
+{
+  public:
+    explicit FluidCube(const std::string &shape_name, Real edge_length = 1.0,
+                       const Vecd &lower_corner = Vecd::Zero())
+        : ComplexShape(shape_name)
+    {
+        Vecd halfsize = 0.5 * edge_length * Vecd::Ones();
+        add<TransformShape<GeometricShapeBox>>(Transform(lower_corner + halfsize), halfsize);
+    }
+};
+
+inline void generateFluidParticles(FluidBody &fluid_body, Real rho0 = 1.0, Real c = 10.0, Real mu = 0.0)
+{
+    fluid_body.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(rho0, c, mu);
+    fluid_body.generateParticles<Lattice>();
+}
+} // namespace SPH
+#endif // FLUID_CUBE_H
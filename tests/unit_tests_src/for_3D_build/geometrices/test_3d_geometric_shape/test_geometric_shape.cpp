@@ -1,5 +1,7 @@
 #include "geometric_shape.h"
+#include "mapping_shape.h"
 #include "transform_shape.h"
+#include "triangle_mesh_shape.h"
 #include <gtest/gtest.h>
 
 using namespace SPH;
@@ -15,6 +17,43 @@ TEST(test_GeometricShapeBox, test_findBounds)
     EXPECT_EQ(BoundingBox(Vec3d(0.0, 0.0, 0.0), Vec3d(2.0, 1.0, 0.5)), box);
 }
 
+TEST(test_ShapeWrappers, test_findSignedDistance)
+{
+    Real tolerance = 1.0e-6;
+    TransformShape<GeometricShapeBox> brick(Transform(Vec3d(1.0, 0.0, 0.0)), Vec3d(0.5, 0.5, 0.5));
+    EXPECT_NEAR(brick.findSignedDistance(Vec3d(1.0, 0.0, 0.0)), -0.5, tolerance);
+    EXPECT_NEAR(brick.findSignedDistance(Vec3d(2.0, 0.0, 0.0)), 0.5, tolerance);
+    EXPECT_TRUE(brick.findNormalDirection(Vec3d(2.0, 0.0, 0.0)).isApprox(Vec3d(1.0, 0.0, 0.0)));
+
+    InverseShape<GeometricShapeBall> inverse_ball(Vec3d::Zero(), 1.0);
+    EXPECT_NEAR(inverse_ball.findSignedDistance(Vec3d(0.5, 0.0, 0.0)), 0.5, tolerance);
+    EXPECT_NEAR(inverse_ball.findSignedDistance(Vec3d(2.0, 0.0, 0.0)), -1.0, tolerance);
+    EXPECT_TRUE(inverse_ball.findNormalDirection(Vec3d(0.5, 0.0, 0.0)).isApprox(Vec3d(-1.0, 0.0, 0.0)));
+
+    ExtrudeShape<GeometricShapeBall> extruded_ball(0.2, Vec3d::Zero(), 1.0);
+    EXPECT_NEAR(extruded_ball.findSignedDistance(Vec3d(2.0, 0.0, 0.0)), 0.8, tolerance);
+    EXPECT_NEAR(extruded_ball.findSignedDistance(Vec3d(0.5, 0.0, 0.0)), -0.7, tolerance);
+
+    InverseShape<TransformShape<GeometricShapeBall>> inverse_moved_ball(Transform(Vec3d(0.0, 1.0, 0.0)), Vec3d::Zero(), 1.0);
+    EXPECT_NEAR(inverse_moved_ball.findSignedDistance(Vec3d(0.0, 1.5, 0.0)), 0.5, tolerance);
+    EXPECT_NEAR(inverse_moved_ball.findSignedDistance(Vec3d(0.0, 3.0, 0.0)), -1.0, tolerance);
+}
+
+TEST(test_ShapeWrappers, test_forwardedSignedDistanceQuery)
+{
+    // the faceted sphere deviates from the analytic one by less than the tolerance
+    Real tolerance = 0.02;
+    using BVHSphere = BVHTriangleMeshShape<TriangleMeshShapeSphere>;
+    InverseShape<TransformShape<BVHSphere>> inverse_moved_sphere(Transform(Vec3d(0.0, 1.0, 0.0)), 1.0, 3, Vec3d::Zero());
+    EXPECT_NEAR(inverse_moved_sphere.findSignedDistance(Vec3d(0.0, 1.5, 0.0)), 0.5, tolerance);
+    EXPECT_NEAR(inverse_moved_sphere.findSignedDistance(Vec3d(0.0, 3.0, 0.0)), -1.0, tolerance);
+    EXPECT_TRUE(inverse_moved_sphere.findNormalDirection(Vec3d(0.0, 1.5, 0.0)).isApprox(Vec3d(0.0, -1.0, 0.0), tolerance));
+
+    ExtrudeShape<BVHSphere> extruded_sphere(0.2, 1.0, 3, Vec3d::Zero());
+    EXPECT_NEAR(extruded_sphere.findSignedDistance(Vec3d(2.0, 0.0, 0.0)), 0.8, tolerance);
+    EXPECT_NEAR(extruded_sphere.findSignedDistance(Vec3d(0.5, 0.0, 0.0)), -0.7, tolerance);
+}
+
 int main(int argc, char *argv[])
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,67 @@
+/**
+ * @file 	test_3d_level_set_batch_probing.cpp
+ * @brief 	Test of the batched probing of level set.
+ * @details The level set of a ball is probed at random positions one by one and in a batch.
+ *          The probed values are checked to be identical. The probing is timed in the benchmarks.
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 40.0;
+BoundingBox system_domain_bounds(-Vec3d::Ones(), Vec3d::Ones());
+size_t number_of_probes = 20000;
+
+TEST(test_LevelSetBatchProbing, test_ProbedValues)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody ball(sph_system, makeShared<GeometricShapeBall>(Vecd::Zero(), 0.5 * DL, "Ball"));
+    GeometricShapeBall ball_shape(Vecd::Zero(), 0.5 * DL, "Ball");
+    LevelSetShape level_set_shape(ball, ball_shape, 1.0);
+    level_set_shape.cleanLevelSet();
+
+    std::mt19937 random_engine(1);
+    std::uniform_real_distribution<Real> uniform(-0.7 * DL, 0.7 * DL);
+    StdLargeVec<Vecd> probe_points(number_of_probes);
+    for (Vecd &probe_point : probe_points)
+        probe_point = Vecd(uniform(random_engine), uniform(random_engine), uniform(random_engine));
+
+    StdLargeVec<LevelSetProbe> single_probes(number_of_probes);
+    for (size_t i = 0; i != number_of_probes; ++i)
+    {
+        single_probes[i].phi_ = level_set_shape.findSignedDistance(probe_points[i]);
+        single_probes[i].phi_gradient_ = level_set_shape.findLevelSetGradient(probe_points[i]);
+        single_probes[i].kernel_weight_ = level_set_shape.computeKernelIntegral(probe_points[i]);
+        single_probes[i].kernel_gradient_ = level_set_shape.computeKernelGradientIntegral(probe_points[i]);
+    }
+
+    StdLargeVec<LevelSetProbe> batched_probes(number_of_probes);
+    level_set_shape.probeLevelSet(probe_points.data(), nullptr, number_of_probes, batched_probes.data(),
+                                  ProbeSignedDistance | ProbeLevelSetGradient |
+                                      ProbeKernelIntegral | ProbeKernelGradientIntegral);
+
+    for (size_t i = 0; i != number_of_probes; ++i)
+    {
+        ASSERT_EQ(single_probes[i].phi_, batched_probes[i].phi_);
+        ASSERT_EQ(single_probes[i].phi_gradient_, batched_probes[i].phi_gradient_);
+        ASSERT_EQ(single_probes[i].kernel_weight_, batched_probes[i].kernel_weight_);
+        ASSERT_EQ(single_probes[i].kernel_gradient_, batched_probes[i].kernel_gradient_);
+    }
+
+    StdLargeVec<LevelSetProbe> kernel_gradient_probes(number_of_probes);
+    level_set_shape.probeLevelSet(probe_points.data(), nullptr, number_of_probes,
+                                  kernel_gradient_probes.data(), ProbeKernelGradientIntegral);
+    for (size_t i = 0; i != number_of_probes; ++i)
+    {
+        ASSERT_EQ(single_probes[i].kernel_gradient_, kernel_gradient_probes[i].kernel_gradient_);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+/**
+ * @file 	test_3d_level_set_cache.cpp
+ * @brief 	Test of the on-disk cache of level set shapes.
+ * @details The level set of a ball is built, cleaned and cached in the reload folder.
+ *          A second level set shape of the same ball is loaded from the cache
+ *          and checked to give identical probes. The cached construction is timed in the benchmarks.
+ *          Changed geometries, also within the same bounds, are not loaded from the cache,
+ *          nor are shapes without geometry fingerprint. A cached level set probed before all
+ *          the cached operations are applied, or with other operations, is rejected.
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 40.0;
+BoundingBox system_domain_bounds(-Vec3d::Ones(), Vec3d::Ones());
+
+TEST(test_LevelSetCache, test_CachedLevelSet)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.setIOEnvironment();
+    SolidBody ball(sph_system, makeShared<GeometricShapeBall>(Vecd::Zero(), 0.5 * DL, "Ball"));
+    GeometricShapeBall ball_shape(Vecd::Zero(), 0.5 * DL, "Ball");
+    fs::remove_all(sph_system.getIOEnvironment().reload_folder_);
+    fs::create_directory(sph_system.getIOEnvironment().reload_folder_);
+
+    LevelSetShape built_level_set(ball, ball_shape, 2.0, true);
+    built_level_set.correctLevelSetSign()->cleanLevelSet();
+    EXPECT_FALSE(built_level_set.isLoadedFromCache());
+
+    LevelSetShape cached_level_set(ball, ball_shape, 2.0, true);
+    cached_level_set.correctLevelSetSign()->cleanLevelSet();
+    EXPECT_TRUE(cached_level_set.isLoadedFromCache());
+
+    BaseMesh probe_mesh(-0.8 * DL * Vecd::Ones(), 0.04 * DL, Arrayi::Constant(41));
+    for (size_t n = 0; n != size_t(pow(41, 3)); ++n)
+    {
+        Vecd position = probe_mesh.GridPositionFromIndex(probe_mesh.transfer1DtoMeshIndex(Arrayi::Constant(41), n));
+        ASSERT_EQ(built_level_set.checkContain(position), cached_level_set.checkContain(position));
+        ASSERT_EQ(built_level_set.findLevelSetGradient(position), cached_level_set.findLevelSetGradient(position));
+        ASSERT_EQ(built_level_set.computeKernelIntegral(position), cached_level_set.computeKernelIntegral(position));
+        ASSERT_EQ(built_level_set.computeKernelGradientIntegral(position),
+                  cached_level_set.computeKernelGradientIntegral(position));
+    }
+
+    GeometricShapeBall smaller_ball_shape(Vecd::Zero(), 0.4 * DL, "Ball");
+    LevelSetShape smaller_level_set(ball, smaller_ball_shape, 2.0, true);
+    EXPECT_FALSE(smaller_level_set.isLoadedFromCache());
+
+    // a small cavity does not change the bounds but is given by the geometry fingerprint
+    ComplexShape hollow_ball_shape("Ball");
+    hollow_ball_shape.add<GeometricShapeBall>(Vecd::Zero(), 0.5 * DL, "OuterBall");
+    hollow_ball_shape.subtract<GeometricShapeBall>(0.06 * DL * Vecd::Ones(), 0.03 * DL, "Cavity");
+    LevelSetShape hollow_level_set(ball, hollow_ball_shape, 2.0, true);
+    EXPECT_FALSE(hollow_level_set.isLoadedFromCache());
+    LevelSetShape cached_hollow_level_set(ball, hollow_ball_shape, 2.0, true);
+    EXPECT_TRUE(cached_hollow_level_set.isLoadedFromCache());
+}
+
+class BallWithoutFingerprint : public GeometricShapeBall
+{
+  public:
+    BallWithoutFingerprint(const Vecd &center, Real radius, const std::string &shape_name)
+        : GeometricShapeBall(center, radius, shape_name){};
+    virtual bool writeGeometryFingerprint(std::ostream &output) override { return false; };
+};
+
+TEST(test_LevelSetCache, test_ShapeWithoutFingerprint)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.setIOEnvironment();
+    SolidBody ball(sph_system, makeShared<GeometricShapeBall>(Vecd::Zero(), 0.5 * DL, "Ball"));
+    BallWithoutFingerprint ball_shape(Vecd::Zero(), 0.5 * DL, "Ball");
+    fs::remove_all(sph_system.getIOEnvironment().reload_folder_);
+    fs::create_directory(sph_system.getIOEnvironment().reload_folder_);
+
+    LevelSetShape built_level_set(ball, ball_shape, 2.0, true);
+    built_level_set.cleanLevelSet();
+    EXPECT_TRUE(fs::is_empty(sph_system.getIOEnvironment().reload_folder_));
+    LevelSetShape rebuilt_level_set(ball, ball_shape, 2.0, true);
+    rebuilt_level_set.cleanLevelSet();
+    EXPECT_FALSE(rebuilt_level_set.isLoadedFromCache());
+}
+
+TEST(test_LevelSetCache, test_CachedOperations)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.setIOEnvironment();
+    SolidBody ball(sph_system, makeShared<GeometricShapeBall>(Vecd::Zero(), 0.5 * DL, "Ball"));
+    GeometricShapeBall ball_shape(Vecd::Zero(), 0.5 * DL, "Ball");
+    fs::remove_all(sph_system.getIOEnvironment().reload_folder_);
+    fs::create_directory(sph_system.getIOEnvironment().reload_folder_);
+
+    // the cache file is deleted when rejected, also by the death tests
+    auto build_cache = [&]()
+    {
+        LevelSetShape built_level_set(ball, ball_shape, 2.0, true);
+        built_level_set.correctLevelSetSign()->cleanLevelSet();
+    };
+
+    // more operations than requested have been applied in the cached level set
+    build_cache();
+    LevelSetShape fewer_operations_level_set(ball, ball_shape, 2.0, true);
+    fewer_operations_level_set.correctLevelSetSign();
+    EXPECT_TRUE(fewer_operations_level_set.isLoadedFromCache());
+    EXPECT_EXIT(fewer_operations_level_set.checkContain(Vecd::Zero()), testing::ExitedWithCode(1), "");
+
+    build_cache();
+    LevelSetShape other_operations_level_set(ball, ball_shape, 2.0, true);
+    EXPECT_EXIT(other_operations_level_set.cleanLevelSet(), testing::ExitedWithCode(1), "");
+
+    build_cache();
+    LevelSetShape same_operations_level_set(ball, ball_shape, 2.0, true);
+    same_operations_level_set.correctLevelSetSign()->cleanLevelSet();
+    EXPECT_TRUE(same_operations_level_set.isLoadedFromCache());
+    EXPECT_TRUE(same_operations_level_set.checkContain(Vecd::Zero()));
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
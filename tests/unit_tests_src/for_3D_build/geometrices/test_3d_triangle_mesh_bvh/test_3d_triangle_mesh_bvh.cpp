@@ -0,0 +1,66 @@
+/**
+ * @file 	test_3d_triangle_mesh_bvh.cpp
+ * @brief 	Test of the BVH-accelerated triangle mesh shape.
+ * @details The signed distances of random probe points to a triangulated sphere are computed
+ *          with Simbody and with the bounding volume hierarchy and checked to be identical.
+ *          The ray intersections and normal directions are checked against the sphere.
+ *          The queries are timed in the benchmarks.
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace SPH;
+
+Real radius = 1.0;
+int sphere_resolution = 5;
+size_t number_of_probes = 2000;
+
+TEST(test_TriangleMeshBVH, test_SphereQueries)
+{
+    TriangleMeshShapeSphere simbody_sphere(radius, sphere_resolution, Vec3d::Zero(), "SimbodySphere");
+    BVHTriangleMeshShape<TriangleMeshShapeSphere> bvh_sphere(radius, sphere_resolution, Vec3d::Zero(), "BVHSphere");
+    TriangleMeshBVH &bvh = bvh_sphere.getBVH();
+
+    std::mt19937 random_engine(1);
+    std::uniform_real_distribution<Real> uniform(-1.5 * radius, 1.5 * radius);
+    StdVec<Vec3d> probe_points(number_of_probes);
+    for (Vec3d &probe_point : probe_points)
+        probe_point = Vec3d(uniform(random_engine), uniform(random_engine), uniform(random_engine));
+
+    StdVec<Real> simbody_distances(number_of_probes);
+    for (size_t i = 0; i != number_of_probes; ++i)
+        simbody_distances[i] = simbody_sphere.findSignedDistance(probe_points[i]);
+    StdVec<Real> bvh_distances(number_of_probes);
+    for (size_t i = 0; i != number_of_probes; ++i)
+        bvh_distances[i] = bvh_sphere.findSignedDistance(probe_points[i]);
+    StdVec<Real> batched_distances;
+    bvh.findSignedDistances(probe_points, batched_distances);
+
+    for (size_t i = 0; i != number_of_probes; ++i)
+    {
+        EXPECT_EQ(bvh_distances[i], batched_distances[i]);
+        EXPECT_NEAR(fabs(bvh_distances[i]), fabs(simbody_distances[i]), 1.0e-9 * radius);
+        if (fabs(probe_points[i].norm() - radius) > 1.0e-2 * radius)
+        {
+            EXPECT_EQ(bvh_distances[i] < 0.0, simbody_distances[i] < 0.0);
+            EXPECT_EQ(bvh_sphere.checkContain(probe_points[i]), probe_points[i].norm() < radius);
+        }
+    }
+
+    for (size_t i = 0; i != 1000; ++i)
+    {
+        Vec3d direction = probe_points[i].normalized();
+        Real distance = 0.0;
+        size_t face = 0;
+        ASSERT_TRUE(bvh.intersectRay(Vec3d::Zero(), direction, distance, face));
+        EXPECT_NEAR(distance, radius, 1.0e-2 * radius);
+        EXPECT_GT(bvh_sphere.findNormalDirection(probe_points[i]).dot(direction), 0.9);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,127 @@
+/**
+ * @file 	test_3d_vtp_binary_output.cpp
+ * @brief 	Test of the body states recording with binary VTK XML files.
+ * @details The states of a block of fluid are written as ASCII, raw binary,
+ *          compressed binary and piecewise compressed binary vtp files.
+ *          The binary files are checked to be smaller than the ASCII file, and the positions
+ *          are read back from the binary files and checked. The writing is timed in the benchmarks.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+
+#ifdef ZLIB_AVAILABLE
+#include <zlib.h>
+#endif
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 60.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DL, DL));
+
+void writeStates(SPHBody &body, BodyStatesRecording &body_states_recording)
+{
+    body.setNewlyUpdated();
+    body_states_recording.writeToFile(0);
+}
+
+/** Read the first appended data array, i.e. the positions, from a binary vtp file. */
+StdVec<float> readPositions(const std::string &filefullpath, bool is_compressed)
+{
+    std::ifstream in_file(filefullpath.c_str(), std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+    size_t data_begin = content.find("<AppendedData encoding=\"raw\">");
+    data_begin = content.find('_', data_begin) + 1;
+    const char *data = content.data() + data_begin;
+
+    uint64_t header[3];
+    std::memcpy(header, data, sizeof(header));
+    if (!is_compressed)
+    {
+        StdVec<float> positions(header[0] / sizeof(float));
+        std::memcpy(positions.data(), data + sizeof(uint64_t), header[0]);
+        return positions;
+    }
+
+    StdVec<float> positions;
+#ifdef ZLIB_AVAILABLE
+    size_t number_of_blocks = header[0];
+    size_t block_size = header[1];
+    StdVec<uint64_t> compressed_sizes(number_of_blocks);
+    std::memcpy(compressed_sizes.data(), data + 3 * sizeof(uint64_t), number_of_blocks * sizeof(uint64_t));
+    const char *block = data + (3 + number_of_blocks) * sizeof(uint64_t);
+    for (size_t n = 0; n != number_of_blocks; ++n)
+    {
+        StdVec<float> values(block_size / sizeof(float));
+        uLongf uncompressed_size = block_size;
+        uncompress(reinterpret_cast<Bytef *>(values.data()), &uncompressed_size,
+                   reinterpret_cast<const Bytef *>(block), compressed_sizes[n]);
+        positions.insert(positions.end(), values.begin(), values.begin() + uncompressed_size / sizeof(float));
+        block += compressed_sizes[n];
+    }
+#endif
+    return positions;
+}
+
+void checkPositions(StdVec<float> positions, BaseParticles &particles, size_t begin, size_t end)
+{
+    ASSERT_EQ(positions.size(), 3 * (end - begin));
+    for (size_t i = begin; i != end; ++i)
+    {
+        for (int k = 0; k != 3; ++k)
+        {
+            EXPECT_EQ(positions[3 * (i - begin) + k], float(particles.pos_[i][k]));
+        }
+    }
+}
+
+TEST(test_VtpBinaryOutput, test_WritingAndReading)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.setIOEnvironment();
+    FluidBody fluid_cube(sph_system, makeShared<FluidCube>("FluidCube", DL));
+    generateFluidParticles(fluid_cube);
+    BaseParticles &particles = fluid_cube.getBaseParticles();
+    particles.addVariableToWrite<Real>("Density");
+    size_t total_real_particles = particles.total_real_particles_;
+    std::string output_folder = sph_system.getIOEnvironment().output_folder_ + "/";
+
+    BodyStatesRecordingToVtp ascii_recording(fluid_cube);
+    BodyStatesRecordingToVtpBinary binary_recording(fluid_cube);
+    BodyStatesRecordingToVtpBinary compressed_recording(fluid_cube, true);
+    size_t number_of_pieces = 4;
+    BodyStatesRecordingToVtpBinary piecewise_recording(fluid_cube, true, number_of_pieces);
+
+    writeStates(fluid_cube, ascii_recording);
+    size_t ascii_size = fs::file_size(output_folder + "FluidCube_0000000000.vtp");
+    writeStates(fluid_cube, binary_recording);
+    size_t binary_size = fs::file_size(output_folder + "FluidCube_0000000000.vtp");
+    checkPositions(readPositions(output_folder + "FluidCube_0000000000.vtp", false), particles, 0, total_real_particles);
+
+    writeStates(fluid_cube, compressed_recording);
+    size_t compressed_size = fs::file_size(output_folder + "FluidCube_0000000000.vtp");
+#ifdef ZLIB_AVAILABLE
+    checkPositions(readPositions(output_folder + "FluidCube_0000000000.vtp", true), particles, 0, total_real_particles);
+#endif
+
+    writeStates(fluid_cube, piecewise_recording);
+    EXPECT_TRUE(fs::exists(output_folder + "FluidCube_0000000000.pvtp"));
+    for (size_t k = 0; k != number_of_pieces; ++k)
+    {
+        std::string piece_name = output_folder + "FluidCube_0000000000_" + std::to_string(k) + ".vtp";
+        EXPECT_TRUE(fs::exists(piece_name));
+#ifdef ZLIB_AVAILABLE
+        checkPositions(readPositions(piece_name, true), particles,
+                       k * total_real_particles / number_of_pieces, (k + 1) * total_real_particles / number_of_pieces);
+#endif
+    }
+
+    EXPECT_LT(binary_size, ascii_size);
+    EXPECT_LE(compressed_size, binary_size);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,156 @@
+/**
+ * @file 	test_3d_contiguous_cell_lists.cpp
+ * @brief 	Test of the contiguous cell lists built by two-pass binning.
+ * @details The configurations built from the concurrent and the contiguous cell lists,
+ *          where the candidate neighbors are prefiltered by their squared distances
+ *          in batches of several sizes, are checked to be identical. The split cell lists given by the ranges of the cells
+ *          in the contiguous cell lists are checked against the concurrent split cell lists.
+ *          The cell lists updates are timed in the benchmarks.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 40.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DL, DL));
+
+TEST(test_ContiguousCellLists, test_NeighborSearch)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody concurrent_cube(sph_system, makeShared<FluidCube>("ConcurrentCube", DL));
+    generateFluidParticles(concurrent_cube);
+
+    FluidBody contiguous_cube(sph_system, makeShared<FluidCube>("ContiguousCube", DL));
+    generateFluidParticles(contiguous_cube);
+    contiguous_cube.getCellLinkedList().useContiguousCellLists();
+
+    InnerRelation concurrent_cube_inner(concurrent_cube);
+    InnerRelation contiguous_cube_inner(contiguous_cube);
+
+    concurrent_cube.updateCellLinkedList();
+    contiguous_cube.updateCellLinkedList();
+    concurrent_cube_inner.updateConfiguration();
+    CellLinkedList &contiguous_cell_linked_list =
+        DynamicCast<CellLinkedList>(&contiguous_cube, contiguous_cube.getCellLinkedList());
+    size_t total_real_particles = concurrent_cube.getBaseParticles().total_real_particles_;
+    StdVec<size_t> prefilter_batch_sizes = {0, 1, 7, 64}; // zero for no prefilter
+    for (size_t batch_size : prefilter_batch_sizes)
+    {
+        contiguous_cell_linked_list.setPrefilterBatchSize(batch_size);
+        contiguous_cube_inner.updateConfiguration();
+        for (size_t i = 0; i != total_real_particles; ++i)
+        {
+            Neighborhood &concurrent_neighborhood = concurrent_cube_inner.inner_configuration_[i];
+            Neighborhood &contiguous_neighborhood = contiguous_cube_inner.inner_configuration_[i];
+            ASSERT_EQ(concurrent_neighborhood.current_size_, contiguous_neighborhood.current_size_);
+            std::set<size_t> concurrent_neighbors, contiguous_neighbors;
+            for (size_t n = 0; n != concurrent_neighborhood.current_size_; ++n)
+            {
+                concurrent_neighbors.insert(concurrent_neighborhood.j_[n]);
+                contiguous_neighbors.insert(contiguous_neighborhood.j_[n]);
+            }
+            EXPECT_EQ(concurrent_neighbors, contiguous_neighbors);
+        }
+    }
+}
+
+std::set<size_t> neighborSet(Neighborhood &neighborhood)
+{
+    std::set<size_t> neighbors;
+    for (size_t n = 0; n != neighborhood.current_size_; ++n)
+    {
+        neighbors.insert(neighborhood.j_[n]);
+    }
+    return neighbors;
+}
+
+TEST(test_ContiguousCellLists, test_PrefilteredContactSearch)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody concurrent_cube(sph_system, makeShared<FluidCube>("ConcurrentCube", DL));
+    generateFluidParticles(concurrent_cube);
+
+    FluidBody contiguous_cube(sph_system, makeShared<FluidCube>("ContiguousCube", DL));
+    generateFluidParticles(contiguous_cube);
+    contiguous_cube.getCellLinkedList().useContiguousCellLists();
+
+    StdVec<Vecd> probe_positions = observationPositionsOnPlane(
+        Vecd(0.1, 0.1, 0.5), Vecd(0.8, 0.0, 0.0), Vecd(0.0, 0.8, 0.0), 30, 30);
+    ObserverBody probes(sph_system, "Probes");
+    probes.generateParticles<Observer>(probe_positions);
+    ContactRelation concurrent_contact(probes, {&concurrent_cube});
+    ContactRelation contiguous_contact(probes, {&contiguous_cube});
+    ContactRelation concurrent_contact_with_skin(probes, {&concurrent_cube});
+    ContactRelation contiguous_contact_with_skin(probes, {&contiguous_cube});
+    Real skin_distance = 0.2 * concurrent_cube.sph_adaptation_->getKernel()->CutOffRadius();
+    concurrent_contact_with_skin.useVerletSkin(skin_distance);
+    contiguous_contact_with_skin.useVerletSkin(skin_distance);
+
+    concurrent_cube.updateCellLinkedList();
+    contiguous_cube.updateCellLinkedList();
+    concurrent_contact.updateConfiguration();
+    contiguous_contact.updateConfiguration();
+    concurrent_contact_with_skin.updateConfiguration();
+    contiguous_contact_with_skin.updateConfiguration();
+    for (size_t i = 0; i != probe_positions.size(); ++i)
+    {
+        Neighborhood &concurrent_neighborhood = concurrent_contact.contact_configuration_[0][i];
+        Neighborhood &contiguous_neighborhood = contiguous_contact.contact_configuration_[0][i];
+        EXPECT_GT(contiguous_neighborhood.current_size_, 0);
+        EXPECT_EQ(neighborSet(concurrent_neighborhood), neighborSet(contiguous_neighborhood));
+
+        Neighborhood &concurrent_neighborhood_with_skin = concurrent_contact_with_skin.contact_configuration_[0][i];
+        Neighborhood &contiguous_neighborhood_with_skin = contiguous_contact_with_skin.contact_configuration_[0][i];
+        EXPECT_GE(contiguous_neighborhood_with_skin.current_size_, contiguous_neighborhood.current_size_);
+        EXPECT_EQ(neighborSet(concurrent_neighborhood_with_skin), neighborSet(contiguous_neighborhood_with_skin));
+    }
+}
+
+TEST(test_ContiguousCellLists, test_SplitCellLists)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody concurrent_cube(sph_system, makeShared<FluidCube>("ConcurrentCube", DL));
+    generateFluidParticles(concurrent_cube);
+    concurrent_cube.setUseSplitCellLists();
+
+    FluidBody contiguous_cube(sph_system, makeShared<FluidCube>("ContiguousCube", DL));
+    generateFluidParticles(contiguous_cube);
+    contiguous_cube.setUseSplitCellLists();
+    contiguous_cube.getCellLinkedList().useContiguousCellLists();
+
+    concurrent_cube.updateCellLinkedList();
+    contiguous_cube.updateCellLinkedList();
+    SplitCellLists &split_cell_lists = concurrent_cube.getSplitCellLists();
+    ContiguousSplitCellLists &contiguous_split_cell_lists = contiguous_cube.getContiguousSplitCellLists();
+    EXPECT_FALSE(concurrent_cube.getContiguousSplitCellLists().is_built_);
+    ASSERT_TRUE(contiguous_split_cell_lists.is_built_);
+    ASSERT_EQ(split_cell_lists.size(), contiguous_split_cell_lists.cell_ranges_.size());
+    for (size_t k = 0; k != split_cell_lists.size(); ++k)
+    {
+        std::set<size_t> concurrent_particles, contiguous_particles;
+        for (size_t l = 0; l != split_cell_lists[k].size(); ++l)
+            concurrent_particles.insert(split_cell_lists[k][l]->begin(), split_cell_lists[k][l]->end());
+        for (const ParticlesBound &cell_range : contiguous_split_cell_lists.cell_ranges_[k])
+            for (size_t s = cell_range.first; s != cell_range.second; ++s)
+                contiguous_particles.insert(contiguous_split_cell_lists.particle_indexes_[s]);
+        EXPECT_EQ(concurrent_particles, contiguous_particles);
+    }
+
+    size_t total_real_particles = contiguous_cube.getBaseParticles().total_real_particles_;
+    StdLargeVec<size_t> visits(total_real_particles, 0);
+    particle_for(execution::ParallelPolicy(), contiguous_split_cell_lists,
+                 [&](size_t i)
+                 { visits[i]++; });
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        EXPECT_EQ(visits[i], 2); // forward and backward sweeps
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,78 @@
+/**
+ * @file 	test_3d_space_filling_curve.cpp
+ * @brief 	Tests of the space-filling curves used for particle sorting.
+ * @details The Hilbert code is checked to be a bijection whose consecutive codes are
+ *          face-neighboring cells. Then a block of fluid particles is sorted along
+ *          the linear, Morton and Hilbert curves, which should give the same neighbor numbers.
+ *          The sorting curves are timed in the benchmarks.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 40.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DL, DL));
+
+TEST(test_SpaceFillingCurve, test_HilbertCode)
+{
+    Array3i all_grid_points(8, 8, 8);
+    BaseMesh mesh(all_grid_points);
+    int bits = mesh.HilbertOrderBits();
+    size_t total = all_grid_points.prod();
+
+    StdVec<Array3i> cell_from_code(total, -Array3i::Ones());
+    for (int i = 0; i != all_grid_points[0]; ++i)
+        for (int j = 0; j != all_grid_points[1]; ++j)
+            for (int k = 0; k != all_grid_points[2]; ++k)
+            {
+                size_t code = mesh.HilbertCode(Array3i(i, j, k), bits);
+                ASSERT_LT(code, total);
+                EXPECT_EQ(cell_from_code[code][0], -1);
+                cell_from_code[code] = Array3i(i, j, k);
+            }
+
+    for (size_t n = 1; n != total; ++n)
+    {
+        EXPECT_EQ((cell_from_code[n] - cell_from_code[n - 1]).abs().sum(), 1);
+    }
+}
+
+TEST(test_SpaceFillingCurve, test_ParticleSortingCurves)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody fluid_cube(sph_system, makeShared<FluidCube>("FluidCube", DL));
+    generateFluidParticles(fluid_cube);
+    InnerRelation fluid_cube_inner(fluid_cube);
+
+    size_t total_real_particles = fluid_cube.getBaseParticles().total_real_particles_;
+    auto total_neighbors = [&]()
+    {
+        size_t sum = 0;
+        for (size_t i = 0; i != total_real_particles; ++i)
+            sum += fluid_cube_inner.inner_configuration_[i].current_size_;
+        return sum;
+    };
+
+    StdVec<SpaceFillingCurve> curves = {SpaceFillingCurve::Linear, SpaceFillingCurve::Morton, SpaceFillingCurve::Hilbert};
+    StdVec<size_t> neighbor_numbers;
+    for (SpaceFillingCurve curve : curves)
+    {
+        fluid_cube.setParticleSortingCurve(curve);
+        fluid_cube.updateCellLinkedListWithParticleSort(1);
+        fluid_cube_inner.updateConfiguration();
+        neighbor_numbers.push_back(total_neighbors());
+    }
+
+    for (size_t n = 1; n != neighbor_numbers.size(); ++n)
+    {
+        EXPECT_EQ(neighbor_numbers[n], neighbor_numbers[0]);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
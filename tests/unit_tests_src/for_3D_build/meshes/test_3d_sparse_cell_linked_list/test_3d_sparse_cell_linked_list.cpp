@@ -0,0 +1,92 @@
+/**
+ * @file 	test_3d_sparse_cell_linked_list.cpp
+ * @brief 	Test of the sparse cell linked list.
+ * @details A small block of fluid in a large domain is searched for neighbors
+ *          with the dense and the sparse cell linked lists. The configurations
+ *          are checked to be identical and only the occupied cells to be allocated.
+ *          The block is then moved across the domain, and the cells left behind are checked to be recycled.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 0.2;
+Real DD = 2.0;
+Real resolution_ref = 0.02;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DD, DD, DD));
+
+TEST(test_SparseCellLinkedList, test_NeighborSearch)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody dense_cube(sph_system, makeShared<FluidCube>("DenseCube", DL, Vecd(0.9, 0.9, 0.9)));
+    generateFluidParticles(dense_cube);
+
+    FluidBody sparse_cube(sph_system, makeShared<FluidCube>("SparseCube", DL, Vecd(0.9, 0.9, 0.9)));
+    sparse_cube.useSparseCellLinkedList();
+    generateFluidParticles(sparse_cube);
+
+    InnerRelation dense_cube_inner(dense_cube);
+    InnerRelation sparse_cube_inner(sparse_cube);
+    ContactRelation dense_sparse_contact(dense_cube, {&sparse_cube});
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+
+    SparseCellLinkedList &sparse_cell_linked_list =
+        *dynamic_cast<SparseCellLinkedList *>(&sparse_cube.getCellLinkedList());
+    Real cell_volume = pow(sparse_cell_linked_list.GridSpacing(), 3);
+    size_t cells_in_cube = (size_t)ceil(pow(DL, 3) / cell_volume);
+    EXPECT_LE(sparse_cell_linked_list.NumberOfOccupiedCells(), 8 * cells_in_cube);
+    EXPECT_LT(sparse_cell_linked_list.NumberOfOccupiedCells(), sparse_cell_linked_list.AllCells().prod() / 100);
+
+    size_t total_real_particles = dense_cube.getBaseParticles().total_real_particles_;
+    ASSERT_EQ(total_real_particles, sparse_cube.getBaseParticles().total_real_particles_);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        Neighborhood &dense_neighborhood = dense_cube_inner.inner_configuration_[i];
+        Neighborhood &sparse_neighborhood = sparse_cube_inner.inner_configuration_[i];
+        ASSERT_EQ(dense_neighborhood.current_size_, sparse_neighborhood.current_size_);
+        std::set<size_t> dense_neighbors, sparse_neighbors;
+        for (size_t n = 0; n != dense_neighborhood.current_size_; ++n)
+        {
+            dense_neighbors.insert(dense_neighborhood.j_[n]);
+            sparse_neighbors.insert(sparse_neighborhood.j_[n]);
+        }
+        EXPECT_EQ(dense_neighbors, sparse_neighbors);
+        // the contact neighbors of a particle in the other cube are the inner neighbors plus itself
+        EXPECT_EQ(dense_sparse_contact.contact_configuration_[0][i].current_size_, dense_neighborhood.current_size_ + 1);
+    }
+}
+
+TEST(test_SparseCellLinkedList, test_RecycleEmptyCells)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody sparse_cube(sph_system, makeShared<FluidCube>("SparseCube", DL, Vecd(0.9, 0.9, 0.9)));
+    sparse_cube.useSparseCellLinkedList();
+    generateFluidParticles(sparse_cube);
+    InnerRelation sparse_cube_inner(sparse_cube);
+    sph_system.initializeSystemCellLinkedLists();
+
+    SparseCellLinkedList &sparse_cell_linked_list =
+        *dynamic_cast<SparseCellLinkedList *>(&sparse_cube.getCellLinkedList());
+    size_t initial_occupied_cells = sparse_cell_linked_list.NumberOfOccupiedCells();
+    BaseParticles &particles = sparse_cube.getBaseParticles();
+    for (size_t step = 0; step != 10; ++step)
+    {
+        for (size_t i = 0; i != particles.total_real_particles_; ++i)
+            particles.pos_[i] += Vecd(0.07, 0.05, 0.03);
+        sparse_cube.updateCellLinkedList();
+        // the cells left empty by the previous update are released
+        sparse_cube.updateCellLinkedList();
+        EXPECT_LE(sparse_cell_linked_list.NumberOfOccupiedCells(), 2 * initial_occupied_cells);
+    }
+    sparse_cube_inner.updateConfiguration();
+    Neighborhood &neighborhood = sparse_cube_inner.inner_configuration_[0];
+    EXPECT_GT(neighborhood.current_size_, 0);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,74 @@
+/**
+ * @file 	test_3d_dynamics_profiling.cpp
+ * @brief 	Test of the per-dynamics profiling instrumentation.
+ * @details A few steps of a fluid block are computed. When the library is built with
+ *          SPHINXSYS_USE_PROFILING, the records of the dynamics, the relation and
+ *          the cell linked list update are checked and the report is checked to list them.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 20.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DL, DL));
+size_t number_of_steps = 10;
+
+TEST(test_DynamicsProfiling, test_ProfileRecords)
+{
+    EXPECT_EQ(profileTypeName(typeid(ProfileRecord)), "ProfileRecord");
+
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody fluid_cube(sph_system, makeShared<FluidCube>("FluidCube", DL));
+    generateFluidParticles(fluid_cube);
+    InnerRelation fluid_cube_inner(fluid_cube);
+
+    Gravity gravity(Vec3d(0.0, -1.0, 0.0));
+    SimpleDynamics<GravityForce> constant_gravity(fluid_cube, gravity);
+    InteractionWithUpdate<fluid_dynamics::DensitySummationInner> update_density_by_summation(fluid_cube_inner);
+    Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann> pressure_relaxation(fluid_cube_inner);
+    ReduceDynamics<fluid_dynamics::AcousticTimeStepSize> get_fluid_time_step_size(fluid_cube);
+
+    for (size_t n = 0; n != number_of_steps; ++n)
+    {
+        fluid_cube.updateCellLinkedList();
+        fluid_cube_inner.updateConfiguration();
+        constant_gravity.exec();
+        update_density_by_summation.exec();
+        Real dt = get_fluid_time_step_size.exec();
+        pressure_relaxation.exec(dt);
+    }
+
+#if SPHINXSYS_USE_PROFILING
+    DynamicsProfiler &profiler = DynamicsProfiler::instance();
+    size_t number_of_particles = fluid_cube.getBaseParticles().total_real_particles_;
+    StdVec<ProfileRecord *> records = {
+        &profiler.getRecord("FluidCube: updateCellLinkedList"),
+        &profiler.getRecord("FluidCube: " + profileTypeName(typeid(fluid_cube_inner))),
+        &profiler.getRecord("FluidCube: " + profileTypeName(typeid(constant_gravity))),
+        &profiler.getRecord("FluidCube: " + profileTypeName(typeid(update_density_by_summation))),
+        &profiler.getRecord("FluidCube: " + profileTypeName(typeid(get_fluid_time_step_size))),
+        &profiler.getRecord("FluidCube: " + profileTypeName(typeid(pressure_relaxation)))};
+    for (ProfileRecord *record : records)
+    {
+        EXPECT_EQ(record->calls_, number_of_steps) << record->name_;
+        EXPECT_EQ(record->particles_, number_of_steps * number_of_particles) << record->name_;
+        EXPECT_GT(record->seconds_, 0.0) << record->name_;
+    }
+    EXPECT_GT(records.back()->bytes_, 0);
+    std::stringstream report;
+    profiler.writeReport(report);
+    for (ProfileRecord *record : records)
+    {
+        EXPECT_NE(report.str().find(record->name_), std::string::npos) << record->name_;
+    }
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
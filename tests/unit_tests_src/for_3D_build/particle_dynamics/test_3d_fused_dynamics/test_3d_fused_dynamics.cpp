@@ -0,0 +1,148 @@
+/**
+ * @file 	test_3d_fused_dynamics.cpp
+ * @brief 	Test of the fused particle sweeps of successive dynamics.
+ * @details Two identical blocks of fluid falling under gravity are integrated with
+ *          separately executed and fused dynamics. The states and time step sizes
+ *          are checked to be identical. The fused dynamics are timed in the benchmarks.
+ *          The finishDynamics of the fused dynamics are checked to be called in order.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 30.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DL, DL));
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+
+template <typename DataType>
+Real maximumDifference(StdLargeVec<DataType> &data, StdLargeVec<DataType> &reference, size_t size)
+{
+    Real difference = 0.0;
+    for (size_t i = 0; i != size; ++i)
+    {
+        difference = SMAX(difference, Real((data[i] - reference[i]).norm()));
+    }
+    return difference;
+}
+
+Real maximumDifference(StdLargeVec<Real> &data, StdLargeVec<Real> &reference, size_t size)
+{
+    Real difference = 0.0;
+    for (size_t i = 0; i != size; ++i)
+    {
+        difference = SMAX(difference, ABS(data[i] - reference[i]));
+    }
+    return difference;
+}
+
+class FinishRecording : public LocalDynamics
+{
+  public:
+    FinishRecording(SPHBody &sph_body, StdVec<std::string> &finished_dynamics, const std::string &name)
+        : LocalDynamics(sph_body), finished_dynamics_(finished_dynamics), name_(name){};
+    virtual ~FinishRecording(){};
+
+    void update(size_t index_i, Real dt){};
+    virtual void finishDynamics(Real dt) override { finished_dynamics_.push_back(name_); };
+
+  protected:
+    StdVec<std::string> &finished_dynamics_;
+    std::string name_;
+};
+
+TEST(test_FusedDynamics, test_FinishDynamics)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody cube(sph_system, makeShared<FluidCube>("Cube", DL));
+    generateFluidParticles(cube, rho0_f, c_f);
+    InnerRelation cube_inner(cube);
+
+    StdVec<std::string> finished_dynamics;
+    SimpleDynamics<FinishRecording> first_recording(cube, finished_dynamics, "First");
+    Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann> pressure_relaxation(cube_inner);
+    SimpleDynamics<FinishRecording> second_recording(cube, finished_dynamics, "Second");
+    FusedDynamics<SimpleDynamics<FinishRecording>,
+                  Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann>,
+                  SimpleDynamics<FinishRecording>>
+        fused_dynamics(first_recording, pressure_relaxation, second_recording);
+
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    fused_dynamics.exec(0.0);
+    EXPECT_EQ(finished_dynamics, StdVec<std::string>({"First", "Second"}));
+}
+
+TEST(test_FusedDynamics, test_FluidIntegration)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody separate_cube(sph_system, makeShared<FluidCube>("SeparateCube", DL));
+    generateFluidParticles(separate_cube, rho0_f, c_f);
+    FluidBody fused_cube(sph_system, makeShared<FluidCube>("FusedCube", DL));
+    generateFluidParticles(fused_cube, rho0_f, c_f);
+
+    InnerRelation separate_cube_inner(separate_cube);
+    InnerRelation fused_cube_inner(fused_cube);
+
+    Gravity gravity(Vecd(0.0, 0.0, -1.0));
+    SimpleDynamics<GravityForce> separate_gravity(separate_cube, gravity);
+    Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann> separate_pressure_relaxation(separate_cube_inner);
+    Dynamics1Level<fluid_dynamics::Integration2ndHalfInnerRiemann> separate_density_relaxation(separate_cube_inner);
+    ReduceDynamics<fluid_dynamics::AcousticTimeStepSize> separate_time_step_size(separate_cube);
+
+    SimpleDynamics<GravityForce> fused_gravity(fused_cube, gravity);
+    Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann> fused_pressure_relaxation(fused_cube_inner);
+    Dynamics1Level<fluid_dynamics::Integration2ndHalfInnerRiemann> fused_density_relaxation(fused_cube_inner);
+    ReduceDynamics<fluid_dynamics::AcousticTimeStepSize> fused_time_step_size(fused_cube);
+    FusedDynamicsReduce<ReduceDynamics<fluid_dynamics::AcousticTimeStepSize>,
+                        SimpleDynamics<GravityForce>,
+                        Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann>,
+                        Dynamics1Level<fluid_dynamics::Integration2ndHalfInnerRiemann>>
+        fused_integration(fused_time_step_size, fused_gravity, fused_pressure_relaxation, fused_density_relaxation);
+
+    BaseParticles &separate_particles = separate_cube.getBaseParticles();
+    BaseParticles &fused_particles = fused_cube.getBaseParticles();
+    size_t total_real_particles = separate_particles.total_real_particles_;
+    std::mt19937 random_engine(1);
+    std::uniform_real_distribution<Real> uniform(-1.0, 1.0);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        Real rho = rho0_f * (1.0 + 0.01 * uniform(random_engine));
+        Vecd vel = 0.1 * c_f * Vecd(uniform(random_engine), uniform(random_engine), uniform(random_engine));
+        separate_particles.rho_[i] = fused_particles.rho_[i] = rho;
+        separate_particles.vel_[i] = fused_particles.vel_[i] = vel;
+    }
+
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+
+    size_t number_of_steps = 10;
+    Real separate_dt = separate_time_step_size.exec();
+    for (size_t n = 0; n != number_of_steps; ++n)
+    {
+        separate_gravity.exec();
+        separate_pressure_relaxation.exec(separate_dt);
+        separate_density_relaxation.exec(separate_dt);
+        separate_dt = separate_time_step_size.exec();
+    }
+
+    Real fused_dt = fused_time_step_size.exec();
+    for (size_t n = 0; n != number_of_steps; ++n)
+    {
+        fused_dt = fused_integration.exec(fused_dt);
+    }
+
+    EXPECT_EQ(fused_dt, separate_dt);
+    EXPECT_EQ(maximumDifference(fused_particles.pos_, separate_particles.pos_, total_real_particles), 0.0);
+    EXPECT_EQ(maximumDifference(fused_particles.vel_, separate_particles.vel_, total_real_particles), 0.0);
+    EXPECT_EQ(maximumDifference(fused_particles.rho_, separate_particles.rho_, total_real_particles), 0.0);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,89 @@
+/**
+ * @file 	test_3d_lazy_probing.cpp
+ * @brief 	Test of probing quantities directly from cell linked lists.
+ * @details The pressure of a block of fluid with a linear pressure field is observed on a plane of probes
+ *          with a contact relation and probed from the cell linked list. The results are checked to be
+ *          the same. The probed quantity is also written to a binary file which is read back and checked.
+ *          Writing into a missing output folder is checked to be reported as an error.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 20.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DL, DL));
+
+TEST(test_LazyProbing, test_ProbedPressure)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.setIOEnvironment();
+    FluidBody fluid_cube(sph_system, makeShared<FluidCube>("FluidCube", DL));
+    generateFluidParticles(fluid_cube);
+    BaseParticles &fluid_particles = fluid_cube.getBaseParticles();
+    StdLargeVec<Real> &p = *fluid_particles.getVariableByName<Real>("Pressure");
+    for (size_t i = 0; i != fluid_particles.total_real_particles_; ++i)
+        p[i] = 1.0 + fluid_particles.pos_[i][1];
+
+    StdVec<Vecd> probe_positions = observationPositionsOnPlane(
+        Vecd(0.2, 0.2, 0.5), Vecd(0.6, 0.0, 0.0), Vecd(0.0, 0.6, 0.0), 40, 40);
+    ObserverBody contact_observer(sph_system, "ContactObserver");
+    contact_observer.generateParticles<Observer>(probe_positions);
+    ObserverBody lazy_observer(sph_system, "LazyObserver");
+    lazy_observer.generateParticles<Observer>(probe_positions);
+    ContactRelation observer_contact(contact_observer, {&fluid_cube});
+
+    ObservingAQuantity<Real> observe_pressure(observer_contact, "Pressure");
+    ProbedQuantityRecording<Real> probe_pressure("Pressure", lazy_observer, {&fluid_cube});
+
+    fluid_cube.updateCellLinkedList();
+    observer_contact.updateConfiguration();
+    observe_pressure.exec();
+    probe_pressure.writeToFile(0);
+
+    StdLargeVec<Real> &observed_pressure = *contact_observer.getBaseParticles().getVariableByName<Real>("Pressure");
+    StdLargeVec<Real> &probed_pressure = *probe_pressure.getProbedQuantity();
+    ASSERT_EQ(probed_pressure.size(), observed_pressure.size());
+    for (size_t i = 0; i != probe_positions.size(); ++i)
+    {
+        EXPECT_NEAR(probed_pressure[i], observed_pressure[i], 1.0e-12);
+        EXPECT_NEAR(probed_pressure[i], 1.0 + probe_positions[i][1], 1.0e-2);
+    }
+
+    std::string filefullpath = sph_system.getIOEnvironment().output_folder_ + "/LazyObserver_Pressure_0000000000.bin";
+    std::ifstream input_file(filefullpath.c_str(), std::ios::binary);
+    char format_name[8] = {};
+    uint64_t version = 0, number_of_probes = 0;
+    double physical_time = 0.0;
+    input_file.read(format_name, 8);
+    input_file.read(reinterpret_cast<char *>(&version), sizeof(uint64_t));
+    input_file.read(reinterpret_cast<char *>(&number_of_probes), sizeof(uint64_t));
+    input_file.read(reinterpret_cast<char *>(&physical_time), sizeof(double));
+    EXPECT_EQ(std::string(format_name, 7), "SPHXPRB");
+    ASSERT_EQ(number_of_probes, probe_positions.size());
+
+    StdLargeVec<Vecd> read_positions(number_of_probes);
+    StdLargeVec<Real> read_pressure(number_of_probes);
+    size_t total_probes = number_of_probes;
+    ReadAParticleVariableFromBinary read_variable_from_binary(input_file, filefullpath, total_probes);
+    read_variable_from_binary("Position", read_positions);
+    read_variable_from_binary("Pressure", read_pressure);
+    for (size_t i = 0; i != probe_positions.size(); ++i)
+    {
+        EXPECT_EQ(read_positions[i], probe_positions[i]);
+        EXPECT_EQ(read_pressure[i], probed_pressure[i]);
+    }
+    input_file.close();
+
+    // the error message is written to the standard output, so only the exit code is checked
+    testing::FLAGS_gtest_death_test_style = "threadsafe";
+    fs::remove_all(sph_system.getIOEnvironment().output_folder_);
+    EXPECT_EXIT(probe_pressure.writeToFile(1), testing::ExitedWithCode(1), "");
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
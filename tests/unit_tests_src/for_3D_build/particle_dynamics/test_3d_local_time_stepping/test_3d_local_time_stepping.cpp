@@ -0,0 +1,131 @@
+/**
+ * @file 	test_3d_local_time_stepping.cpp
+ * @brief 	Test of the local time stepping with power-of-two time step levels.
+ * @details The particles in half of a block of fluid move fast, so that they have smaller local time step sizes.
+ *          The assigned levels are checked to be stable and smooth. Then, the block is advanced for a coarse
+ *          time step, and the total momentum is checked to be conserved by the local time stepping
+ *          but not by advancing each particle with the standard integration and its own time step size.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 16.0;
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DL, DL));
+
+void setInitialCondition(BaseParticles &fluid_particles)
+{
+    StdLargeVec<Vecd> &pos = fluid_particles.pos_;
+    for (size_t i = 0; i != fluid_particles.total_real_particles_; ++i)
+    {
+        fluid_particles.rho_[i] = rho0_f * (1.0 + 0.01 * sin(2.0 * Pi * pos[i][1] / DL));
+        fluid_particles.vel_[i] = pos[i][0] < 0.5 * DL ? Vecd(0.0, 0.0, 3.0 * c_f) : Vecd::Zero();
+    }
+}
+
+Vecd totalMomentum(BaseParticles &fluid_particles)
+{
+    Vecd momentum = Vecd::Zero();
+    for (size_t i = 0; i != fluid_particles.total_real_particles_; ++i)
+        momentum += fluid_particles.mass_[i] * fluid_particles.vel_[i];
+    return momentum;
+}
+
+/** returns the change of the total momentum in a coarse time step relative to the initial momentum */
+template <class PressureRelaxationType, class DensityRelaxationType>
+Real momentumChangeInCoarseTimeStep()
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.setIOEnvironment();
+    FluidBody fluid_cube(sph_system, makeShared<FluidCube>("FluidCube", DL));
+    generateFluidParticles(fluid_cube, rho0_f, c_f);
+    InnerRelation fluid_inner(fluid_cube);
+
+    ReduceDynamics<fluid_dynamics::LocalAcousticTimeStepSize> get_local_time_step_size(fluid_cube);
+    TimeStepLevels time_step_levels(fluid_inner);
+    Dynamics1LevelLocalTimeStepping<PressureRelaxationType> pressure_relaxation(time_step_levels, fluid_inner);
+    Dynamics1LevelLocalTimeStepping<DensityRelaxationType> density_relaxation(time_step_levels, fluid_inner);
+
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    BaseParticles &fluid_particles = fluid_cube.getBaseParticles();
+    setInitialCondition(fluid_particles);
+    Vecd initial_momentum = totalMomentum(fluid_particles);
+
+    Real min_time_step_size = get_local_time_step_size.exec();
+    time_step_levels.assignLevels(min_time_step_size, 1.0);
+    EXPECT_GT(time_step_levels.FinestLevel(), 0);
+    for (size_t k = 0; k != time_step_levels.NumberOfSubSteps(); ++k)
+    {
+        time_step_levels.setSubStep(k);
+        pressure_relaxation.exec();
+        density_relaxation.exec();
+    }
+    return (totalMomentum(fluid_particles) - initial_momentum).norm() / initial_momentum.norm();
+}
+
+TEST(test_LocalTimeStepping, test_TimeStepLevels)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.setIOEnvironment();
+    FluidBody fluid_cube(sph_system, makeShared<FluidCube>("FluidCube", DL));
+    generateFluidParticles(fluid_cube, rho0_f, c_f);
+    InnerRelation fluid_inner(fluid_cube);
+    ReduceDynamics<fluid_dynamics::LocalAcousticTimeStepSize> get_local_time_step_size(fluid_cube);
+    TimeStepLevels time_step_levels(fluid_inner);
+
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    BaseParticles &fluid_particles = fluid_cube.getBaseParticles();
+    setInitialCondition(fluid_particles);
+
+    Real min_time_step_size = get_local_time_step_size.exec();
+    Real coarse_time_step_size = time_step_levels.assignLevels(min_time_step_size, 1.0);
+    StdLargeVec<Real> &local_time_step_size = *fluid_particles.getVariableByName<Real>("LocalTimeStepSize");
+    int finest_level = time_step_levels.FinestLevel();
+    EXPECT_GT(finest_level, 0);
+    EXPECT_EQ(time_step_levels.NumberOfSubSteps(), size_t(1) << finest_level);
+    EXPECT_NEAR(coarse_time_step_size, std::ldexp(time_step_levels.TimeStepSize(finest_level), finest_level), Eps);
+    EXPECT_GT(coarse_time_step_size, min_time_step_size);
+    EXPECT_EQ(time_step_levels.NumberOfParticles(0), fluid_particles.total_real_particles_);
+
+    for (size_t i = 0; i != fluid_particles.total_real_particles_; ++i)
+    {
+        int level = time_step_levels.TimeStepLevel(i);
+        EXPECT_LE(time_step_levels.TimeStepSize(level), local_time_step_size[i] * (1.0 + Eps));
+        const Neighborhood &inner_neighborhood = fluid_inner.inner_configuration_[i];
+        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+            EXPECT_LE(std::abs(level - time_step_levels.TimeStepLevel(inner_neighborhood.j_[n])), 1);
+    }
+
+    size_t number_of_updates = 0;
+    for (size_t k = 0; k != time_step_levels.NumberOfSubSteps(); ++k)
+    {
+        time_step_levels.setSubStep(k);
+        number_of_updates += time_step_levels.NumberOfParticles(time_step_levels.ActiveLevel());
+    }
+    size_t number_of_global_updates = time_step_levels.NumberOfSubSteps() * fluid_particles.total_real_particles_;
+    EXPECT_LT(number_of_updates, number_of_global_updates);
+}
+
+TEST(test_LocalTimeStepping, test_MomentumConservation)
+{
+    Real conservative_change = momentumChangeInCoarseTimeStep<
+        fluid_dynamics::Integration1stHalfLocalTimeSteppingInnerRiemann,
+        fluid_dynamics::Integration2ndHalfLocalTimeSteppingInnerRiemann>();
+    Real naive_change = momentumChangeInCoarseTimeStep<
+        fluid_dynamics::Integration1stHalfInnerRiemann,
+        fluid_dynamics::Integration2ndHalfInnerRiemann>();
+    EXPECT_LT(conservative_change, 1.0e4 * Eps);
+    EXPECT_GT(naive_change, 1.0e3 * conservative_change);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
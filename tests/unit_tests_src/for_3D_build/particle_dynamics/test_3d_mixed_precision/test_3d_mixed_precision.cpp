@@ -0,0 +1,81 @@
+/**
+ * @file 	test_3d_mixed_precision.cpp
+ * @brief 	Test of the neighbor configuration in NeighborReal and the accumulation of summations.
+ * @details The kernel summation of a block of fluid from the inner configuration is compared
+ *          with that computed in Real from the kernel directly. When the library is built with
+ *          SPHINXSYS_USE_FLOAT_NEIGHBOR, the difference is bounded by the float precision.
+ *          When the library is built with SPHINXSYS_USE_FLOAT, the summation of many
+ *          small values is checked to be accumulated in double.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 20.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DL, DL));
+
+TEST(test_MixedPrecision, test_KernelSummation)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody fluid_cube(sph_system, makeShared<FluidCube>("FluidCube", DL));
+    generateFluidParticles(fluid_cube);
+    InnerRelation fluid_cube_inner(fluid_cube);
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+
+    BaseParticles &fluid_particles = fluid_cube.getBaseParticles();
+    Kernel &kernel = *fluid_cube.sph_adaptation_->getKernel();
+    Real tolerance = 10.0 * std::numeric_limits<NeighborReal>::epsilon();
+    for (size_t i = 0; i != fluid_particles.total_real_particles_; ++i)
+    {
+        const Neighborhood &inner_neighborhood = fluid_cube_inner.inner_configuration_[i];
+        Real sigma = kernel.W0(fluid_particles.pos_[i]);
+        Real sigma_reference = sigma;
+        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+        {
+            size_t index_j = inner_neighborhood.j_[n];
+            Vecd displacement = fluid_particles.pos_[i] - fluid_particles.pos_[index_j];
+            sigma += inner_neighborhood.W_ij_[n];
+            sigma_reference += kernel.W(displacement.norm(), displacement);
+            EXPECT_NEAR(inner_neighborhood.r_ij_[n], displacement.norm(), tolerance * resolution_ref);
+        }
+        EXPECT_NEAR(sigma, sigma_reference, tolerance * sigma_reference);
+    }
+}
+
+#if SPHINXSYS_USE_FLOAT
+TEST(test_MixedPrecision, test_SummationAccumulation)
+{
+    EXPECT_TRUE((std::is_same<AccumulationData<float>::type, double>::value));
+    EXPECT_TRUE((std::is_same<AccumulationData<Eigen::Vector3f>::type, Eigen::Vector3d>::value));
+    EXPECT_TRUE((std::is_same<AccumulationData<double>::type, double>::value));
+
+    size_t number_of_values = 10000000;
+    float value = 1.0e-3f;
+    ReduceSum<float> float_summation;
+    float sum = reduceParticles(execution::par, IndexRange(0, number_of_values), float_summation,
+                                [&](size_t i) -> float
+                                { return value; });
+    EXPECT_NEAR(sum, Real(number_of_values) * Real(value), 1.0e-6 * Real(number_of_values) * Real(value));
+
+    ReduceSum<Eigen::Vector3f> vector_summation;
+    Eigen::Vector3f vector_sum = reduceParticles(execution::seq, IndexRange(0, number_of_values), vector_summation,
+                                                 [&](size_t i) -> Eigen::Vector3f
+                                                 { return Eigen::Vector3f(value, 2.0f * value, 3.0f * value); });
+    EXPECT_NEAR(vector_sum[2], 3.0 * Real(number_of_values) * Real(value), 1.0e-6 * 3.0 * Real(number_of_values) * Real(value));
+}
+#else
+TEST(test_MixedPrecision, test_SummationAccumulation)
+{
+    EXPECT_TRUE((std::is_same<AccumulationData<Real>::type, Real>::value));
+    EXPECT_TRUE((std::is_same<AccumulationData<Vecd>::type, Vecd>::value));
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
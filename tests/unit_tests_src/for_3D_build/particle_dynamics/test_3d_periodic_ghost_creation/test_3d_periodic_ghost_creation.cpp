@@ -0,0 +1,74 @@
+/**
+ * @file 	test_3d_periodic_ghost_creation.cpp
+ * @brief 	Test of the parallel creation of periodic ghost particles.
+ * @details The ghost particles of a block of fluid periodic along x axis are created
+ *          and checked against a brute-force search of the particles near the bounds.
+ *          A repeated creation is checked to give the ghost particles in the same order.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 40.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DL, DL));
+
+TEST(test_PeriodicGhostCreation, test_GhostParticles)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody fluid_cube(sph_system, makeShared<FluidCube>("FluidCube", DL));
+    fluid_cube.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    Ghost<PeriodicAlongAxis> ghost_along_x(system_domain_bounds, xAxis);
+    fluid_cube.generateParticlesWithReserve<Lattice>(ghost_along_x);
+    PeriodicConditionUsingGhostParticles periodic_condition(fluid_cube, ghost_along_x);
+
+    fluid_cube.updateCellLinkedList();
+    periodic_condition.ghost_creation_.exec();
+
+    BaseParticles &particles = fluid_cube.getBaseParticles();
+    Real cut_off_radius = fluid_cube.sph_adaptation_->getKernel()->CutOffRadius();
+    size_t lower_ghosts = 0, upper_ghosts = 0;
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+    {
+        Real x = particles.pos_[i][xAxis];
+        if (x > 0.0 && x < cut_off_radius)
+            lower_ghosts++;
+        if (x < DL && x > DL - cut_off_radius)
+            upper_ghosts++;
+    }
+
+    ParticlesBound &lower_ghost_bound = ghost_along_x.LowerGhostBound();
+    ParticlesBound &upper_ghost_bound = ghost_along_x.UpperGhostBound();
+    ASSERT_EQ(lower_ghost_bound.second - lower_ghost_bound.first, lower_ghosts);
+    ASSERT_EQ(upper_ghost_bound.second - upper_ghost_bound.first, upper_ghosts);
+
+    Vecd periodic_translation = ghost_along_x.getPeriodicTranslation();
+    StdVec<size_t> ghost_origins;
+    for (size_t i = lower_ghost_bound.first; i != lower_ghost_bound.second; ++i)
+    {
+        size_t index_i = particles.sorted_id_[i];
+        EXPECT_EQ(particles.pos_[i], Vecd(particles.pos_[index_i] + periodic_translation));
+        ghost_origins.push_back(index_i);
+    }
+    for (size_t i = upper_ghost_bound.first; i != upper_ghost_bound.second; ++i)
+    {
+        size_t index_i = particles.sorted_id_[i];
+        EXPECT_EQ(particles.pos_[i], Vecd(particles.pos_[index_i] - periodic_translation));
+        ghost_origins.push_back(index_i);
+    }
+
+    periodic_condition.ghost_creation_.exec();
+    StdVec<size_t> repeated_ghost_origins;
+    for (size_t i = lower_ghost_bound.first; i != lower_ghost_bound.second; ++i)
+        repeated_ghost_origins.push_back(particles.sorted_id_[i]);
+    for (size_t i = upper_ghost_bound.first; i != upper_ghost_bound.second; ++i)
+        repeated_ghost_origins.push_back(particles.sorted_id_[i]);
+    EXPECT_EQ(ghost_origins, repeated_ghost_origins);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,156 @@
+/**
+ * @file 	test_3d_symmetric_interaction.cpp
+ * @brief 	Test of the symmetric interactions evaluating each particle pair once.
+ * @details A block of fluid with random density and velocity perturbations is computed
+ *          with the full and the half (symmetric) neighbor lists. The forces and density
+ *          change rates are checked to be identical, also for the half lists iterated
+ *          by the split cell lists from the contiguous cell lists. The half lists are timed in the benchmarks.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 30.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DL, DL));
+Real rho0_f = 1.0;
+Real c_f = 10.0;
+Real mu_f = 0.01;
+
+template <typename DataType>
+Real relativeDifference(StdLargeVec<DataType> &data, StdLargeVec<DataType> &reference, size_t size)
+{
+    Real difference = 0.0;
+    Real magnitude = TinyReal;
+    for (size_t i = 0; i != size; ++i)
+    {
+        difference = SMAX(difference, Real((data[i] - reference[i]).norm()));
+        magnitude = SMAX(magnitude, Real(reference[i].norm()));
+    }
+    return difference / magnitude;
+}
+
+Real relativeDifference(StdLargeVec<Real> &data, StdLargeVec<Real> &reference, size_t size)
+{
+    Real difference = 0.0;
+    Real magnitude = TinyReal;
+    for (size_t i = 0; i != size; ++i)
+    {
+        difference = SMAX(difference, ABS(data[i] - reference[i]));
+        magnitude = SMAX(magnitude, ABS(reference[i]));
+    }
+    return difference / magnitude;
+}
+
+TEST(test_SymmetricInteraction, test_FluidIntegration)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody full_cube(sph_system, makeShared<FluidCube>("FullCube", DL));
+    generateFluidParticles(full_cube, rho0_f, c_f, mu_f);
+    FluidBody half_cube(sph_system, makeShared<FluidCube>("HalfCube", DL));
+    generateFluidParticles(half_cube, rho0_f, c_f, mu_f);
+
+    InnerRelation full_cube_inner(full_cube);
+    SymmetricInnerRelation half_cube_inner(half_cube);
+
+    Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann> full_pressure_relaxation(full_cube_inner);
+    Dynamics1Level<fluid_dynamics::Integration2ndHalfInnerRiemann> full_density_relaxation(full_cube_inner);
+    InteractionWithUpdate<fluid_dynamics::ViscousForceInner> full_viscous_force(full_cube_inner);
+    InteractionSymmetric<fluid_dynamics::Integration1stHalfSymmetricInnerRiemann> half_pressure_relaxation(half_cube_inner);
+    InteractionSymmetric<fluid_dynamics::Integration2ndHalfSymmetricInnerRiemann> half_density_relaxation(half_cube_inner);
+    InteractionSymmetric<fluid_dynamics::ViscousForceSymmetricInner> half_viscous_force(half_cube_inner);
+
+    BaseParticles &full_particles = full_cube.getBaseParticles();
+    BaseParticles &half_particles = half_cube.getBaseParticles();
+    size_t total_real_particles = full_particles.total_real_particles_;
+    std::mt19937 random_engine(1);
+    std::uniform_real_distribution<Real> uniform(-1.0, 1.0);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        Real rho = rho0_f * (1.0 + 0.01 * uniform(random_engine));
+        Vecd vel = 0.1 * c_f * Vecd(uniform(random_engine), uniform(random_engine), uniform(random_engine));
+        full_particles.rho_[i] = half_particles.rho_[i] = rho;
+        full_particles.vel_[i] = half_particles.vel_[i] = vel;
+    }
+
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+
+    StdLargeVec<Real> &full_drho_dt = *full_particles.getVariableByName<Real>("DensityChangeRate");
+    StdLargeVec<Real> &half_drho_dt = *half_particles.getVariableByName<Real>("DensityChangeRate");
+    StdLargeVec<Vecd> &full_viscous = *full_particles.getVariableByName<Vecd>("ViscousForce");
+    StdLargeVec<Vecd> &half_viscous = *half_particles.getVariableByName<Vecd>("ViscousForce");
+    Real tolerance = 1.0e-10;
+
+    full_density_relaxation.exec();
+    half_density_relaxation.exec();
+    EXPECT_LT(relativeDifference(half_particles.force_, full_particles.force_, total_real_particles), tolerance);
+    EXPECT_LT(relativeDifference(half_drho_dt, full_drho_dt, total_real_particles), tolerance);
+
+    full_pressure_relaxation.exec();
+    half_pressure_relaxation.exec();
+    EXPECT_LT(relativeDifference(half_particles.force_, full_particles.force_, total_real_particles), tolerance);
+    EXPECT_LT(relativeDifference(half_drho_dt, full_drho_dt, total_real_particles), tolerance);
+
+    full_viscous_force.exec();
+    half_viscous_force.exec();
+    EXPECT_LT(relativeDifference(half_viscous, full_viscous, total_real_particles), tolerance);
+}
+
+TEST(test_SymmetricInteraction, test_ContiguousCellLists)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody full_cube(sph_system, makeShared<FluidCube>("FullCube", DL));
+    generateFluidParticles(full_cube, rho0_f, c_f, mu_f);
+    FluidBody half_cube(sph_system, makeShared<FluidCube>("HalfCube", DL));
+    generateFluidParticles(half_cube, rho0_f, c_f, mu_f);
+    half_cube.getCellLinkedList().useContiguousCellLists();
+
+    InnerRelation full_cube_inner(full_cube);
+    SymmetricInnerRelation half_cube_inner(half_cube);
+
+    Dynamics1Level<fluid_dynamics::Integration2ndHalfInnerRiemann> full_density_relaxation(full_cube_inner);
+    InteractionWithUpdate<fluid_dynamics::ViscousForceInner> full_viscous_force(full_cube_inner);
+    InteractionSymmetric<fluid_dynamics::Integration2ndHalfSymmetricInnerRiemann> half_density_relaxation(half_cube_inner);
+    InteractionSymmetric<fluid_dynamics::ViscousForceSymmetricInner> half_viscous_force(half_cube_inner);
+
+    BaseParticles &full_particles = full_cube.getBaseParticles();
+    BaseParticles &half_particles = half_cube.getBaseParticles();
+    size_t total_real_particles = full_particles.total_real_particles_;
+    std::mt19937 random_engine(1);
+    std::uniform_real_distribution<Real> uniform(-1.0, 1.0);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        Real rho = rho0_f * (1.0 + 0.01 * uniform(random_engine));
+        Vecd vel = 0.1 * c_f * Vecd(uniform(random_engine), uniform(random_engine), uniform(random_engine));
+        full_particles.rho_[i] = half_particles.rho_[i] = rho;
+        full_particles.vel_[i] = half_particles.vel_[i] = vel;
+    }
+
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    EXPECT_TRUE(half_cube.getContiguousSplitCellLists().is_built_);
+
+    StdLargeVec<Real> &full_drho_dt = *full_particles.getVariableByName<Real>("DensityChangeRate");
+    StdLargeVec<Real> &half_drho_dt = *half_particles.getVariableByName<Real>("DensityChangeRate");
+    StdLargeVec<Vecd> &full_viscous = *full_particles.getVariableByName<Vecd>("ViscousForce");
+    StdLargeVec<Vecd> &half_viscous = *half_particles.getVariableByName<Vecd>("ViscousForce");
+    Real tolerance = 1.0e-10;
+
+    full_density_relaxation.exec();
+    half_density_relaxation.exec();
+    EXPECT_LT(relativeDifference(half_particles.force_, full_particles.force_, total_real_particles), tolerance);
+    EXPECT_LT(relativeDifference(half_drho_dt, full_drho_dt, total_real_particles), tolerance);
+
+    full_viscous_force.exec();
+    half_viscous_force.exec();
+    EXPECT_LT(relativeDifference(half_viscous, full_viscous, total_real_particles), tolerance);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,146 @@
+/**
+ * @file 	test_3d_unsequenced_policy.cpp
+ * @brief 	Test of the unsequenced execution policies.
+ * @details Loops and reductions free of virtual calls, for which the SIMD loops are safe,
+ *          are carried out with all execution policies over particle ranges and body part particles.
+ *          The unsequenced policies are checked to give the results of the sequenced policy.
+ *          The gravity and the fluid integration of a block of fluid are checked to give
+ *          the same results with the parallel and the parallel unsequenced policies.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+size_t number_of_particles = 10000;
+
+template <class ExecutionPolicy, class ParticleRange>
+StdLargeVec<Vecd> scaledPositions(const ExecutionPolicy &execution_policy, const ParticleRange &particle_range,
+                                  StdLargeVec<Vecd> &pos, Real scale)
+{
+    StdLargeVec<Vecd> scaled_pos(pos.size(), Vecd::Zero());
+    particle_for(execution_policy, particle_range,
+                 [&](size_t i)
+                 { scaled_pos[i] = scale * pos[i] + Vecd::Ones(); });
+    return scaled_pos;
+}
+
+template <class ExecutionPolicy, class ParticleRange>
+Real maximumNorm(const ExecutionPolicy &execution_policy, const ParticleRange &particle_range,
+                 StdLargeVec<Vecd> &pos)
+{
+    return particle_reduce(execution_policy, particle_range, Real(0), ReduceMax(),
+                           [&](size_t i) -> Real
+                           { return pos[i].norm(); });
+}
+
+template <class ExecutionPolicy, class ParticleRange>
+Real numberInUnitBall(const ExecutionPolicy &execution_policy, const ParticleRange &particle_range,
+                      StdLargeVec<Vecd> &pos)
+{
+    return particle_reduce(execution_policy, particle_range, Real(0), ReduceSum<Real>(),
+                           [&](size_t i) -> Real
+                           { return pos[i].squaredNorm() < 1.0 ? 1.0 : 0.0; });
+}
+
+StdLargeVec<Vecd> randomPositions()
+{
+    StdLargeVec<Vecd> pos(number_of_particles);
+    for (size_t i = 0; i != number_of_particles; ++i)
+        pos[i] = Vecd::Random();
+    return pos;
+}
+
+TEST(test_UnsequencedPolicy, test_ParticleRange)
+{
+    StdLargeVec<Vecd> pos = randomPositions();
+    IndexRange particle_range(0, number_of_particles);
+
+    StdLargeVec<Vecd> reference = scaledPositions(SequencedPolicy(), particle_range, pos, 2.0);
+    EXPECT_EQ(scaledPositions(UnsequencedPolicy(), particle_range, pos, 2.0), reference);
+    EXPECT_EQ(scaledPositions(ParallelUnsequencedPolicy(), particle_range, pos, 2.0), reference);
+
+    Real maximum_norm = maximumNorm(SequencedPolicy(), particle_range, pos);
+    EXPECT_EQ(maximumNorm(UnsequencedPolicy(), particle_range, pos), maximum_norm);
+    EXPECT_EQ(maximumNorm(ParallelUnsequencedPolicy(), particle_range, pos), maximum_norm);
+
+    Real number_in_ball = numberInUnitBall(SequencedPolicy(), particle_range, pos);
+    EXPECT_EQ(numberInUnitBall(UnsequencedPolicy(), particle_range, pos), number_in_ball);
+    EXPECT_EQ(numberInUnitBall(ParallelUnsequencedPolicy(), particle_range, pos), number_in_ball);
+}
+
+TEST(test_UnsequencedPolicy, test_BodyPartParticles)
+{
+    StdLargeVec<Vecd> pos = randomPositions();
+    IndexVector body_part_particles;
+    for (size_t i = 0; i < number_of_particles; i += 3)
+        body_part_particles.push_back(i);
+
+    StdLargeVec<Vecd> reference = scaledPositions(SequencedPolicy(), body_part_particles, pos, 2.0);
+    EXPECT_EQ(scaledPositions(UnsequencedPolicy(), body_part_particles, pos, 2.0), reference);
+    EXPECT_EQ(scaledPositions(ParallelUnsequencedPolicy(), body_part_particles, pos, 2.0), reference);
+
+    Real maximum_norm = maximumNorm(SequencedPolicy(), body_part_particles, pos);
+    EXPECT_EQ(maximumNorm(UnsequencedPolicy(), body_part_particles, pos), maximum_norm);
+    EXPECT_EQ(maximumNorm(ParallelUnsequencedPolicy(), body_part_particles, pos), maximum_norm);
+
+    Real number_in_ball = numberInUnitBall(SequencedPolicy(), body_part_particles, pos);
+    EXPECT_EQ(numberInUnitBall(UnsequencedPolicy(), body_part_particles, pos), number_in_ball);
+    EXPECT_EQ(numberInUnitBall(ParallelUnsequencedPolicy(), body_part_particles, pos), number_in_ball);
+}
+
+TEST(test_UnsequencedPolicy, test_FluidIntegration)
+{
+    Real DL = 1.0;
+    SPHSystem sph_system(BoundingBox(Vec3d::Zero(), Vec3d(DL, DL, DL)), DL / 20.0);
+    FluidBody parallel_cube(sph_system, makeShared<FluidCube>("ParallelCube", DL));
+    generateFluidParticles(parallel_cube);
+    FluidBody unsequenced_cube(sph_system, makeShared<FluidCube>("UnsequencedCube", DL));
+    generateFluidParticles(unsequenced_cube);
+    InnerRelation parallel_inner(parallel_cube);
+    InnerRelation unsequenced_inner(unsequenced_cube);
+
+    Gravity gravity(Vec3d(0.0, -1.0, 0.0));
+    SimpleDynamics<GravityForce> parallel_gravity(parallel_cube, gravity);
+    Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann> parallel_pressure_relaxation(parallel_inner);
+    Dynamics1Level<fluid_dynamics::Integration2ndHalfInnerRiemann> parallel_density_relaxation(parallel_inner);
+    SimpleDynamics<GravityForce, ParallelUnsequencedPolicy> unsequenced_gravity(unsequenced_cube, gravity);
+    Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann, ParallelUnsequencedPolicy>
+        unsequenced_pressure_relaxation(unsequenced_inner);
+    Dynamics1Level<fluid_dynamics::Integration2ndHalfInnerRiemann, ParallelUnsequencedPolicy>
+        unsequenced_density_relaxation(unsequenced_inner);
+
+    BaseParticles &parallel_particles = parallel_cube.getBaseParticles();
+    BaseParticles &unsequenced_particles = unsequenced_cube.getBaseParticles();
+    for (size_t i = 0; i != parallel_particles.total_real_particles_; ++i)
+    {
+        parallel_particles.rho_[i] = unsequenced_particles.rho_[i] = 1.0 + 0.01 * sin(Real(i));
+    }
+
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    parallel_gravity.exec();
+    unsequenced_gravity.exec();
+    Real dt = 0.1 * DL / 20.0;
+    for (size_t step = 0; step != 5; ++step)
+    {
+        parallel_pressure_relaxation.exec(dt);
+        parallel_density_relaxation.exec(dt);
+        unsequenced_pressure_relaxation.exec(dt);
+        unsequenced_density_relaxation.exec(dt);
+    }
+
+    for (size_t i = 0; i != parallel_particles.total_real_particles_; ++i)
+    {
+        EXPECT_LT((unsequenced_particles.force_prior_[i] - parallel_particles.force_prior_[i]).norm(), 1.0e-12);
+        EXPECT_LT((unsequenced_particles.pos_[i] - parallel_particles.pos_[i]).norm(), 1.0e-12);
+        EXPECT_LT((unsequenced_particles.vel_[i] - parallel_particles.vel_[i]).norm(), 1.0e-12);
+        EXPECT_NEAR(unsequenced_particles.rho_[i], parallel_particles.rho_[i], 1.0e-12);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
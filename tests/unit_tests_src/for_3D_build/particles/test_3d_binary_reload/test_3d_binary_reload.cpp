@@ -0,0 +1,100 @@
+/**
+ * @file 	test_3d_binary_reload.cpp
+ * @brief 	Test of the binary particle reload files.
+ * @details The particles of a perturbed block of fluid are written to XML and binary
+ *          reload files and reloaded by two other bodies. The reloaded particles are
+ *          checked. The binary file is also read
+ *          into an existing body, and rewriting in the other format is checked to leave
+ *          only the newly written file.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 40.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DL, DL));
+
+void reloadParticles(FluidBody &body, const std::string &reload_body_name)
+{
+    body.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    body.generateParticles<Reload>(reload_body_name);
+}
+
+void checkParticles(BaseParticles &particles, BaseParticles &reference, Real tolerance)
+{
+    ASSERT_EQ(particles.total_real_particles_, reference.total_real_particles_);
+    for (size_t i = 0; i != reference.total_real_particles_; ++i)
+    {
+        EXPECT_LE((particles.pos_[i] - reference.pos_[i]).norm(), tolerance);
+        EXPECT_LE(ABS(particles.Vol_[i] - reference.Vol_[i]), tolerance);
+        EXPECT_EQ(particles.unsorted_id_[i], i);
+    }
+}
+
+TEST(test_BinaryReload, test_WritingAndReloading)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.setIOEnvironment();
+    FluidBody relaxed_cube(sph_system, makeShared<FluidCube>("RelaxedCube", DL));
+    generateFluidParticles(relaxed_cube);
+    BaseParticles &relaxed_particles = relaxed_cube.getBaseParticles();
+    std::mt19937 random_engine(1);
+    std::uniform_real_distribution<Real> uniform(-1.0, 1.0);
+    for (size_t i = 0; i != relaxed_particles.total_real_particles_; ++i)
+    {
+        relaxed_particles.pos_[i] += 0.1 * resolution_ref * Vecd(uniform(random_engine), uniform(random_engine), uniform(random_engine));
+        relaxed_particles.Vol_[i] *= 1.0 + 0.1 * uniform(random_engine);
+    }
+
+    ReloadParticleIO xml_reload_io(relaxed_cube, "XmlCube");
+    xml_reload_io.writeToFile();
+    ReloadParticleIO binary_reload_io(relaxed_cube, "BinaryCube");
+    binary_reload_io.useBinaryFormat();
+    binary_reload_io.writeToFile();
+
+    FluidBody xml_cube(sph_system, makeShared<FluidCube>("XmlCube", DL));
+    reloadParticles(xml_cube, "XmlCube");
+    FluidBody binary_cube(sph_system, makeShared<FluidCube>("BinaryCube", DL));
+    reloadParticles(binary_cube, "BinaryCube");
+
+    checkParticles(xml_cube.getBaseParticles(), relaxed_particles, 1.0e-6);
+    checkParticles(binary_cube.getBaseParticles(), relaxed_particles, 0.0);
+}
+
+TEST(test_BinaryReload, test_ReadingAndRewriting)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    sph_system.setIOEnvironment();
+    FluidBody relaxed_cube(sph_system, makeShared<FluidCube>("RelaxedCube", DL));
+    generateFluidParticles(relaxed_cube);
+    BaseParticles &relaxed_particles = relaxed_cube.getBaseParticles();
+    for (size_t i = 0; i != relaxed_particles.total_real_particles_; ++i)
+    {
+        relaxed_particles.pos_[i] += 0.1 * resolution_ref * Vecd::Ones();
+    }
+
+    ReloadParticleIO reload_io(relaxed_cube, "RewrittenCube");
+    reload_io.useBinaryFormat();
+    reload_io.writeToFile();
+    FluidBody lattice_cube(sph_system, makeShared<FluidCube>("LatticeCube", DL));
+    generateFluidParticles(lattice_cube);
+    ReloadParticleIO(lattice_cube, "RewrittenCube").readFromFile();
+    checkParticles(lattice_cube.getBaseParticles(), relaxed_particles, 0.0);
+
+    std::string filefullpath = sph_system.getIOEnvironment().reload_folder_ + "/RewrittenCube_rld";
+    ReloadParticleIO(relaxed_cube, "RewrittenCube").writeToFile();
+    EXPECT_TRUE(fs::exists(filefullpath + ".xml"));
+    EXPECT_FALSE(fs::exists(filefullpath + ".bin"));
+    reload_io.writeToFile();
+    EXPECT_TRUE(fs::exists(filefullpath + ".bin"));
+    EXPECT_FALSE(fs::exists(filefullpath + ".xml"));
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+/**
+ * @file 	test_3d_binary_restart.cpp
+ * @brief 	Test of the binary restart files.
+ * @details The states of a block of fluid are written to XML and binary restart files
+ *          and read back after being reset. The restored states are checked
+ *          and a corrupted binary file is checked to be rejected.
+ *          Rewriting a step in the other format is checked to leave only the newly written file.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 40.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DL, DL));
+
+class BinaryRestartTest : public testing::Test
+{
+  protected:
+    SPHSystem sph_system_{system_domain_bounds, resolution_ref};
+    FluidBody fluid_cube_{sph_system_, makeShared<FluidCube>("FluidCube", DL)};
+    StdLargeVec<Vecd> pos_, vel_;
+    StdLargeVec<Real> Vol_;
+
+    void SetUp() override
+    {
+        sph_system_.setIOEnvironment();
+        generateFluidParticles(fluid_cube_);
+
+        BaseParticles &particles = fluid_cube_.getBaseParticles();
+        std::mt19937 random_engine(1);
+        std::uniform_real_distribution<Real> uniform(-1.0, 1.0);
+        for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        {
+            particles.pos_[i] += 0.1 * resolution_ref * Vecd(uniform(random_engine), uniform(random_engine), uniform(random_engine));
+            particles.vel_[i] = Vecd(uniform(random_engine), uniform(random_engine), uniform(random_engine));
+            particles.Vol_[i] *= 1.0 + 0.1 * uniform(random_engine);
+        }
+        pos_ = particles.pos_;
+        vel_ = particles.vel_;
+        Vol_ = particles.Vol_;
+    };
+
+    void resetStates()
+    {
+        BaseParticles &particles = fluid_cube_.getBaseParticles();
+        std::fill(particles.pos_.begin(), particles.pos_.end(), Vecd::Zero());
+        std::fill(particles.vel_.begin(), particles.vel_.end(), Vecd::Zero());
+        std::fill(particles.Vol_.begin(), particles.Vol_.end(), 0.0);
+    };
+
+    void checkStates(Real tolerance)
+    {
+        BaseParticles &particles = fluid_cube_.getBaseParticles();
+        for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        {
+            EXPECT_LE((particles.pos_[i] - pos_[i]).norm(), tolerance);
+            EXPECT_LE((particles.vel_[i] - vel_[i]).norm(), tolerance);
+            EXPECT_LE(ABS(particles.Vol_[i] - Vol_[i]), tolerance);
+        }
+    };
+};
+
+TEST_F(BinaryRestartTest, test_WritingAndReading)
+{
+    RestartIO xml_restart_io({&fluid_cube_});
+    RestartIO binary_restart_io({&fluid_cube_}, true);
+
+    xml_restart_io.writeToFile(1);
+    resetStates();
+    xml_restart_io.readRestartFiles(1);
+    checkStates(1.0e-6);
+
+    binary_restart_io.writeToFile(2);
+    resetStates();
+    binary_restart_io.readRestartFiles(2);
+    checkStates(0.0);
+}
+
+TEST_F(BinaryRestartTest, test_CorruptedFile)
+{
+    testing::FLAGS_gtest_death_test_style = "threadsafe";
+    RestartIO binary_restart_io({&fluid_cube_}, true);
+    binary_restart_io.writeToFile(3);
+
+    std::string filefullpath = sph_system_.getIOEnvironment().restart_folder_ + "/FluidCube_rst_0000000003.bin";
+    std::fstream restart_file(filefullpath.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    restart_file.seekg(-1, std::ios::end);
+    char last_byte = restart_file.get();
+    restart_file.seekp(-1, std::ios::end);
+    restart_file.put(~last_byte);
+    restart_file.close();
+
+    // the error message is written to the standard output, so only the exit code is checked
+    EXPECT_EXIT(binary_restart_io.readRestartFiles(3), testing::ExitedWithCode(1), "");
+}
+
+TEST_F(BinaryRestartTest, test_RewritingInOtherFormat)
+{
+    RestartIO xml_restart_io({&fluid_cube_});
+    RestartIO binary_restart_io({&fluid_cube_}, true);
+    std::string filefullpath = sph_system_.getIOEnvironment().restart_folder_ + "/FluidCube_rst_0000000004";
+
+    xml_restart_io.writeToFile(4);
+    binary_restart_io.writeToFile(4);
+    EXPECT_TRUE(fs::exists(filefullpath + ".bin"));
+    EXPECT_FALSE(fs::exists(filefullpath + ".xml"));
+
+    // the states written later in XML format are the ones to be restarted from
+    BaseParticles &particles = fluid_cube_.getBaseParticles();
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+    {
+        vel_[i] = -vel_[i];
+        particles.vel_[i] = vel_[i];
+    }
+    xml_restart_io.writeToFile(4);
+    EXPECT_TRUE(fs::exists(filefullpath + ".xml"));
+    EXPECT_FALSE(fs::exists(filefullpath + ".bin"));
+
+    resetStates();
+    binary_restart_io.readRestartFiles(4);
+    checkStates(1.0e-6);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
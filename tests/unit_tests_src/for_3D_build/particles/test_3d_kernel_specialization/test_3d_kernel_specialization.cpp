@@ -0,0 +1,160 @@
+/**
+ * @file 	test_3d_kernel_specialization.cpp
+ * @brief 	Test of the neighbor search with the kernel functions called through the concrete kernel type.
+ * @details For each kernel type with a specialized neighbor search, the inner and contact configurations
+ *          of a fluid block built with the specialized and the virtual kernel functions are checked to be the same,
+ *          also when the configuration is stored in a packed neighbor storage.
+ *          The same is checked for the adaptive inner and contact relations of a refined fluid block.
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 0.5;
+Real resolution_ref = DL / 20.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DL, DL));
+
+class FluidBlock : public ComplexShape
+{
+  public:
+    explicit FluidBlock(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        Vecd halfsize(0.5 * DL, 0.5 * DL, 0.5 * DL);
+        add<TransformShape<GeometricShapeBox>>(Transform(halfsize), halfsize);
+    }
+};
+
+class WallBlock : public ComplexShape
+{
+  public:
+    explicit WallBlock(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        Vecd halfsize(0.5 * DL, 0.1 * DL, 0.5 * DL);
+        add<TransformShape<GeometricShapeBox>>(Transform(Vecd(0.5 * DL, 0.9 * DL, 0.5 * DL)), halfsize);
+    }
+};
+
+void checkSameConfiguration(ParticleConfiguration &specialized_configuration,
+                            ParticleConfiguration &configuration, size_t total_particles)
+{
+    for (size_t i = 0; i != total_particles; ++i)
+    {
+        Neighborhood &neighborhood = configuration[i];
+        Neighborhood &specialized_neighborhood = specialized_configuration[i];
+        ASSERT_EQ(specialized_neighborhood.current_size_, neighborhood.current_size_);
+        for (size_t n = 0; n != neighborhood.current_size_; ++n)
+        {
+            EXPECT_EQ(specialized_neighborhood.j_[n], neighborhood.j_[n]);
+            EXPECT_DOUBLE_EQ(specialized_neighborhood.W_ij_[n], neighborhood.W_ij_[n]);
+            EXPECT_DOUBLE_EQ(specialized_neighborhood.dW_ijV_j_[n], neighborhood.dW_ijV_j_[n]);
+            EXPECT_DOUBLE_EQ(specialized_neighborhood.r_ij_[n], neighborhood.r_ij_[n]);
+            EXPECT_EQ(specialized_neighborhood.e_ij_[n], neighborhood.e_ij_[n]);
+        }
+    }
+}
+
+template <class KernelType, typename... Args>
+void checkSpecializedConfiguration(Args... args)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody fluid_block(sph_system, makeShared<FluidBlock>("FluidBlock"));
+    fluid_block.sph_adaptation_->resetKernel<KernelType>(args...);
+    fluid_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    fluid_block.generateParticles<Lattice>();
+
+    SolidBody wall_block(sph_system, makeShared<WallBlock>("WallBlock"));
+    wall_block.sph_adaptation_->resetKernel<KernelType>(args...);
+    wall_block.defineParticlesAndMaterial<SolidParticles, Solid>();
+    wall_block.generateParticles<Lattice>();
+
+    InnerRelation virtual_kernel_inner(fluid_block);
+    virtual_kernel_inner.specializeKernel(false);
+    InnerRelation specialized_kernel_inner(fluid_block);
+    InnerRelation packed_specialized_kernel_inner(fluid_block);
+    packed_specialized_kernel_inner.usePackedNeighborStorage();
+    ContactRelation virtual_kernel_contact(fluid_block, {&wall_block});
+    virtual_kernel_contact.specializeKernel(false);
+    ContactRelation specialized_kernel_contact(fluid_block, {&wall_block});
+    ContactRelation packed_specialized_kernel_contact(fluid_block, {&wall_block});
+    packed_specialized_kernel_contact.usePackedNeighborStorage();
+
+    fluid_block.updateCellLinkedList();
+    wall_block.updateCellLinkedList();
+    StdVec<BaseInnerRelation *> inner_relations = {&virtual_kernel_inner, &specialized_kernel_inner,
+                                                   &packed_specialized_kernel_inner};
+    StdVec<BaseContactRelation *> contact_relations = {&virtual_kernel_contact, &specialized_kernel_contact,
+                                                       &packed_specialized_kernel_contact};
+    for (size_t k = 0; k != inner_relations.size(); ++k)
+    {
+        inner_relations[k]->updateConfiguration();
+        contact_relations[k]->updateConfiguration();
+    }
+
+    size_t total_particles = fluid_block.getBaseParticles().total_real_particles_;
+    size_t total_contact_neighbors = 0;
+    for (size_t i = 0; i != total_particles; ++i)
+        total_contact_neighbors += virtual_kernel_contact.contact_configuration_[0][i].current_size_;
+    ASSERT_GT(total_contact_neighbors, 0u);
+    for (size_t k = 1; k != inner_relations.size(); ++k)
+    {
+        checkSameConfiguration(inner_relations[k]->inner_configuration_,
+                               virtual_kernel_inner.inner_configuration_, total_particles);
+        checkSameConfiguration(contact_relations[k]->contact_configuration_[0],
+                               virtual_kernel_contact.contact_configuration_[0], total_particles);
+    }
+}
+
+TEST(test_KernelSpecialization, test_WendlandC2)
+{
+    checkSpecializedConfiguration<KernelWendlandC2>();
+}
+
+TEST(test_KernelSpecialization, test_CubicBSpline)
+{
+    checkSpecializedConfiguration<KernelCubicBSpline>();
+}
+
+TEST(test_KernelSpecialization, test_TabulatedWendlandC2)
+{
+    checkSpecializedConfiguration<KernelTabulated<KernelWendlandC2>>(1000);
+}
+
+TEST(test_KernelSpecialization, test_AdaptiveRelations)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody fluid_block(sph_system, makeShared<FluidBlock>("FluidBlock"));
+    fluid_block.defineAdaptation<ParticleRefinementNearSurface>(1.15, 1.0, 2);
+    fluid_block.defineBodyLevelSetShape();
+    fluid_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    fluid_block.generateParticles<Lattice, Adaptive>();
+    SolidBody wall_block(sph_system, makeShared<WallBlock>("WallBlock"));
+    wall_block.defineParticlesAndMaterial<SolidParticles, Solid>();
+    wall_block.generateParticles<Lattice>();
+
+    AdaptiveInnerRelation virtual_kernel_inner(fluid_block);
+    virtual_kernel_inner.specializeKernel(false);
+    AdaptiveInnerRelation specialized_kernel_inner(fluid_block);
+    AdaptiveContactRelation virtual_kernel_contact(fluid_block, {&wall_block});
+    virtual_kernel_contact.specializeKernel(false);
+    AdaptiveContactRelation specialized_kernel_contact(fluid_block, {&wall_block});
+
+    fluid_block.updateCellLinkedList();
+    wall_block.updateCellLinkedList();
+    virtual_kernel_inner.updateConfiguration();
+    specialized_kernel_inner.updateConfiguration();
+    virtual_kernel_contact.updateConfiguration();
+    specialized_kernel_contact.updateConfiguration();
+
+    size_t total_particles = fluid_block.getBaseParticles().total_real_particles_;
+    checkSameConfiguration(specialized_kernel_inner.inner_configuration_,
+                           virtual_kernel_inner.inner_configuration_, total_particles);
+    checkSameConfiguration(specialized_kernel_contact.contact_configuration_[0],
+                           virtual_kernel_contact.contact_configuration_[0], total_particles);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,88 @@
+/**
+ * @file 	test_3d_particle_buffer_switching.cpp
+ * @brief 	Test of the batched switching between real and buffer particles.
+ * @details Randomly chosen particles of two identical bodies are switched to buffer particles
+ *          one by one and in a batch. The remaining real particles are checked to be the same
+ *          and the sorted and unsorted ids to be consistent. Then buffer particles are realized
+ *          as copies of real particles in a batch. The switching is timed in the benchmarks.
+ */
+#include "fluid_cube.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real resolution_ref = DL / 50.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(DL, DL, DL));
+
+void checkIdConsistency(BaseParticles &particles)
+{
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+    {
+        ASSERT_EQ(particles.sorted_id_[particles.unsorted_id_[i]], i);
+    }
+}
+
+TEST(test_ParticleBufferSwitching, test_SwitchToBufferAndBack)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody sequential_cube(sph_system, makeShared<FluidCube>("SequentialCube", DL));
+    sequential_cube.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    ParticleBuffer<ReserveSizeFactor> sequential_buffer(0.5);
+    sequential_cube.generateParticlesWithReserve<Lattice>(sequential_buffer);
+
+    FluidBody batched_cube(sph_system, makeShared<FluidCube>("BatchedCube", DL));
+    batched_cube.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    ParticleBuffer<ReserveSizeFactor> batched_buffer(0.5);
+    batched_cube.generateParticlesWithReserve<Lattice>(batched_buffer);
+
+    BaseParticles &sequential_particles = sequential_cube.getBaseParticles();
+    BaseParticles &batched_particles = batched_cube.getBaseParticles();
+    size_t total_real_particles = batched_particles.total_real_particles_;
+
+    std::mt19937 random_engine(1);
+    StdLargeVec<size_t> deleted_particles;
+    for (size_t i = 0; i != total_real_particles; ++i)
+        if (random_engine() % 10 < 3)
+            deleted_particles.push_back(i);
+    std::shuffle(deleted_particles.begin(), deleted_particles.end(), random_engine);
+    size_t number_of_deleted = deleted_particles.size();
+
+    // the particles are deleted by unsorted ids as the indices change after each switching
+    for (size_t n = 0; n != number_of_deleted; ++n)
+        sequential_particles.switchToBufferParticle(sequential_particles.sorted_id_[deleted_particles[n]]);
+    batched_particles.switchToBufferParticles(deleted_particles, number_of_deleted);
+
+    ASSERT_EQ(batched_particles.total_real_particles_, total_real_particles - number_of_deleted);
+    ASSERT_EQ(sequential_particles.total_real_particles_, batched_particles.total_real_particles_);
+    checkIdConsistency(batched_particles);
+    std::set<size_t> sequential_ids, batched_ids;
+    for (size_t i = 0; i != batched_particles.total_real_particles_; ++i)
+    {
+        sequential_ids.insert(sequential_particles.unsorted_id_[i]);
+        batched_ids.insert(batched_particles.unsorted_id_[i]);
+        size_t unsorted_id = batched_particles.unsorted_id_[i];
+        EXPECT_EQ(batched_particles.pos_[i], sequential_particles.pos_[sequential_particles.sorted_id_[unsorted_id]]);
+    }
+    EXPECT_EQ(sequential_ids, batched_ids);
+
+    size_t number_of_created = batched_particles.real_particles_bound_ - batched_particles.total_real_particles_;
+    StdLargeVec<size_t> source_particles(number_of_created);
+    for (size_t n = 0; n != number_of_created; ++n)
+        source_particles[n] = n % batched_particles.total_real_particles_;
+    size_t first_created = batched_particles.total_real_particles_;
+    batched_particles.createRealParticlesFrom(source_particles, number_of_created);
+    ASSERT_EQ(batched_particles.total_real_particles_, batched_particles.real_particles_bound_);
+    checkIdConsistency(batched_particles);
+    for (size_t n = 0; n != number_of_created; ++n)
+    {
+        EXPECT_EQ(batched_particles.pos_[first_created + n], batched_particles.pos_[source_particles[n]]);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,84 @@
+/**
+ * @file 	test_3d_particle_sorting.cpp
+ * @brief 	Test of the particle sorting methods.
+ * @details Two bodies with identical randomly ordered particles are sorted
+ *          by the quick sort and the radix sort respectively.
+ *          The results are checked to be equivalent. The sorting methods are timed in the benchmarks.
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace SPH;
+
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d::Ones());
+size_t number_of_particles = 100000;
+
+class RandomParticleGenerator : public ParticleGenerator<Base>
+{
+    size_t number_of_particles_;
+
+  public:
+    RandomParticleGenerator(SPHBody &sph_body, size_t number_of_particles)
+        : ParticleGenerator<Base>(sph_body), number_of_particles_(number_of_particles){};
+    virtual void initializeGeometricVariables() override
+    {
+        std::mt19937 random_engine(1);
+        std::uniform_real_distribution<Real> uniform(0.0, 1.0);
+        Real volume = 1.0 / (Real)number_of_particles_;
+        for (size_t i = 0; i != number_of_particles_; ++i)
+        {
+            Vecd position(uniform(random_engine), uniform(random_engine), uniform(random_engine));
+            initializePositionAndVolumetricMeasure(position, volume);
+        }
+    }
+};
+
+void sortParticles(RealBody &body)
+{
+    BaseParticles &particles = body.getBaseParticles();
+    StdLargeVec<size_t> &sequence = body.getCellLinkedList().computingSequence(particles);
+    particles.particle_sorting_.sortingParticleData(sequence.data(), particles.total_real_particles_);
+}
+
+TEST(test_ParticleSorting, test_QuickSortAndRadixSort)
+{
+    Real resolution_ref = 1.0 / std::cbrt((Real)number_of_particles);
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+
+    FluidBody quick_sort_body(sph_system, makeShared<DefaultShape>("QuickSortBody"));
+    quick_sort_body.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    auto quick_sort_generator = quick_sort_body.makeSelfDefined<RandomParticleGenerator>(number_of_particles);
+    quick_sort_body.generateParticles(quick_sort_generator);
+
+    FluidBody radix_sort_body(sph_system, makeShared<DefaultShape>("RadixSortBody"));
+    radix_sort_body.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    auto radix_sort_generator = radix_sort_body.makeSelfDefined<RandomParticleGenerator>(number_of_particles);
+    radix_sort_body.generateParticles(radix_sort_generator);
+    radix_sort_body.setParticleSortingMethod(ParticleSortingMethod::RadixSort);
+
+    sortParticles(quick_sort_body);
+    sortParticles(radix_sort_body);
+
+    BaseParticles &quick_sort_particles = quick_sort_body.getBaseParticles();
+    BaseParticles &radix_sort_particles = radix_sort_body.getBaseParticles();
+    size_t mismatches = 0;
+    for (size_t i = 0; i != number_of_particles; ++i)
+    {
+        size_t quick_sort_index = quick_sort_particles.sorted_id_[i];
+        size_t radix_sort_index = radix_sort_particles.sorted_id_[i];
+        if (quick_sort_particles.sequence_[i] != radix_sort_particles.sequence_[i] ||
+            quick_sort_particles.pos_[quick_sort_index] != radix_sort_particles.pos_[radix_sort_index] ||
+            radix_sort_particles.unsorted_id_[radix_sort_index] != i)
+        {
+            mismatches++;
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,165 @@
+/**
+ * @file 	test_3d_verlet_skin.cpp
+ * @brief 	Test of reusing the neighbor configurations within a Verlet skin.
+ * @details The particles of two fluid blocks are moved by small random displacements.
+ *          The neighbors and kernel sums from the relations with and without skin are checked
+ *          to be identical after each update, with or without an actual neighbor search.
+ *          A translation of one block checks that the configurations are reused
+ *          until the displacements exceed the skin and searched again afterwards.
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace SPH;
+
+Real DL = 0.5;
+Real resolution_ref = DL / 20.0;
+BoundingBox system_domain_bounds(Vec3d::Zero(), Vec3d(2.0 * DL, DL, DL));
+
+class FluidBlock : public ComplexShape
+{
+  public:
+    FluidBlock(const std::string &shape_name, const Vecd &translation) : ComplexShape(shape_name)
+    {
+        Vecd halfsize(0.5 * DL, 0.5 * DL, 0.5 * DL);
+        add<TransformShape<GeometricShapeBox>>(Transform(translation + halfsize), halfsize);
+    }
+};
+
+Real kernelSum(Neighborhood &neighborhood)
+{
+    Real sum = 0.0;
+    for (size_t n = 0; n != neighborhood.current_size_; ++n)
+    {
+        sum += neighborhood.W_ij_[n];
+    }
+    return sum;
+}
+
+Vecd kernelGradientSum(Neighborhood &neighborhood)
+{
+    Vecd sum = Vecd::Zero();
+    for (size_t n = 0; n != neighborhood.current_size_; ++n)
+    {
+        sum += neighborhood.dW_ijV_j_[n] * neighborhood.e_ij_[n];
+    }
+    return sum;
+}
+
+TEST(test_VerletSkin, test_ReuseConfiguration)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody left_block(sph_system, makeShared<FluidBlock>("LeftBlock", Vecd::Zero()));
+    left_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    left_block.generateParticles<Lattice>();
+    FluidBody right_block(sph_system, makeShared<FluidBlock>("RightBlock", Vecd(DL, 0.0, 0.0)));
+    right_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    right_block.generateParticles<Lattice>();
+
+    InnerRelation left_inner(left_block);
+    InnerRelation left_inner_with_skin(left_block);
+    ContactRelation left_contact(left_block, {&right_block});
+    ContactRelation left_contact_with_skin(left_block, {&right_block});
+    Real skin_distance = 0.2 * left_block.sph_adaptation_->getKernel()->CutOffRadius();
+    left_inner_with_skin.useVerletSkin(skin_distance);
+    left_contact_with_skin.useVerletSkin(skin_distance);
+
+    std::mt19937 random_engine(1);
+    std::uniform_real_distribution<Real> uniform(-1.0, 1.0);
+    StdVec<RealBody *> blocks = {&left_block, &right_block};
+    size_t total_real_particles = left_block.getBaseParticles().total_real_particles_;
+    for (size_t step = 0; step != 20; ++step)
+    {
+        for (RealBody *block : blocks)
+        {
+            StdLargeVec<Vecd> &pos = block->getBaseParticles().pos_;
+            for (size_t i = 0; i != block->getBaseParticles().total_real_particles_; ++i)
+            {
+                pos[i] += 0.05 * skin_distance * Vecd(uniform(random_engine), uniform(random_engine), uniform(random_engine));
+            }
+            block->updateCellLinkedList();
+        }
+        left_inner.updateConfiguration();
+        left_inner_with_skin.updateConfiguration();
+        left_contact.updateConfiguration();
+        left_contact_with_skin.updateConfiguration();
+
+        for (size_t i = 0; i != total_real_particles; ++i)
+        {
+            Neighborhood &inner_neighborhood = left_inner.inner_configuration_[i];
+            Neighborhood &inner_neighborhood_with_skin = left_inner_with_skin.inner_configuration_[i];
+            EXPECT_EQ(inner_neighborhood_with_skin.current_size_, inner_neighborhood.current_size_);
+            EXPECT_NEAR(kernelSum(inner_neighborhood), kernelSum(inner_neighborhood_with_skin), 1.0e-6);
+            EXPECT_LT((kernelGradientSum(inner_neighborhood) - kernelGradientSum(inner_neighborhood_with_skin)).norm(), 1.0e-6);
+
+            Neighborhood &contact_neighborhood = left_contact.contact_configuration_[0][i];
+            Neighborhood &contact_neighborhood_with_skin = left_contact_with_skin.contact_configuration_[0][i];
+            EXPECT_EQ(contact_neighborhood_with_skin.current_size_, contact_neighborhood.current_size_);
+            EXPECT_NEAR(kernelSum(contact_neighborhood), kernelSum(contact_neighborhood_with_skin), 1.0e-6);
+            EXPECT_LT((kernelGradientSum(contact_neighborhood) - kernelGradientSum(contact_neighborhood_with_skin)).norm(), 1.0e-6);
+        }
+    }
+}
+
+TEST(test_VerletSkin, test_ReuseAndRebuild)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    FluidBody left_block(sph_system, makeShared<FluidBlock>("LeftBlock", Vecd::Zero()));
+    left_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    left_block.generateParticles<Lattice>();
+    FluidBody right_block(sph_system, makeShared<FluidBlock>("RightBlock", Vecd(DL, 0.0, 0.0)));
+    right_block.defineParticlesAndMaterial<BaseParticles, WeaklyCompressibleFluid>(1.0, 10.0);
+    right_block.generateParticles<Lattice>();
+
+    InnerRelation left_inner(left_block);
+    InnerRelation left_inner_with_skin(left_block);
+    ContactRelation left_contact(left_block, {&right_block});
+    ContactRelation left_contact_with_skin(left_block, {&right_block});
+    Real skin_distance = 0.2 * left_block.sph_adaptation_->getKernel()->CutOffRadius();
+    left_inner_with_skin.useVerletSkin(skin_distance);
+    left_contact_with_skin.useVerletSkin(skin_distance);
+
+    // relative to the skin distance, the left block is translated by 0.2, 0.6, 0.8 and 1.2 in total.
+    // The inner configuration is searched again beyond half the skin, i.e. at 0.6 and 1.2 (0.6 after the search),
+    // and the contact configuration, as the right block is at rest, beyond the skin, i.e. at 1.2.
+    StdVec<Real> translations = {0.0, 0.2, 0.4, 0.2, 0.4};
+    StdVec<size_t> expected_inner_searches = {1, 1, 2, 2, 3};
+    StdVec<size_t> expected_contact_searches = {1, 1, 1, 1, 2};
+    size_t total_real_particles = left_block.getBaseParticles().total_real_particles_;
+    StdLargeVec<Vecd> &pos = left_block.getBaseParticles().pos_;
+    for (size_t step = 0; step != translations.size(); ++step)
+    {
+        for (size_t i = 0; i != total_real_particles; ++i)
+        {
+            pos[i][0] += translations[step] * skin_distance;
+        }
+        left_block.updateCellLinkedList();
+        right_block.updateCellLinkedList();
+        left_inner.updateConfiguration();
+        left_inner_with_skin.updateConfiguration();
+        left_contact.updateConfiguration();
+        left_contact_with_skin.updateConfiguration();
+
+        EXPECT_EQ(left_inner_with_skin.getNeighborSkin()->TotalSearches(), expected_inner_searches[step]);
+        EXPECT_EQ(left_contact_with_skin.getNeighborSkin()->TotalSearches(), expected_contact_searches[step]);
+        for (size_t i = 0; i != total_real_particles; ++i)
+        {
+            Neighborhood &inner_neighborhood = left_inner.inner_configuration_[i];
+            Neighborhood &inner_neighborhood_with_skin = left_inner_with_skin.inner_configuration_[i];
+            EXPECT_EQ(inner_neighborhood_with_skin.current_size_, inner_neighborhood.current_size_);
+            EXPECT_NEAR(kernelSum(inner_neighborhood), kernelSum(inner_neighborhood_with_skin), 1.0e-6);
+
+            Neighborhood &contact_neighborhood = left_contact.contact_configuration_[0][i];
+            Neighborhood &contact_neighborhood_with_skin = left_contact_with_skin.contact_configuration_[0][i];
+            EXPECT_EQ(contact_neighborhood_with_skin.current_size_, contact_neighborhood.current_size_);
+            EXPECT_NEAR(kernelSum(contact_neighborhood), kernelSum(contact_neighborhood_with_skin), 1.0e-6);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,108 @@
+/**
+ * @file 	test_multi_rate_time_stepping.cpp
+ * @brief 	Test of advancing integrators at their own rates between coupling points.
+ * @details A stiff and a soft integrator with the time step sizes of powers of two
+ *          are advanced with constant velocities. The sub-steps, the physical times seen by
+ *          the integrators and the calls of the coupling functions are checked.
+ *          A time step size not exactly representable is checked to give the integer number
+ *          of sub-steps, with the time step size evaluated once for each sub-step.
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+TEST(test_MultiRateTimeStepping, test_SubStepping)
+{
+    GlobalStaticVariables::physical_time_ = 0.0;
+    Real stiff_time_step_size = 1.0 / 32.0;
+    Real soft_time_step_size = 1.0 / 8.0;
+    Real stiff_position = 0.0;
+    Real soft_position = 0.0;
+    StdVec<Real> stiff_times;
+    size_t couplings_at_start = 0;
+    size_t couplings_at_end = 0;
+
+    MultiRateTimeStepping time_stepping;
+    size_t stiff = time_stepping.addIntegrator(
+        "Stiff", [&]() -> Real
+        { return stiff_time_step_size; },
+        [&](Real dt)
+        {
+            stiff_times.push_back(GlobalStaticVariables::physical_time_);
+            stiff_position += dt;
+        });
+    size_t soft = time_stepping.addIntegrator(
+        "Soft", [&]() -> Real
+        { return soft_time_step_size; },
+        [&](Real dt)
+        { soft_position += dt; });
+    time_stepping.addCouplingAtStart([&](Real dt)
+                                     {
+                                         EXPECT_EQ(stiff_position, soft_position);
+                                         couplings_at_start++; });
+    time_stepping.addCouplingAtEnd([&](Real dt)
+                                   {
+                                       EXPECT_EQ(stiff_position, soft_position);
+                                       EXPECT_EQ(GlobalStaticVariables::physical_time_, stiff_position);
+                                       couplings_at_end++; });
+
+    EXPECT_EQ(time_stepping.NumberOfIntegrators(), 2);
+    EXPECT_EQ(time_stepping.IntegratorName(stiff), "Stiff");
+    EXPECT_EQ(time_stepping.advanceCouplingInterval(1.0), soft_time_step_size);
+    EXPECT_EQ(time_stepping.SubSteps(stiff), 4);
+    EXPECT_EQ(time_stepping.SubSteps(soft), 1);
+    EXPECT_EQ(time_stepping.PhysicalTime(stiff), soft_time_step_size);
+    EXPECT_EQ(time_stepping.PhysicalTime(soft), soft_time_step_size);
+    ASSERT_EQ(stiff_times.size(), 4);
+    for (size_t n = 0; n != stiff_times.size(); ++n)
+        EXPECT_EQ(stiff_times[n], Real(n) * stiff_time_step_size);
+
+    EXPECT_EQ(time_stepping.advanceCouplingInterval(1.0 / 16.0), 1.0 / 16.0);
+    EXPECT_EQ(time_stepping.SubSteps(stiff), 2);
+    EXPECT_EQ(time_stepping.SubSteps(soft), 1);
+
+    EXPECT_EQ(time_stepping.advanceTo(1.0, 1.0), 7);
+    EXPECT_EQ(GlobalStaticVariables::physical_time_, 1.0);
+    EXPECT_EQ(stiff_position, 1.0);
+    EXPECT_EQ(soft_position, 1.0);
+    EXPECT_EQ(couplings_at_start, 9);
+    EXPECT_EQ(couplings_at_end, 9);
+}
+
+TEST(test_MultiRateTimeStepping, test_SubStepCount)
+{
+    GlobalStaticVariables::physical_time_ = 0.0;
+    Real fluid_time_step_size = 0.1;
+    Real fluid_position = 0.0;
+    size_t fluid_evaluations = 0;
+    size_t fluid_integrations = 0;
+
+    MultiRateTimeStepping time_stepping;
+    size_t fluid = time_stepping.addIntegrator(
+        "Fluid", [&]() -> Real
+        {
+            fluid_evaluations++;
+            return fluid_time_step_size; },
+        [&](Real dt)
+        {
+            fluid_position += dt;
+            fluid_integrations++;
+        });
+    time_stepping.addIntegrator(
+        "Solid", [&]() -> Real
+        { return 1.0; },
+        [&](Real dt) {});
+
+    EXPECT_EQ(time_stepping.advanceCouplingInterval(1.0), 1.0);
+    EXPECT_EQ(time_stepping.SubSteps(fluid), 10);
+    EXPECT_EQ(fluid_integrations, 10);
+    EXPECT_EQ(fluid_evaluations, 10);
+    EXPECT_NEAR(fluid_position, 1.0, 10.0 * Eps);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}